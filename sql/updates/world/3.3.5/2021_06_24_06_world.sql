@@ -0,0 +1,9 @@
+--
+DELETE FROM `command` WHERE `name` IN ('debug opcodecost','debug opcodecost reset');
+INSERT INTO `command` (`name`,`permission`,`help`) VALUES
+('debug opcodecost',300,'Syntax: .debug opcodecost [#count]
+
+Lists the #count (default 10) opcodes with the highest total handler time since the statistics were last reset, with total ms, calls, average, p99 and max handler time in microseconds.'),
+('debug opcodecost reset',300,'Syntax: .debug opcodecost reset
+
+Clears the collected opcode handler statistics.');
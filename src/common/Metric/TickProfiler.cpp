@@ -0,0 +1,162 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TickProfiler.h"
+#include "Config.h"
+#include "Log.h"
+#include "StringFormat.h"
+#include <fstream>
+#include <iomanip>
+#include <ctime>
+
+namespace
+{
+    int64 ToNanoseconds(TimePoint time)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    }
+
+    void WriteEscaped(std::ostream& stream, char const* text)
+    {
+        for (; *text; ++text)
+        {
+            if (*text == '"' || *text == '\\')
+                stream << '\\';
+            stream << *text;
+        }
+    }
+}
+
+Trinity::TickProfiler::ThreadBuffer::ThreadBuffer(uint32 threadId)
+    : ThreadId(threadId), Records(new ZoneRecord[ThreadBufferSize]), Written(0)
+{
+}
+
+Trinity::TickProfiler::TickProfiler() : _enabled(false), _threshold(0), _minDumpInterval(0), _lastDump(), _tickId(0), _tickStart()
+{
+}
+
+Trinity::TickProfiler::~TickProfiler() = default;
+
+Trinity::TickProfiler* Trinity::TickProfiler::instance()
+{
+    static TickProfiler instance;
+    return &instance;
+}
+
+void Trinity::TickProfiler::LoadFromConfigs()
+{
+    _threshold = Milliseconds(std::max(sConfigMgr->GetIntDefault("Profiler.SlowTick.Threshold", 500), 1));
+    _minDumpInterval = Seconds(std::max(sConfigMgr->GetIntDefault("Profiler.SlowTick.MinInterval", 60), 0));
+    _enabled.store(sConfigMgr->GetBoolDefault("Profiler.SlowTick.Enable", false), std::memory_order_relaxed);
+}
+
+void Trinity::TickProfiler::RecordZone(char const* name, TimePoint start, TimePoint end)
+{
+    ThreadBuffer* buffer = GetThreadBuffer();
+    uint64 index = buffer->Written.load(std::memory_order_relaxed);
+    buffer->Records[index % ThreadBufferSize] = { name, ToNanoseconds(start), ToNanoseconds(end) };
+    buffer->Written.store(index + 1, std::memory_order_release);
+}
+
+void Trinity::TickProfiler::BeginTick(uint32 tickId)
+{
+    _tickId = tickId;
+    _tickStart = IsEnabled() ? std::chrono::steady_clock::now() : TimePoint();
+}
+
+void Trinity::TickProfiler::EndTick()
+{
+    // profiling was enabled in the middle of this tick
+    if (!IsEnabled() || _tickStart == TimePoint())
+        return;
+
+    TimePoint tickEnd = std::chrono::steady_clock::now();
+    RecordZone("Tick", _tickStart, tickEnd);
+
+    if (tickEnd - _tickStart < _threshold)
+        return;
+
+    if (_lastDump != TimePoint() && tickEnd - _lastDump < _minDumpInterval)
+        return;
+
+    _lastDump = tickEnd;
+
+    std::string fileName = Trinity::StringFormat("%sslow_tick_%u_%u.json", sLog->GetLogsDir().c_str(), _tickId, uint32(time(nullptr)));
+    std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+        TC_LOG_ERROR("metric", "Tick %u took " SI64FMTD " ms, could not open '%s' to write its profile",
+            _tickId, int64(std::chrono::duration_cast<Milliseconds>(tickEnd - _tickStart).count()), fileName.c_str());
+        return;
+    }
+
+    WriteTrace(file, _tickStart, tickEnd);
+
+    TC_LOG_WARN("metric", "Tick %u took " SI64FMTD " ms, profile written to '%s'",
+        _tickId, int64(std::chrono::duration_cast<Milliseconds>(tickEnd - _tickStart).count()), fileName.c_str());
+}
+
+void Trinity::TickProfiler::WriteTrace(std::ostream& stream, TimePoint tickStart, TimePoint tickEnd) const
+{
+    int64 start = ToNanoseconds(tickStart);
+    int64 end = ToNanoseconds(tickEnd);
+
+    stream << std::fixed << std::setprecision(3);
+    stream << "{\"traceEvents\":[";
+
+    bool first = true;
+    std::lock_guard<std::mutex> lock(_threadBuffersLock);
+    for (std::unique_ptr<ThreadBuffer> const& buffer : _threadBuffers)
+    {
+        // other threads are idle between ticks, zones they record while we read are simply not part of this tick
+        uint64 written = buffer->Written.load(std::memory_order_acquire);
+        for (uint64 i = written > ThreadBufferSize ? written - ThreadBufferSize : 0; i < written; ++i)
+        {
+            ZoneRecord const& record = buffer->Records[i % ThreadBufferSize];
+            if (record.Start < start || record.End > end)
+                continue;
+
+            if (!first)
+                stream << ',';
+            first = false;
+
+            // complete events, the viewer nests them by time
+            stream << "\n{\"name\":\"";
+            WriteEscaped(stream, record.Name);
+            stream << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->ThreadId
+                << ",\"ts\":" << double(record.Start - start) / 1000.0
+                << ",\"dur\":" << double(record.End - record.Start) / 1000.0 << '}';
+        }
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+Trinity::TickProfiler::ThreadBuffer* Trinity::TickProfiler::GetThreadBuffer()
+{
+    // buffers stay owned by the profiler so a trace can still be written after their thread exited
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer)
+    {
+        std::lock_guard<std::mutex> lock(_threadBuffersLock);
+        _threadBuffers.push_back(std::make_unique<ThreadBuffer>(uint32(_threadBuffers.size() + 1)));
+        buffer = _threadBuffers.back().get();
+    }
+
+    return buffer;
+}
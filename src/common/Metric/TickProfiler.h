@@ -0,0 +1,138 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TickProfiler_h__
+#define TickProfiler_h__
+
+#include "Define.h"
+#include "Duration.h"
+#include <atomic>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Trinity
+{
+    /// Low overhead scoped zone profiler for the world update.
+    /// Every thread records the zones it leaves into its own ring buffer. When a tick takes longer than the configured
+    /// threshold, all zones recorded during that tick are written to a file in Chrome trace event format
+    /// (open it in chrome://tracing or https://ui.perfetto.dev), so lag spikes can be analyzed after the fact.
+    /// When disabled, a zone costs a single relaxed atomic load.
+    class TC_COMMON_API TickProfiler
+    {
+    public:
+        struct ZoneRecord
+        {
+            char const* Name;
+            int64 Start;
+            int64 End;
+        };
+
+        struct ThreadBuffer
+        {
+            explicit ThreadBuffer(uint32 threadId);
+
+            uint32 ThreadId;
+            std::unique_ptr<ZoneRecord[]> Records;
+            std::atomic<uint64> Written;
+        };
+
+        static constexpr std::size_t ThreadBufferSize = 65536;
+
+        static TickProfiler* instance();
+
+        void LoadFromConfigs();
+
+        bool IsEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+        /// Zone names must have static storage duration, only the pointer is stored
+        void RecordZone(char const* name, TimePoint start, TimePoint end);
+
+        void BeginTick(uint32 tickId);
+        void EndTick();
+
+        /// Writes the zones of [tickStart, tickEnd] of every thread as Chrome trace events
+        void WriteTrace(std::ostream& stream, TimePoint tickStart, TimePoint tickEnd) const;
+
+    private:
+        TickProfiler();
+        ~TickProfiler();
+
+        ThreadBuffer* GetThreadBuffer();
+
+        std::atomic<bool> _enabled;
+        Milliseconds _threshold;
+        Seconds _minDumpInterval;
+        TimePoint _lastDump;
+        uint32 _tickId;
+        TimePoint _tickStart;
+
+        mutable std::mutex _threadBuffersLock;
+        std::vector<std::unique_ptr<ThreadBuffer>> _threadBuffers;
+    };
+
+    class ProfileZone
+    {
+    public:
+        explicit ProfileZone(char const* name) : _name(TickProfiler::instance()->IsEnabled() ? name : nullptr)
+        {
+            if (_name)
+                _start = std::chrono::steady_clock::now();
+        }
+
+        ~ProfileZone()
+        {
+            if (_name)
+                TickProfiler::instance()->RecordZone(_name, _start, std::chrono::steady_clock::now());
+        }
+
+        ProfileZone(ProfileZone const&) = delete;
+        ProfileZone& operator=(ProfileZone const&) = delete;
+
+    private:
+        char const* _name;
+        TimePoint _start;
+    };
+
+    /// Marks the duration of one world tick, must enclose every profiled zone of the tick
+    class TickProfileScope
+    {
+    public:
+        explicit TickProfileScope(uint32 tickId) { TickProfiler::instance()->BeginTick(tickId); }
+        ~TickProfileScope() { TickProfiler::instance()->EndTick(); }
+
+        TickProfileScope(TickProfileScope const&) = delete;
+        TickProfileScope& operator=(TickProfileScope const&) = delete;
+    };
+}
+
+#define sTickProfiler Trinity::TickProfiler::instance()
+
+#define TC_PROFILE_DO_CONCAT(a, b) a##b
+#define TC_PROFILE_CONCAT(a, b) TC_PROFILE_DO_CONCAT(a, b)
+
+#if defined PERFORMANCE_PROFILING || defined WITHOUT_METRICS
+#define TC_PROFILE_ZONE(name) ((void)0)
+#define TC_PROFILE_TICK(tickId) ((void)0)
+#else
+#define TC_PROFILE_ZONE(name) Trinity::ProfileZone TC_PROFILE_CONCAT(__tc_profile_zone, __LINE__)(name)
+#define TC_PROFILE_TICK(tickId) Trinity::TickProfileScope TC_PROFILE_CONCAT(__tc_profile_tick, __LINE__)(tickId)
+#endif
+
+#endif // TickProfiler_h__
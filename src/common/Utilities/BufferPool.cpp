@@ -0,0 +1,253 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BufferPool.h"
+#include "ThreadBlockCache.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace
+{
+    using Trinity::BufferPool;
+    using Trinity::Impl::FreeBlockList;
+    using Trinity::Impl::PoolBlock;
+
+    // memory a size class may park in the depot before further batches go back to the heap
+    constexpr std::size_t MaxDepotBytesPerSizeClass = 4 * 1024 * 1024;
+    constexpr uint32 StatisticsFlushInterval = 1024;
+
+    inline std::size_t GetSizeClass(std::size_t size)
+    {
+        std::size_t sizeClass = 0;
+        std::size_t blockSize = BufferPool::MinBlockSize;
+        while (blockSize < size && sizeClass < BufferPool::SizeClassCount)
+        {
+            blockSize <<= 1;
+            ++sizeClass;
+        }
+
+        return sizeClass;
+    }
+
+    inline std::size_t GetBlockSize(std::size_t sizeClass)
+    {
+        return BufferPool::MinBlockSize << sizeClass;
+    }
+
+    // number of blocks moved between a thread cache and the depot at once, a thread caches up to twice that
+    inline uint32 GetTransferBatchSize(std::size_t sizeClass)
+    {
+        return uint32(std::clamp<std::size_t>(BufferPool::MaxPooledSize / GetBlockSize(sizeClass), 2, 32));
+    }
+
+    struct BufferPoolDepot
+    {
+        ~BufferPoolDepot()
+        {
+            for (SizeClassDepot& depot : SizeClasses)
+                for (PoolBlock* batch : depot.Batches)
+                    FreeBlockList(batch);
+        }
+
+        struct SizeClassDepot
+        {
+            std::mutex Lock;
+            std::vector<PoolBlock*> Batches;
+        };
+
+        std::array<SizeClassDepot, BufferPool::SizeClassCount> SizeClasses;
+    };
+
+    BufferPoolDepot& GetDepot()
+    {
+        static BufferPoolDepot depot;
+        return depot;
+    }
+
+    struct PublishedStatistics
+    {
+        std::atomic<uint64> Allocations{ 0 };
+        std::atomic<uint64> ThreadCacheHits{ 0 };
+        std::atomic<uint64> DepotHits{ 0 };
+        std::atomic<uint64> HeapAllocations{ 0 };
+        std::atomic<uint64> Deallocations{ 0 };
+        std::atomic<uint64> HeapDeallocations{ 0 };
+    };
+
+    PublishedStatistics GlobalStatistics;
+
+    struct ThreadBufferCache : Trinity::Impl::FreeBlockLists<BufferPool::SizeClassCount>
+    {
+        ~ThreadBufferCache() { FlushStatistics(); }
+
+        void CountOperation()
+        {
+            if (++PendingOperations >= StatisticsFlushInterval)
+                FlushStatistics();
+        }
+
+        void FlushStatistics();
+
+        PoolBlock* TakeFromDepot(std::size_t sizeClass);
+        void ReleaseToDepot(std::size_t sizeClass);
+
+        BufferPool::Statistics Pending;
+        uint32 PendingOperations = 0;
+    };
+
+    typedef Trinity::Impl::ThreadLocalCache<ThreadBufferCache> BufferCache;
+
+    void ThreadBufferCache::FlushStatistics()
+    {
+        GlobalStatistics.Allocations.fetch_add(Pending.Allocations, std::memory_order_relaxed);
+        GlobalStatistics.ThreadCacheHits.fetch_add(Pending.ThreadCacheHits, std::memory_order_relaxed);
+        GlobalStatistics.DepotHits.fetch_add(Pending.DepotHits, std::memory_order_relaxed);
+        GlobalStatistics.HeapAllocations.fetch_add(Pending.HeapAllocations, std::memory_order_relaxed);
+        GlobalStatistics.Deallocations.fetch_add(Pending.Deallocations, std::memory_order_relaxed);
+        GlobalStatistics.HeapDeallocations.fetch_add(Pending.HeapDeallocations, std::memory_order_relaxed);
+        Pending = BufferPool::Statistics();
+        PendingOperations = 0;
+    }
+
+    PoolBlock* ThreadBufferCache::TakeFromDepot(std::size_t sizeClass)
+    {
+        BufferPoolDepot::SizeClassDepot& depot = GetDepot().SizeClasses[sizeClass];
+        std::lock_guard<std::mutex> lock(depot.Lock);
+        if (depot.Batches.empty())
+            return nullptr;
+
+        PoolBlock* batch = depot.Batches.back();
+        depot.Batches.pop_back();
+        return batch;
+    }
+
+    void ThreadBufferCache::ReleaseToDepot(std::size_t sizeClass)
+    {
+        uint32 batchSize = GetTransferBatchSize(sizeClass);
+
+        // detach the first batchSize blocks of the free list
+        PoolBlock* batch = FreeBlocks[sizeClass];
+        PoolBlock* last = batch;
+        for (uint32 i = 1; i < batchSize; ++i)
+            last = last->Next;
+
+        FreeBlocks[sizeClass] = last->Next;
+        FreeBlockCount[sizeClass] -= batchSize;
+        last->Next = nullptr;
+
+        {
+            BufferPoolDepot::SizeClassDepot& depot = GetDepot().SizeClasses[sizeClass];
+            std::lock_guard<std::mutex> lock(depot.Lock);
+            if ((depot.Batches.size() + 1) * batchSize * GetBlockSize(sizeClass) <= MaxDepotBytesPerSizeClass)
+            {
+                depot.Batches.push_back(batch);
+                return;
+            }
+        }
+
+        Pending.HeapDeallocations += batchSize;
+        FreeBlockList(batch);
+    }
+}
+
+void* Trinity::BufferPool::Allocate(std::size_t size)
+{
+    std::size_t sizeClass = GetSizeClass(size);
+    ThreadBufferCache* cache = BufferCache::Get();
+    if (sizeClass >= SizeClassCount || !cache)
+    {
+        if (cache)
+        {
+            ++cache->Pending.Allocations;
+            ++cache->Pending.HeapAllocations;
+            cache->CountOperation();
+        }
+
+        // blocks of a size class always get the full block size, they may be released on a thread that pools them
+        return ::operator new(sizeClass < SizeClassCount ? GetBlockSize(sizeClass) : size);
+    }
+
+    ++cache->Pending.Allocations;
+
+    if (!cache->FreeBlocks[sizeClass])
+    {
+        if (PoolBlock* batch = cache->TakeFromDepot(sizeClass))
+        {
+            cache->FreeBlocks[sizeClass] = batch;
+            cache->FreeBlockCount[sizeClass] = GetTransferBatchSize(sizeClass);
+            ++cache->Pending.DepotHits;
+        }
+    }
+    else
+        ++cache->Pending.ThreadCacheHits;
+
+    cache->CountOperation();
+
+    if (PoolBlock* block = cache->Pop(sizeClass))
+        return block;
+
+    ++cache->Pending.HeapAllocations;
+    // always allocate the full size class so blocks can be reused by any buffer of the same class
+    return ::operator new(GetBlockSize(sizeClass));
+}
+
+void Trinity::BufferPool::Deallocate(void* ptr, std::size_t size)
+{
+    if (!ptr)
+        return;
+
+    std::size_t sizeClass = GetSizeClass(size);
+    ThreadBufferCache* cache = BufferCache::Get();
+    if (sizeClass >= SizeClassCount || !cache)
+    {
+        if (cache)
+        {
+            ++cache->Pending.Deallocations;
+            ++cache->Pending.HeapDeallocations;
+            cache->CountOperation();
+        }
+
+        ::operator delete(ptr);
+        return;
+    }
+
+    ++cache->Pending.Deallocations;
+
+    cache->Push(sizeClass, ptr);
+    if (cache->FreeBlockCount[sizeClass] >= 2 * GetTransferBatchSize(sizeClass))
+        cache->ReleaseToDepot(sizeClass);
+
+    cache->CountOperation();
+}
+
+Trinity::BufferPool::Statistics Trinity::BufferPool::GetStatistics()
+{
+    if (ThreadBufferCache* cache = BufferCache::Get())
+        cache->FlushStatistics();
+
+    Statistics statistics;
+    statistics.Allocations = GlobalStatistics.Allocations.load(std::memory_order_relaxed);
+    statistics.ThreadCacheHits = GlobalStatistics.ThreadCacheHits.load(std::memory_order_relaxed);
+    statistics.DepotHits = GlobalStatistics.DepotHits.load(std::memory_order_relaxed);
+    statistics.HeapAllocations = GlobalStatistics.HeapAllocations.load(std::memory_order_relaxed);
+    statistics.Deallocations = GlobalStatistics.Deallocations.load(std::memory_order_relaxed);
+    statistics.HeapDeallocations = GlobalStatistics.HeapDeallocations.load(std::memory_order_relaxed);
+    return statistics;
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BufferPool_h__
+#define BufferPool_h__
+
+#include "Define.h"
+#include <cstddef>
+#include <vector>
+
+namespace Trinity
+{
+    /// Thread cached allocator for packet and network buffers.
+    /// Requests are rounded up to a power of two size class between MinBlockSize and MaxPooledSize and served from a
+    /// free list owned by the calling thread. Buffers are usually built on one thread and released on another (map thread
+    /// to network thread), so thread caches exchange batches of blocks through a shared depot instead of growing without
+    /// bound on the releasing side and missing on the allocating side. Larger requests are forwarded to the global heap.
+    class TC_COMMON_API BufferPool
+    {
+    public:
+        static constexpr std::size_t MinBlockSize = 64;
+        static constexpr std::size_t SizeClassCount = 11;
+        static constexpr std::size_t MaxPooledSize = MinBlockSize << (SizeClassCount - 1);
+
+        struct Statistics
+        {
+            uint64 Allocations = 0;
+            uint64 ThreadCacheHits = 0;
+            uint64 DepotHits = 0;
+            uint64 HeapAllocations = 0;
+            uint64 Deallocations = 0;
+            uint64 HeapDeallocations = 0;
+        };
+
+        static void* Allocate(std::size_t size);
+        static void Deallocate(void* ptr, std::size_t size);
+
+        /// Counters are collected per thread and published in batches, the calling thread's pending counts are included
+        static Statistics GetStatistics();
+    };
+
+    /// Standard allocator adapter over BufferPool
+    template<typename T>
+    class BufferPoolAllocator
+    {
+    public:
+        typedef T value_type;
+
+        BufferPoolAllocator() noexcept = default;
+
+        template<typename U>
+        BufferPoolAllocator(BufferPoolAllocator<U> const&) noexcept { }
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(BufferPool::Allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, std::size_t n) noexcept
+        {
+            BufferPool::Deallocate(ptr, n * sizeof(T));
+        }
+
+        template<typename U>
+        bool operator==(BufferPoolAllocator<U> const&) const noexcept { return true; }
+
+        template<typename U>
+        bool operator!=(BufferPoolAllocator<U> const&) const noexcept { return false; }
+    };
+
+    typedef std::vector<uint8, BufferPoolAllocator<uint8>> PooledByteVector;
+}
+
+#endif // BufferPool_h__
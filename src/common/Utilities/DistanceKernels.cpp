@@ -0,0 +1,72 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DistanceKernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define TRINITY_DISTANCE_KERNELS_SSE2
+#endif
+
+uint32 Trinity::SelectInRange2d(float const* x, float const* y, float const* reach, uint32 count,
+    float centerX, float centerY, float range, uint32* selected)
+{
+    uint32 found = 0;
+    uint32 i = 0;
+
+#ifdef TRINITY_DISTANCE_KERNELS_SSE2
+    __m128 const cx = _mm_set1_ps(centerX);
+    __m128 const cy = _mm_set1_ps(centerY);
+    __m128 const r = _mm_set1_ps(range);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), cx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), cy);
+        __m128 maxDist = _mm_add_ps(_mm_loadu_ps(reach + i), r);
+        __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        int mask = _mm_movemask_ps(_mm_cmple_ps(distSq, _mm_mul_ps(maxDist, maxDist)));
+
+        // most batches are either entirely in or out of range
+        if (mask == 0xF)
+        {
+            selected[found++] = i;
+            selected[found++] = i + 1;
+            selected[found++] = i + 2;
+            selected[found++] = i + 3;
+        }
+        else
+        {
+            for (; mask; mask &= mask - 1)
+            {
+                uint32 lane = (mask & 1) ? 0 : (mask & 2) ? 1 : (mask & 4) ? 2 : 3;
+                selected[found++] = i + lane;
+            }
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        float dx = x[i] - centerX;
+        float dy = y[i] - centerY;
+        float maxDist = reach[i] + range;
+        if (dx * dx + dy * dy <= maxDist * maxDist)
+            selected[found++] = i;
+    }
+
+    return found;
+}
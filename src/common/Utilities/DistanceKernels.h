@@ -0,0 +1,33 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DistanceKernels_h__
+#define DistanceKernels_h__
+
+#include "Define.h"
+
+namespace Trinity
+{
+    /// Batch broad phase for range searches over positions stored as separate x/y arrays.
+    /// Writes the index of every position i with (x[i] - centerX)^2 + (y[i] - centerY)^2 <= (range + reach[i])^2
+    /// to selected, in ascending order, and returns how many were written. selected must have room for count indices.
+    /// Ignoring z keeps the result a superset of both 2d and 3d distance checks against the same range.
+    TC_COMMON_API uint32 SelectInRange2d(float const* x, float const* y, float const* reach, uint32 count,
+        float centerX, float centerY, float range, uint32* selected);
+}
+
+#endif // DistanceKernels_h__
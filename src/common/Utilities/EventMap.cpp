@@ -17,12 +17,14 @@
 
 #include "EventMap.h"
 #include "Random.h"
+#include <algorithm>
 
 void EventMap::Reset()
 {
     _eventMap.clear();
     _time = TimePoint::min();
     _phase = 0;
+    _sequence = 0;
 }
 
 void EventMap::SetPhase(uint8 phase)
@@ -41,7 +43,7 @@ void EventMap::ScheduleEvent(uint32 eventId, Milliseconds time, uint32 group /*=
     if (phase && phase <= 8)
         eventId |= (1 << (phase + 23));
 
-    _eventMap.insert(EventStore::value_type(_time + time, eventId));
+    Push(_time + time, eventId);
 }
 
 void EventMap::ScheduleEvent(uint32 eventId, Milliseconds minTime, Milliseconds maxTime, uint32 group /*= 0*/, uint32 phase /*= 0*/)
@@ -62,7 +64,7 @@ void EventMap::RescheduleEvent(uint32 eventId, Milliseconds minTime, Millisecond
 
 void EventMap::Repeat(Milliseconds time)
 {
-    _eventMap.insert(EventStore::value_type(_time + time, _lastEvent));
+    Push(_time + time, _lastEvent);
 }
 
 void EventMap::Repeat(Milliseconds minTime, Milliseconds maxTime)
@@ -74,19 +76,19 @@ uint32 EventMap::ExecuteEvent()
 {
     while (!Empty())
     {
-        EventStore::iterator itr = _eventMap.begin();
-
-        if (itr->first > _time)
+        EventEntry const& top = _eventMap.front();
+        if (top.Time > _time)
             return 0;
-        else if (_phase && (itr->second & 0xFF000000) && !((itr->second >> 24) & _phase))
-            _eventMap.erase(itr);
-        else
-        {
-            uint32 eventId = (itr->second & 0x0000FFFF);
-            _lastEvent = itr->second; // include phase/group
-            _eventMap.erase(itr);
-            return eventId;
-        }
+
+        uint32 data = top.Data;
+        std::pop_heap(_eventMap.begin(), _eventMap.end(), EventEntryCompare());
+        _eventMap.pop_back();
+
+        if (_phase && (data & 0xFF000000) && !((data >> 24) & _phase))
+            continue;
+
+        _lastEvent = data; // include phase/group
+        return (data & 0x0000FFFF);
     }
 
     return 0;
@@ -94,16 +96,9 @@ uint32 EventMap::ExecuteEvent()
 
 void EventMap::DelayEvents(Milliseconds delay)
 {
-    if (Empty())
-        return;
-
-    EventStore delayed = std::move(_eventMap);
-    for (EventStore::iterator itr = delayed.begin(); itr != delayed.end();)
-    {
-        EventStore::node_type node = delayed.extract(itr++);
-        node.key() = node.key() + delay;
-        _eventMap.insert(_eventMap.end(), std::move(node));
-    }
+    // shifting every entry by the same amount keeps the heap property intact
+    for (EventEntry& entry : _eventMap)
+        entry.Time += delay;
 }
 
 void EventMap::DelayEvents(Milliseconds delay, uint32 group)
@@ -111,20 +106,28 @@ void EventMap::DelayEvents(Milliseconds delay, uint32 group)
     if (!group || group > 8 || Empty())
         return;
 
-    EventStore delayed;
+    uint32 const groupMask = (1 << (group + 15));
+    EventStore::iterator delayed = std::partition(_eventMap.begin(), _eventMap.end(), [groupMask](EventEntry const& entry)
+    {
+        return !(entry.Data & groupMask);
+    });
+
+    if (delayed == _eventMap.end())
+        return;
+
+    // delayed events are queued behind already scheduled events of the same time, in their previous order
+    std::sort(delayed, _eventMap.end(), [](EventEntry const& left, EventEntry const& right)
+    {
+        return EventEntryCompare()(right, left);
+    });
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    for (EventStore::iterator itr = delayed; itr != _eventMap.end(); ++itr)
     {
-        if (itr->second & (1 << (group + 15)))
-        {
-            delayed.insert(EventStore::value_type(itr->first + delay, itr->second));
-            _eventMap.erase(itr++);
-        }
-        else
-            ++itr;
+        itr->Time += delay;
+        itr->Sequence = _sequence++;
     }
 
-    _eventMap.insert(delayed.begin(), delayed.end());
+    std::make_heap(_eventMap.begin(), _eventMap.end(), EventEntryCompare());
 }
 
 void EventMap::CancelEvent(uint32 eventId)
@@ -132,13 +135,16 @@ void EventMap::CancelEvent(uint32 eventId)
     if (Empty())
         return;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    EventStore::iterator itr = std::remove_if(_eventMap.begin(), _eventMap.end(), [eventId](EventEntry const& entry)
     {
-        if (eventId == (itr->second & 0x0000FFFF))
-            _eventMap.erase(itr++);
-        else
-            ++itr;
-    }
+        return eventId == (entry.Data & 0x0000FFFF);
+    });
+
+    if (itr == _eventMap.end())
+        return;
+
+    _eventMap.erase(itr, _eventMap.end());
+    std::make_heap(_eventMap.begin(), _eventMap.end(), EventEntryCompare());
 }
 
 void EventMap::CancelEventGroup(uint32 group)
@@ -146,20 +152,35 @@ void EventMap::CancelEventGroup(uint32 group)
     if (!group || group > 8 || Empty())
         return;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    uint32 const groupMask = (1 << (group + 15));
+    EventStore::iterator itr = std::remove_if(_eventMap.begin(), _eventMap.end(), [groupMask](EventEntry const& entry)
     {
-        if (itr->second & (1 << (group + 15)))
-            _eventMap.erase(itr++);
-        else
-            ++itr;
-    }
+        return (entry.Data & groupMask) != 0;
+    });
+
+    if (itr == _eventMap.end())
+        return;
+
+    _eventMap.erase(itr, _eventMap.end());
+    std::make_heap(_eventMap.begin(), _eventMap.end(), EventEntryCompare());
 }
 
 Milliseconds EventMap::GetTimeUntilEvent(uint32 eventId) const
 {
-    for (std::pair<TimePoint const, uint32> const& itr : _eventMap)
-        if (eventId == (itr.second & 0x0000FFFF))
-            return std::chrono::duration_cast<Milliseconds>(itr.first - _time);
+    EventEntry const* next = nullptr;
+    for (EventEntry const& entry : _eventMap)
+        if (eventId == (entry.Data & 0x0000FFFF))
+            if (!next || EventEntryCompare()(*next, entry))
+                next = &entry;
+
+    if (!next)
+        return Milliseconds::max();
 
-    return Milliseconds::max();
+    return std::chrono::duration_cast<Milliseconds>(next->Time - _time);
+}
+
+void EventMap::Push(TimePoint time, uint32 data)
+{
+    _eventMap.push_back({ time, _sequence++, data });
+    std::push_heap(_eventMap.begin(), _eventMap.end(), EventEntryCompare());
 }
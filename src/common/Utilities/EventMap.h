@@ -20,14 +20,15 @@
 
 #include "Define.h"
 #include "Duration.h"
-#include <map>
+#include <vector>
 
 class TC_COMMON_API EventMap
 {
     /**
-    * Internal storage type.
-    * Key: Time as TimePoint when the event should occur.
-    * Value: The event data as uint32.
+    * Internal storage entry.
+    * Time: Time as TimePoint when the event should occur.
+    * Sequence: Insertion counter, keeps events scheduled for the same time in FIFO order.
+    * Data: The event data as uint32.
     *
     * Structure of event data:
     * - Bit  0 - 15: Event Id.
@@ -35,10 +36,35 @@ class TC_COMMON_API EventMap
     * - Bit 24 - 31: Phase
     * - Pattern: 0xPPGGEEEE
     */
-    typedef std::multimap<TimePoint, uint32> EventStore;
+    struct EventEntry
+    {
+        TimePoint Time;
+        uint64 Sequence;
+        uint32 Data;
+    };
+
+    /**
+    * Orders entries so that the earliest event is on top of the heap.
+    */
+    struct EventEntryCompare
+    {
+        bool operator()(EventEntry const& left, EventEntry const& right) const
+        {
+            if (left.Time != right.Time)
+                return left.Time > right.Time;
+            return left.Sequence > right.Sequence;
+        }
+    };
+
+    /**
+    * Internal storage type.
+    * Flat binary min-heap of EventEntry, reusing its capacity between
+    * schedules so steady state operation does not allocate.
+    */
+    typedef std::vector<EventEntry> EventStore;
 
 public:
-    EventMap() : _time(TimePoint::min()), _phase(0), _lastEvent(0) { }
+    EventMap() : _time(TimePoint::min()), _phase(0), _lastEvent(0), _sequence(0) { }
 
     /**
     * @name Reset
@@ -262,6 +288,18 @@ private:
     * @brief Stores information on the most recently executed event
     */
     uint32 _lastEvent;
+
+    /**
+    * @name _sequence
+    * @brief Monotonic insertion counter used to order events with equal time.
+    */
+    uint64 _sequence;
+
+    /**
+    * @name Push
+    * @brief Inserts the given event data into the heap.
+    */
+    void Push(TimePoint time, uint32 data);
 };
 
 #endif // _EVENT_MAP_H_
@@ -17,6 +17,7 @@
 
 #include "EventProcessor.h"
 #include "Errors.h"
+#include <algorithm>
 
 void BasicEvent::ScheduleAbort()
 {
@@ -43,12 +44,12 @@ void EventProcessor::Update(uint32 p_time)
     m_time += p_time;
 
     // main event loop
-    std::multimap<uint64, BasicEvent*>::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (!m_events.empty() && m_events.front().Time <= m_time)
     {
         // get and remove event from queue
-        BasicEvent* event = i->second;
-        m_events.erase(i);
+        BasicEvent* event = m_events.front().Event;
+        std::pop_heap(m_events.begin(), m_events.end(), EventEntryCompare());
+        m_events.pop_back();
 
         if (event->IsRunning())
         {
@@ -81,33 +82,36 @@ void EventProcessor::Update(uint32 p_time)
 
 void EventProcessor::KillAllEvents(bool force)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end();)
+    // index based iteration, Abort handlers are allowed to add new events
+    bool removed = false;
+    for (std::size_t i = 0; i < m_events.size(); ++i)
     {
+        BasicEvent* event = m_events[i].Event;
+
         // Abort events which weren't aborted already
-        if (!itr->second->IsAborted())
+        if (!event->IsAborted())
         {
-            itr->second->SetAborted();
-            itr->second->Abort(m_time);
+            event->SetAborted();
+            event->Abort(m_time);
         }
 
         // Skip non-deletable events when we are
         // not forcing the event cancellation.
-        if (!force && !itr->second->IsDeletable())
-        {
-            ++itr;
+        if (!force && !event->IsDeletable())
             continue;
-        }
-
-        delete itr->second;
 
-        if (force)
-            ++itr; // Clear the whole container when forcing
-        else
-            itr = m_events.erase(itr);
+        delete event;
+        m_events[i].Event = nullptr;
+        removed = true;
     }
 
     if (force)
-        m_events.clear();
+        m_events.clear(); // Clear the whole container when forcing
+    else if (removed)
+    {
+        m_events.erase(std::remove_if(m_events.begin(), m_events.end(), [](EventEntry const& entry) { return !entry.Event; }), m_events.end());
+        std::make_heap(m_events.begin(), m_events.end(), EventEntryCompare());
+    }
 }
 
 void EventProcessor::AddEvent(BasicEvent* event, Milliseconds e_time, bool set_addtime)
@@ -115,19 +119,21 @@ void EventProcessor::AddEvent(BasicEvent* event, Milliseconds e_time, bool set_a
     if (set_addtime)
         event->m_addTime = m_time;
     event->m_execTime = e_time.count();
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time.count(), event));
+    m_events.push_back({ uint64(e_time.count()), m_sequence++, event });
+    std::push_heap(m_events.begin(), m_events.end(), EventEntryCompare());
 }
 
 void EventProcessor::ModifyEventTime(BasicEvent* event, Milliseconds newTime)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
+    for (EventEntry& entry : m_events)
     {
-        if (itr->second != event)
+        if (entry.Event != event)
             continue;
 
         event->m_execTime = newTime.count();
-        m_events.erase(itr);
-        m_events.insert(std::pair<uint64, BasicEvent*>(newTime.count(), event));
+        entry.Time = newTime.count();
+        entry.Sequence = m_sequence++;
+        std::make_heap(m_events.begin(), m_events.end(), EventEntryCompare());
         break;
     }
 }
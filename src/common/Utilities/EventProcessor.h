@@ -22,8 +22,9 @@
 #include "Define.h"
 #include "Duration.h"
 #include "Random.h"
-#include <map>
+#include "SmallObjectPool.h"
 #include <type_traits>
+#include <vector>
 
 class EventProcessor;
 
@@ -83,6 +84,10 @@ public:
         return true;
     }
 
+    // lambda events are recycled through a thread cached pool instead of the global heap
+    static void* operator new(std::size_t size) { return Trinity::SmallObjectPool::Allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { Trinity::SmallObjectPool::Deallocate(ptr, size); }
+
 private:
 
     T _callback;
@@ -94,7 +99,7 @@ using is_lambda_event = std::enable_if_t<!std::is_base_of_v<BasicEvent, std::rem
 class TC_COMMON_API EventProcessor
 {
     public:
-        EventProcessor() : m_time(0) { }
+        EventProcessor() : m_time(0), m_sequence(0) { }
         ~EventProcessor();
 
         void Update(uint32 p_time);
@@ -113,8 +118,27 @@ class TC_COMMON_API EventProcessor
         Milliseconds CalculateTime(Milliseconds t_offset) const { return Milliseconds(m_time) + t_offset; }
 
     protected:
+        struct EventEntry
+        {
+            uint64 Time;
+            uint64 Sequence;                                // keeps events with equal time in insertion order
+            BasicEvent* Event;
+        };
+
+        // orders the heap so that the earliest event is on top
+        struct EventEntryCompare
+        {
+            bool operator()(EventEntry const& left, EventEntry const& right) const
+            {
+                if (left.Time != right.Time)
+                    return left.Time > right.Time;
+                return left.Sequence > right.Sequence;
+            }
+        };
+
         uint64 m_time;
-        std::multimap<uint64, BasicEvent*> m_events;
+        uint64 m_sequence;
+        std::vector<EventEntry> m_events;                   // binary min-heap ordered by EventEntryCompare
 };
 
 #endif
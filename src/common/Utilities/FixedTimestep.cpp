@@ -0,0 +1,101 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FixedTimestep.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+Trinity::FixedTimestep::FixedTimestep(std::chrono::nanoseconds step, uint32 maxCatchUpTicks)
+    : _step(std::max(step, std::chrono::nanoseconds(1))), _maxCatchUpTicks(maxCatchUpTicks), _nextTick(), _diffRemainder(0), _lastOverrun(0),
+    _oversleep(0), _overrunCount(0), _droppedTickCount(0)
+{
+}
+
+void Trinity::FixedTimestep::Start(TimePoint now)
+{
+    _nextTick = now;
+    _diffRemainder = std::chrono::nanoseconds(0);
+}
+
+uint32 Trinity::FixedTimestep::NextTickDiff()
+{
+    _diffRemainder += _step;
+    Milliseconds diff = std::chrono::duration_cast<Milliseconds>(_diffRemainder);
+    _diffRemainder -= diff;
+    return uint32(diff.count());
+}
+
+TimePoint Trinity::FixedTimestep::FinishTick(TimePoint now)
+{
+    _nextTick += _step;
+    if (now <= _nextTick)
+    {
+        _lastOverrun = std::chrono::nanoseconds(0);
+        return _nextTick;
+    }
+
+    _lastOverrun = now - _nextTick;
+    ++_overrunCount;
+
+    // too far behind to catch up, drop the missed ticks instead of running them back to back
+    uint64 behind = uint64(_lastOverrun / _step);
+    if (behind > _maxCatchUpTicks)
+    {
+        _droppedTickCount += behind;
+        _nextTick = now;
+    }
+
+    return _nextTick;
+}
+
+void Trinity::FixedTimestep::SleepUntilNextTick()
+{
+    TimePoint wakeTime = _nextTick - _oversleep;
+    if (wakeTime <= std::chrono::steady_clock::now())
+        return;
+
+    std::this_thread::sleep_until(wakeTime);
+
+    // smooth the estimate over several sleeps and never wake earlier than a quarter tick
+    std::chrono::nanoseconds oversleep = std::chrono::steady_clock::now() - wakeTime;
+    _oversleep = std::min((_oversleep * 7 + oversleep) / 8, _step / 4);
+}
+
+void Trinity::TickTimeStatistics::Add(std::chrono::nanoseconds duration)
+{
+    _samples.push_back(duration.count());
+}
+
+std::chrono::nanoseconds Trinity::TickTimeStatistics::GetPercentile(double percentile)
+{
+    if (_samples.empty())
+        return std::chrono::nanoseconds(0);
+
+    std::size_t rank = std::size_t(std::ceil(std::clamp(percentile, 0.0, 1.0) * _samples.size()));
+    std::size_t index = rank ? rank - 1 : 0;
+    std::nth_element(_samples.begin(), _samples.begin() + index, _samples.end());
+    return std::chrono::nanoseconds(_samples[index]);
+}
+
+std::chrono::nanoseconds Trinity::TickTimeStatistics::GetMax() const
+{
+    if (_samples.empty())
+        return std::chrono::nanoseconds(0);
+
+    return std::chrono::nanoseconds(*std::max_element(_samples.begin(), _samples.end()));
+}
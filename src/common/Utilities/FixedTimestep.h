@@ -0,0 +1,85 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FixedTimestep_h__
+#define FixedTimestep_h__
+
+#include "Define.h"
+#include "Duration.h"
+#include <vector>
+
+namespace Trinity
+{
+    /// Schedules ticks of a fixed length on std::chrono::steady_clock.
+    /// Tick start times follow from the schedule instead of from the end of the previous tick, so the tick rate does not drift.
+    /// A tick that ends after the next one was due is an overrun; the following ticks then start without sleeping until
+    /// the schedule is met again, unless the loop fell more than MaxCatchUpTicks behind, in which case the missed ticks
+    /// are dropped and the schedule restarts at the current time.
+    class TC_COMMON_API FixedTimestep
+    {
+    public:
+        FixedTimestep(std::chrono::nanoseconds step, uint32 maxCatchUpTicks);
+
+        /// Schedules the first tick at now
+        void Start(TimePoint now);
+
+        /// Returns the update diff in milliseconds for the tick that is about to run, carrying sub millisecond remainders
+        /// so that step lengths which are not whole milliseconds do not lose time
+        uint32 NextTickDiff();
+
+        /// Must be called with the time the current tick finished at, returns the time the next tick is due
+        TimePoint FinishTick(TimePoint now);
+
+        /// Sleeps until the next tick is due, waking early by the oversleep observed on previous sleeps
+        void SleepUntilNextTick();
+
+        std::chrono::nanoseconds GetStep() const { return _step; }
+        TimePoint GetNextTickTime() const { return _nextTick; }
+        std::chrono::nanoseconds GetLastOverrun() const { return _lastOverrun; }
+        uint64 GetOverrunCount() const { return _overrunCount; }
+        uint64 GetDroppedTickCount() const { return _droppedTickCount; }
+
+    private:
+        std::chrono::nanoseconds _step;
+        uint32 _maxCatchUpTicks;
+        TimePoint _nextTick;
+        std::chrono::nanoseconds _diffRemainder;
+        std::chrono::nanoseconds _lastOverrun;
+        std::chrono::nanoseconds _oversleep;
+        uint64 _overrunCount;
+        uint64 _droppedTickCount;
+    };
+
+    /// Collects tick durations over a reporting window and computes percentiles from them
+    class TC_COMMON_API TickTimeStatistics
+    {
+    public:
+        void Add(std::chrono::nanoseconds duration);
+
+        /// Nearest rank percentile, percentile is in range [0, 1]
+        std::chrono::nanoseconds GetPercentile(double percentile);
+        std::chrono::nanoseconds GetMax() const;
+        std::size_t GetCount() const { return _samples.size(); }
+
+        void Reset() { _samples.clear(); }
+
+    private:
+        std::vector<std::chrono::nanoseconds::rep> _samples;
+    };
+}
+
+#endif // FixedTimestep_h__
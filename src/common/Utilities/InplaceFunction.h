@@ -0,0 +1,135 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef InplaceFunction_h__
+#define InplaceFunction_h__
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Trinity
+{
+    template<typename Signature, std::size_t Capacity>
+    class InplaceFunction;
+
+    /// Copyable callable wrapper like std::function that never allocates: the callable is always stored inside the object.
+    /// Callables larger than Capacity are rejected at compile time, capture less (or capture by reference) in that case.
+    template<typename R, typename... Args, std::size_t Capacity>
+    class InplaceFunction<R(Args...), Capacity>
+    {
+        struct Operations
+        {
+            R(*Invoke)(void* callable, Args&&... args);
+            void(*Copy)(void* destination, void const* source);
+            void(*Move)(void* destination, void* source);
+            void(*Destroy)(void* callable);
+        };
+
+        template<typename Callable>
+        struct OperationsFor
+        {
+            static R Invoke(void* callable, Args&&... args) { return (*static_cast<Callable*>(callable))(std::forward<Args>(args)...); }
+            static void Copy(void* destination, void const* source) { new (destination) Callable(*static_cast<Callable const*>(source)); }
+            static void Move(void* destination, void* source) { new (destination) Callable(std::move(*static_cast<Callable*>(source))); }
+            static void Destroy(void* callable) { static_cast<Callable*>(callable)->~Callable(); }
+
+            static constexpr Operations Table = { &Invoke, &Copy, &Move, &Destroy };
+        };
+
+    public:
+        InplaceFunction() noexcept : _operations(nullptr) { }
+        InplaceFunction(std::nullptr_t) noexcept : _operations(nullptr) { }
+
+        template<typename Callable, typename = std::enable_if_t<!std::is_same<std::decay_t<Callable>, InplaceFunction>::value
+            && std::is_invocable_r<R, std::decay_t<Callable>&, Args...>::value>>
+        InplaceFunction(Callable&& callable)
+        {
+            typedef std::decay_t<Callable> Stored;
+            static_assert(sizeof(Stored) <= Capacity, "Callable does not fit into InplaceFunction, reduce the captured state");
+            static_assert(alignof(Stored) <= alignof(std::max_align_t), "InplaceFunction does not support over-aligned callables");
+
+            new (&_storage) Stored(std::forward<Callable>(callable));
+            _operations = &OperationsFor<Stored>::Table;
+        }
+
+        InplaceFunction(InplaceFunction const& right) : _operations(right._operations)
+        {
+            if (_operations)
+                _operations->Copy(&_storage, &right._storage);
+        }
+
+        InplaceFunction(InplaceFunction&& right) : _operations(right._operations)
+        {
+            if (_operations)
+                _operations->Move(&_storage, &right._storage);
+        }
+
+        ~InplaceFunction()
+        {
+            Reset();
+        }
+
+        InplaceFunction& operator=(InplaceFunction const& right)
+        {
+            if (this != &right)
+            {
+                Reset();
+                if (right._operations)
+                    right._operations->Copy(&_storage, &right._storage);
+                _operations = right._operations;
+            }
+            return *this;
+        }
+
+        InplaceFunction& operator=(InplaceFunction&& right)
+        {
+            if (this != &right)
+            {
+                Reset();
+                if (right._operations)
+                    right._operations->Move(&_storage, &right._storage);
+                _operations = right._operations;
+            }
+            return *this;
+        }
+
+        explicit operator bool() const noexcept { return _operations != nullptr; }
+
+        // like std::function the stored callable is invoked as non const
+        R operator()(Args... args) const
+        {
+            return _operations->Invoke(&_storage, std::forward<Args>(args)...);
+        }
+
+    private:
+        void Reset()
+        {
+            if (_operations)
+            {
+                _operations->Destroy(&_storage);
+                _operations = nullptr;
+            }
+        }
+
+        mutable std::aligned_storage_t<Capacity, alignof(std::max_align_t)> _storage;
+        Operations const* _operations;
+    };
+}
+
+#endif // InplaceFunction_h__
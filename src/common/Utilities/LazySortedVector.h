@@ -0,0 +1,107 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LazySortedVector_h__
+#define LazySortedVector_h__
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Trinity
+{
+    /// Vector kept in descending order (highest element first, as defined by the "less than" Compare) that only re-sorts
+    /// when its order is requested after something changed. Intended for small, frequently updated priority lists
+    /// where keys change far more often than the order is read, so each key change costs O(1) instead of a heap update.
+    /// Re-sorting uses a stable insertion sort, which is linear when only a few elements moved since the last read.
+    /// Callers must call Invalidate() after changing anything Compare looks at.
+    template<typename T, typename Compare>
+    class LazySortedVector
+    {
+    public:
+        typedef std::vector<T> container_type;
+        typedef typename container_type::const_iterator const_iterator;
+
+        explicit LazySortedVector(Compare const& compare = Compare()) : _compare(compare), _sorted(true) { }
+
+        void Insert(T const& value)
+        {
+            _elements.push_back(value);
+            _sorted = false;
+        }
+
+        // removing keeps the current order, sorted or not
+        bool Remove(T const& value)
+        {
+            auto itr = std::find(_elements.begin(), _elements.end(), value);
+            if (itr == _elements.end())
+                return false;
+
+            _elements.erase(itr);
+            return true;
+        }
+
+        void Invalidate() { _sorted = false; }
+
+        void Clear()
+        {
+            _elements.clear();
+            _sorted = true;
+        }
+
+        bool IsSorted() const { return _sorted; }
+        bool Empty() const { return _elements.empty(); }
+        std::size_t Size() const { return _elements.size(); }
+
+        // elements in no particular order, does not trigger a sort
+        container_type const& GetUnsorted() const { return _elements; }
+
+        // elements with the highest one first
+        container_type const& GetSorted() const
+        {
+            Sort();
+            return _elements;
+        }
+
+        T const& Top() const { return GetSorted().front(); }
+
+    private:
+        void Sort() const
+        {
+            if (_sorted)
+                return;
+
+            for (std::size_t i = 1; i < _elements.size(); ++i)
+            {
+                T value = _elements[i];
+                std::size_t j = i;
+                for (; j > 0 && _compare(_elements[j - 1], value); --j)
+                    _elements[j] = _elements[j - 1];
+
+                _elements[j] = value;
+            }
+
+            _sorted = true;
+        }
+
+        Compare _compare;
+        mutable container_type _elements;
+        mutable bool _sorted;
+    };
+}
+
+#endif // LazySortedVector_h__
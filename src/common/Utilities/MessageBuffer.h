@@ -19,12 +19,12 @@
 #define __MESSAGEBUFFER_H_
 
 #include "Define.h"
-#include <vector>
+#include "BufferPool.h"
 #include <cstring>
 
 class MessageBuffer
 {
-    typedef std::vector<uint8>::size_type size_type;
+    typedef Trinity::PooledByteVector::size_type size_type;
 
 public:
     MessageBuffer() : _wpos(0), _rpos(0), _storage()
@@ -99,7 +99,7 @@ public:
         }
     }
 
-    std::vector<uint8>&& Move()
+    Trinity::PooledByteVector&& Move()
     {
         _wpos = 0;
         _rpos = 0;
@@ -133,7 +133,7 @@ public:
 private:
     size_type _wpos;
     size_type _rpos;
-    std::vector<uint8> _storage;
+    Trinity::PooledByteVector _storage;
 };
 
 #endif /* __MESSAGEBUFFER_H_ */
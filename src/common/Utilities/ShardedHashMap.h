@@ -0,0 +1,116 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ShardedHashMap_h__
+#define ShardedHashMap_h__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace Trinity
+{
+    /// Hash map split into independently locked shards, intended for global registries that are read from many threads.
+    /// Lookups and modifications only lock the shard the key hashes to, so concurrent readers of different keys
+    /// do not share a lock and writers only contend with operations on the same shard.
+    /// Lookups return values by copy since nothing returned from a shard may outlive its lock.
+    template<typename Key, typename Value, std::size_t ShardCount = 16, typename Hash = std::hash<Key>>
+    class ShardedHashMap
+    {
+        static_assert(ShardCount && !(ShardCount & (ShardCount - 1)), "ShardCount must be a power of two");
+
+    public:
+        typedef std::unordered_map<Key, Value, Hash> ShardMapType;
+
+        ShardedHashMap() = default;
+        ShardedHashMap(ShardedHashMap const&) = delete;
+        ShardedHashMap& operator=(ShardedHashMap const&) = delete;
+
+        void Insert(Key const& key, Value const& value)
+        {
+            Shard& shard = GetShard(key);
+            std::unique_lock<std::shared_mutex> lock(shard.Lock);
+            shard.Map[key] = value;
+        }
+
+        bool Remove(Key const& key)
+        {
+            Shard& shard = GetShard(key);
+            std::unique_lock<std::shared_mutex> lock(shard.Lock);
+            return shard.Map.erase(key) != 0;
+        }
+
+        /// Returns the value stored for key or a value initialized Value if there is none
+        Value Find(Key const& key) const
+        {
+            Shard const& shard = GetShard(key);
+            std::shared_lock<std::shared_mutex> lock(shard.Lock);
+            auto itr = shard.Map.find(key);
+            return itr != shard.Map.end() ? itr->second : Value();
+        }
+
+        /// Calls worker(key, value) for every element, shards are visited one at a time under their shared lock.
+        /// The worker must not modify this map.
+        template<typename Worker>
+        void DoForAll(Worker&& worker) const
+        {
+            for (Shard const& shard : _shards)
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.Lock);
+                for (auto const& [key, value] : shard.Map)
+                    worker(key, value);
+            }
+        }
+
+        std::size_t Size() const
+        {
+            std::size_t size = 0;
+            for (Shard const& shard : _shards)
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.Lock);
+                size += shard.Map.size();
+            }
+            return size;
+        }
+
+    private:
+        // keep every shard on its own cache line so readers of neighbouring shards do not invalidate each other
+        struct alignas(64) Shard
+        {
+            mutable std::shared_mutex Lock;
+            ShardMapType Map;
+        };
+
+        static std::size_t GetShardIndex(Key const& key)
+        {
+            // std::hash of integral keys is usually the identity, mix it so sequential keys spread over all shards
+            uint64_t hash = uint64_t(Hash()(key)) * UINT64_C(0x9E3779B97F4A7C15);
+            return std::size_t(hash >> 32) & (ShardCount - 1);
+        }
+
+        Shard& GetShard(Key const& key) { return _shards[GetShardIndex(key)]; }
+        Shard const& GetShard(Key const& key) const { return _shards[GetShardIndex(key)]; }
+
+        std::array<Shard, ShardCount> _shards;
+    };
+}
+
+#endif // ShardedHashMap_h__
@@ -0,0 +1,68 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SmallObjectPool.h"
+#include "ThreadBlockCache.h"
+
+namespace
+{
+    using Trinity::Impl::PoolBlock;
+
+    constexpr uint32 MaxCachedBlocksPerSizeClass = 1024;
+
+    struct ThreadPoolCache : Trinity::Impl::FreeBlockLists<Trinity::SmallObjectPool::SizeClassCount> { };
+
+    typedef Trinity::Impl::ThreadLocalCache<ThreadPoolCache> PoolCache;
+
+    inline std::size_t GetSizeClass(std::size_t size)
+    {
+        if (!size)
+            return 0;
+
+        return (size - 1) / Trinity::SmallObjectPool::SizeClassStep;
+    }
+}
+
+void* Trinity::SmallObjectPool::Allocate(std::size_t size)
+{
+    std::size_t sizeClass = GetSizeClass(size);
+    if (sizeClass >= SizeClassCount)
+        return ::operator new(size);
+
+    if (ThreadPoolCache* cache = PoolCache::Get())
+        if (PoolBlock* block = cache->Pop(sizeClass))
+            return block;
+
+    // always allocate the full size class so blocks can be reused by any object of the same class
+    return ::operator new((sizeClass + 1) * SizeClassStep);
+}
+
+void Trinity::SmallObjectPool::Deallocate(void* ptr, std::size_t size)
+{
+    if (!ptr)
+        return;
+
+    std::size_t sizeClass = GetSizeClass(size);
+    ThreadPoolCache* cache = sizeClass < SizeClassCount ? PoolCache::Get() : nullptr;
+    if (!cache || cache->FreeBlockCount[sizeClass] >= MaxCachedBlocksPerSizeClass)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    cache->Push(sizeClass, ptr);
+}
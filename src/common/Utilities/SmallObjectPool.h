@@ -0,0 +1,74 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SmallObjectPool_h__
+#define SmallObjectPool_h__
+
+#include "Define.h"
+#include <cstddef>
+#include <new>
+
+namespace Trinity
+{
+    /// Thread cached, size class based allocator for small objects that are created and destroyed at a high rate.
+    /// Requests are rounded up to a multiple of SizeClassStep bytes and served from a free list owned by the calling thread,
+    /// larger requests are forwarded to the global heap. Blocks may be released from any thread, they simply migrate
+    /// to the free list of the releasing thread.
+    class TC_COMMON_API SmallObjectPool
+    {
+    public:
+        static constexpr std::size_t SizeClassStep = 32;
+        static constexpr std::size_t SizeClassCount = 8;
+        static constexpr std::size_t MaxPooledSize = SizeClassStep * SizeClassCount;
+
+        static void* Allocate(std::size_t size);
+        static void Deallocate(void* ptr, std::size_t size);
+    };
+
+    /// Standard allocator adapter over SmallObjectPool, intended for std::allocate_shared and node based containers
+    template<typename T>
+    class SmallObjectAllocator
+    {
+    public:
+        typedef T value_type;
+
+        static_assert(alignof(T) <= alignof(std::max_align_t), "SmallObjectAllocator does not support over-aligned types");
+
+        SmallObjectAllocator() noexcept = default;
+
+        template<typename U>
+        SmallObjectAllocator(SmallObjectAllocator<U> const&) noexcept { }
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(SmallObjectPool::Allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, std::size_t n) noexcept
+        {
+            SmallObjectPool::Deallocate(ptr, n * sizeof(T));
+        }
+
+        template<typename U>
+        bool operator==(SmallObjectAllocator<U> const&) const noexcept { return true; }
+
+        template<typename U>
+        bool operator!=(SmallObjectAllocator<U> const&) const noexcept { return false; }
+    };
+}
+
+#endif // SmallObjectPool_h__
@@ -113,19 +113,22 @@ void TaskScheduler::Dispatch(success_t const& callback)
 
 void TaskScheduler::TaskQueue::Push(TaskContainer&& task)
 {
-    container.insert(task);
+    task->_sequence = sequence++;
+    container.push_back(std::move(task));
+    std::push_heap(container.begin(), container.end(), Compare());
 }
 
 auto TaskScheduler::TaskQueue::Pop() -> TaskContainer
 {
-    TaskContainer result = *container.begin();
-    container.erase(container.begin());
+    std::pop_heap(container.begin(), container.end(), Compare());
+    TaskContainer result = std::move(container.back());
+    container.pop_back();
     return result;
 }
 
 auto TaskScheduler::TaskQueue::First() const -> TaskContainer const&
 {
-    return *container.begin();
+    return container.front();
 }
 
 void TaskScheduler::TaskQueue::Clear()
@@ -133,43 +136,11 @@ void TaskScheduler::TaskQueue::Clear()
     container.clear();
 }
 
-void TaskScheduler::TaskQueue::RemoveIf(std::function<bool(TaskContainer const&)> const& filter)
-{
-    for (auto itr = container.begin(); itr != container.end();)
-        if (filter(*itr))
-            itr = container.erase(itr);
-        else
-            ++itr;
-}
-
-void TaskScheduler::TaskQueue::ModifyIf(std::function<bool(TaskContainer const&)> const& filter)
-{
-    std::vector<TaskContainer> cache;
-    for (auto itr = container.begin(); itr != container.end();)
-        if (filter(*itr))
-        {
-            cache.push_back(*itr);
-            itr = container.erase(itr);
-        }
-        else
-            ++itr;
-
-    container.insert(cache.begin(), cache.end());
-}
-
 bool TaskScheduler::TaskQueue::IsEmpty() const
 {
     return container.empty();
 }
 
-TaskContext& TaskContext::Dispatch(std::function<TaskScheduler&(TaskScheduler&)> const& apply)
-{
-    if (auto const owner = _owner.lock())
-        apply(*owner);
-
-    return *this;
-}
-
 bool TaskContext::IsExpired() const
 {
     return _owner.expired();
@@ -217,11 +188,16 @@ TaskContext& TaskContext::CancelGroupsOf(std::vector<TaskScheduler::group_t> con
     return Dispatch(std::bind(&TaskScheduler::CancelGroupsOf, std::placeholders::_1, std::cref(groups)));
 }
 
+bool TaskContext::IsConsumed() const
+{
+    return !_task || _task->_invocation != _invocation || _task->_consumed;
+}
+
 void TaskContext::AssertOnConsumed() const
 {
     // This was adapted to TC to prevent static analysis tools from complaining.
     // If you encounter this assertion check if you repeat a TaskContext more then 1 time!
-    ASSERT(!(*_consumed) && "Bad task logic, task context was consumed already!");
+    ASSERT(!IsConsumed() && "Bad task logic, task context was consumed already!");
 }
 
 void TaskContext::Invoke()
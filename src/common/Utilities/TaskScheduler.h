@@ -19,8 +19,10 @@
 #define _TASK_SCHEDULER_H_
 
 #include "Duration.h"
+#include "InplaceFunction.h"
 #include "Optional.h"
 #include "Random.h"
+#include "SmallObjectPool.h"
 #include <algorithm>
 #include <chrono>
 #include <functional>
@@ -28,7 +30,6 @@
 #include <queue>
 #include <memory>
 #include <utility>
-#include <set>
 
 class TaskContext;
 
@@ -58,8 +59,8 @@ class TC_COMMON_API TaskScheduler
     typedef uint32 group_t;
     // Task repeated type
     typedef uint32 repeated_t;
-    // Task handle type
-    typedef std::function<void(TaskContext)> task_handler_t;
+    // Task handle type, stored inside the task so scheduling never allocates for the handler
+    typedef Trinity::InplaceFunction<void(TaskContext), 32> task_handler_t;
     // Predicate type
     typedef std::function<bool()> predicate_t;
     // Success handle type
@@ -75,16 +76,24 @@ class TC_COMMON_API TaskScheduler
         Optional<group_t> _group;
         repeated_t _repeated;
         task_handler_t _task;
+        // Insertion order, keeps tasks with the same end in FIFO order
+        uint64 _sequence;
+        // Incremented every time the task is invoked, identifies the TaskContext of the current invocation
+        uint32 _invocation;
+        // True if the TaskContext of the current invocation was consumed
+        bool _consumed;
 
     public:
         // All Argument construct
         Task(timepoint_t const& end, duration_t const& duration, Optional<group_t> const& group,
-            repeated_t const repeated, task_handler_t const& task)
-                : _end(end), _duration(duration), _group(group), _repeated(repeated), _task(task) { }
+            repeated_t const repeated, task_handler_t&& task)
+                : _end(end), _duration(duration), _group(group), _repeated(repeated), _task(std::move(task)),
+                _sequence(0), _invocation(0), _consumed(true) { }
 
         // Minimal Argument construct
-        Task(timepoint_t const& end, duration_t const& duration, task_handler_t const& task)
-            : _end(end), _duration(duration), _group(std::nullopt), _repeated(0), _task(task) { }
+        Task(timepoint_t const& end, duration_t const& duration, task_handler_t&& task)
+            : _end(end), _duration(duration), _group(std::nullopt), _repeated(0), _task(std::move(task)),
+            _sequence(0), _invocation(0), _consumed(true) { }
 
         // Copy construct
         Task(Task const&) = delete;
@@ -98,12 +107,14 @@ class TC_COMMON_API TaskScheduler
         // Order tasks by its end
         inline bool operator< (Task const& other) const
         {
-            return _end < other._end;
+            if (_end != other._end)
+                return _end < other._end;
+            return _sequence < other._sequence;
         }
 
         inline bool operator> (Task const& other) const
         {
-            return _end > other._end;
+            return other < *this;
         }
 
         // Compare tasks with its end
@@ -121,18 +132,22 @@ class TC_COMMON_API TaskScheduler
 
     typedef std::shared_ptr<Task> TaskContainer;
 
-    /// Container which provides Task order, insert and reschedule operations.
+    /// Orders the TaskQueue heap so that the task which ends first is on top.
     struct Compare
     {
         bool operator() (TaskContainer const& left, TaskContainer const& right) const
         {
-            return (*left.get()) < (*right.get());
+            return (*left.get()) > (*right.get());
         };
     };
 
+    /// Container which provides Task order, insert and reschedule operations.
+    /// Tasks are kept in a binary heap on top of a std::vector which reuses its storage.
     class TC_COMMON_API TaskQueue
     {
-        std::multiset<TaskContainer, Compare> container;
+        std::vector<TaskContainer> container;
+
+        uint64 sequence = 0;
 
     public:
         // Pushes the task in the container
@@ -145,9 +160,29 @@ class TC_COMMON_API TaskScheduler
 
         void Clear();
 
-        void RemoveIf(std::function<bool(TaskContainer const&)> const& filter);
+        template<typename Filter>
+        void RemoveIf(Filter const& filter)
+        {
+            auto const itr = std::remove_if(container.begin(), container.end(), filter);
+            if (itr == container.end())
+                return;
+
+            container.erase(itr, container.end());
+            std::make_heap(container.begin(), container.end(), Compare());
+        }
 
-        void ModifyIf(std::function<bool(TaskContainer const&)> const& filter);
+        template<typename Filter>
+        void ModifyIf(Filter const& filter)
+        {
+            // Visit the tasks in order, modified tasks are queued behind
+            // unmodified tasks with the same end in the order they had before.
+            std::sort_heap(container.begin(), container.end(), Compare());
+            for (auto itr = container.rbegin(); itr != container.rend(); ++itr)
+                if (filter(*itr))
+                    (*itr)->_sequence = sequence++;
+
+            std::make_heap(container.begin(), container.end(), Compare());
+        }
 
         bool IsEmpty() const;
     };
@@ -229,27 +264,27 @@ public:
     /// Never call this from within a task context! Use TaskContext::Schedule instead!
     template<class _Rep, class _Period>
     TaskScheduler& Schedule(std::chrono::duration<_Rep, _Period> const& time,
-        task_handler_t const& task)
+        task_handler_t task)
     {
-        return ScheduleAt(_now, time, task);
+        return ScheduleAt(_now, time, std::move(task));
     }
 
     /// Schedule an event with a fixed rate.
     /// Never call this from within a task context! Use TaskContext::Schedule instead!
     template<class _Rep, class _Period>
     TaskScheduler& Schedule(std::chrono::duration<_Rep, _Period> const& time,
-        group_t const group, task_handler_t const& task)
+        group_t const group, task_handler_t task)
     {
-        return ScheduleAt(_now, time, group, task);
+        return ScheduleAt(_now, time, group, std::move(task));
     }
 
     /// Schedule an event with a randomized rate between min and max rate.
     /// Never call this from within a task context! Use TaskContext::Schedule instead!
     template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight>
     TaskScheduler& Schedule(std::chrono::duration<_RepLeft, _PeriodLeft> const& min,
-        std::chrono::duration<_RepRight, _PeriodRight> const& max, task_handler_t const& task)
+        std::chrono::duration<_RepRight, _PeriodRight> const& max, task_handler_t task)
     {
-        return Schedule(randtime(min, max), task);
+        return Schedule(randtime(min, max), std::move(task));
     }
 
     /// Schedule an event with a fixed rate.
@@ -257,9 +292,9 @@ public:
     template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight>
     TaskScheduler& Schedule(std::chrono::duration<_RepLeft, _PeriodLeft> const& min,
         std::chrono::duration<_RepRight, _PeriodRight> const& max, group_t const group,
-        task_handler_t const& task)
+        task_handler_t task)
     {
-        return Schedule(randtime(min, max), group, task);
+        return Schedule(randtime(min, max), group, std::move(task));
     }
 
     /// Cancels all tasks.
@@ -372,11 +407,13 @@ private:
     /// Insert a new task to the enqueued tasks.
     TaskScheduler& InsertTask(TaskContainer task);
 
+    /// Tasks and their reference count share a single block from the SmallObjectPool.
     template<class _Rep, class _Period>
     TaskScheduler& ScheduleAt(timepoint_t const& end,
-        std::chrono::duration<_Rep, _Period> const& time, task_handler_t const& task)
+        std::chrono::duration<_Rep, _Period> const& time, task_handler_t task)
     {
-        return InsertTask(TaskContainer(new Task(end + time, time, task)));
+        return InsertTask(std::allocate_shared<Task>(Trinity::SmallObjectAllocator<Task>(),
+            end + time, time, std::move(task)));
     }
 
     /// Schedule an event with a fixed rate.
@@ -384,10 +421,11 @@ private:
     template<class _Rep, class _Period>
     TaskScheduler& ScheduleAt(timepoint_t const& end,
         std::chrono::duration<_Rep, _Period> const& time,
-        group_t const group, task_handler_t const& task)
+        group_t const group, task_handler_t task)
     {
         static repeated_t const DEFAULT_REPEATED = 0;
-        return InsertTask(TaskContainer(new Task(end + time, time, group, DEFAULT_REPEATED, task)));
+        return InsertTask(std::allocate_shared<Task>(Trinity::SmallObjectAllocator<Task>(),
+            end + time, time, group, DEFAULT_REPEATED, std::move(task)));
     }
 
     /// Dispatch remaining tasks
@@ -404,35 +442,46 @@ class TC_COMMON_API TaskContext
     /// Owner
     std::weak_ptr<TaskScheduler> _owner;
 
-    /// Marks the task as consumed
-    std::shared_ptr<bool> _consumed;
+    /// The invocation of the task this context belongs to,
+    /// contexts of previous invocations are always consumed.
+    uint32 _invocation;
 
     /// Dispatches an action safe on the TaskScheduler
-    TaskContext& Dispatch(std::function<TaskScheduler&(TaskScheduler&)> const& apply);
+    template<typename Apply>
+    TaskContext& Dispatch(Apply const& apply)
+    {
+        if (auto const owner = _owner.lock())
+            apply(*owner);
+
+        return *this;
+    }
 
 public:
     // Empty constructor
     TaskContext()
-        : _task(), _owner(), _consumed(std::make_shared<bool>(true)) { }
+        : _task(), _owner(), _invocation(0) { }
 
     // Construct from task and owner
     explicit TaskContext(TaskScheduler::TaskContainer&& task, std::weak_ptr<TaskScheduler>&& owner)
-        : _task(task), _owner(owner), _consumed(std::make_shared<bool>(false)) { }
+        : _task(std::move(task)), _owner(std::move(owner)), _invocation(++_task->_invocation)
+    {
+        _task->_consumed = false;
+    }
 
     // Copy construct
     TaskContext(TaskContext const& right)
-        : _task(right._task), _owner(right._owner), _consumed(right._consumed) { }
+        : _task(right._task), _owner(right._owner), _invocation(right._invocation) { }
 
     // Move construct
     TaskContext(TaskContext&& right)
-        : _task(std::move(right._task)), _owner(std::move(right._owner)), _consumed(std::move(right._consumed)) { }
+        : _task(std::move(right._task)), _owner(std::move(right._owner)), _invocation(right._invocation) { }
 
     // Copy assign
     TaskContext& operator= (TaskContext const& right)
     {
         _task = right._task;
         _owner = right._owner;
-        _consumed = right._consumed;
+        _invocation = right._invocation;
         return *this;
     }
 
@@ -441,7 +490,7 @@ public:
     {
         _task = std::move(right._task);
         _owner = std::move(right._owner);
-        _consumed = std::move(right._consumed);
+        _invocation = right._invocation;
         return *this;
     }
 
@@ -473,8 +522,11 @@ public:
         _task->_duration = duration;
         _task->_end += duration;
         _task->_repeated += 1;
-        (*_consumed) = true;
-        return Dispatch(std::bind(&TaskScheduler::InsertTask, std::placeholders::_1, _task));
+        _task->_consumed = true;
+        return Dispatch([this](TaskScheduler& scheduler) -> TaskScheduler&
+        {
+            return scheduler.InsertTask(_task);
+        });
     }
 
     /// Repeats the event with the same duration.
@@ -598,7 +650,7 @@ public:
     template<class _Rep, class _Period>
     TaskContext& RescheduleAll(std::chrono::duration<_Rep, _Period> const& duration)
     {
-        return Dispatch(std::bind(&TaskScheduler::RescheduleAll, std::placeholders::_1, duration));
+        return Dispatch(std::bind(&TaskScheduler::RescheduleAll<_Rep, _Period>, std::placeholders::_1, duration));
     }
 
     /// Reschedule all tasks with a random duration between min and max.
@@ -626,6 +678,9 @@ public:
     }
 
 private:
+    /// Returns true if the task was repeated from this or a copied context already.
+    bool IsConsumed() const;
+
     /// Asserts if the task was consumed already.
     void AssertOnConsumed() const;
 
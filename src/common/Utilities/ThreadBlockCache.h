@@ -0,0 +1,111 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ThreadBlockCache_h__
+#define ThreadBlockCache_h__
+
+#include "Define.h"
+#include <array>
+#include <cstddef>
+#include <new>
+
+// Building blocks shared by the thread cached allocators (SmallObjectPool, BufferPool), only meant to be included by their implementation
+namespace Trinity::Impl
+{
+    struct PoolBlock
+    {
+        PoolBlock* Next;
+    };
+
+    inline void FreeBlockList(PoolBlock* block)
+    {
+        while (block)
+        {
+            PoolBlock* next = block->Next;
+            ::operator delete(block);
+            block = next;
+        }
+    }
+
+    /// One free list per size class, blocks still cached on destruction are returned to the global heap
+    template<std::size_t SizeClassCount>
+    struct FreeBlockLists
+    {
+        FreeBlockLists() = default;
+        FreeBlockLists(FreeBlockLists const&) = delete;
+        FreeBlockLists& operator=(FreeBlockLists const&) = delete;
+
+        ~FreeBlockLists()
+        {
+            for (PoolBlock* block : FreeBlocks)
+                FreeBlockList(block);
+        }
+
+        PoolBlock* Pop(std::size_t sizeClass)
+        {
+            PoolBlock* block = FreeBlocks[sizeClass];
+            if (block)
+            {
+                FreeBlocks[sizeClass] = block->Next;
+                --FreeBlockCount[sizeClass];
+            }
+
+            return block;
+        }
+
+        void Push(std::size_t sizeClass, void* ptr)
+        {
+            PoolBlock* block = static_cast<PoolBlock*>(ptr);
+            block->Next = FreeBlocks[sizeClass];
+            FreeBlocks[sizeClass] = block;
+            ++FreeBlockCount[sizeClass];
+        }
+
+        std::array<PoolBlock*, SizeClassCount> FreeBlocks = { };
+        std::array<uint32, SizeClassCount> FreeBlockCount = { };
+    };
+
+    /// Per thread instance of Cache. Other thread_local objects may still allocate or release memory after the calling thread's
+    /// instance was destroyed during thread or process shutdown, Get returns nullptr from then on and callers use the global heap.
+    /// Blocks handed out in that state must still have the full size of their size class, they can be released on a live thread.
+    template<typename Cache>
+    class ThreadLocalCache
+    {
+    public:
+        static Cache* Get() { return Destroyed ? nullptr : &Instance.Value; }
+
+    private:
+        struct Holder
+        {
+            ~Holder() { Destroyed = true; }
+
+            Cache Value;
+        };
+
+        static thread_local Holder Instance;
+        // trivially destructible, stays readable after Instance was destroyed
+        static thread_local bool Destroyed;
+    };
+
+    template<typename Cache>
+    thread_local typename ThreadLocalCache<Cache>::Holder ThreadLocalCache<Cache>::Instance;
+
+    template<typename Cache>
+    thread_local bool ThreadLocalCache<Cache>::Destroyed = false;
+}
+
+#endif // ThreadBlockCache_h__
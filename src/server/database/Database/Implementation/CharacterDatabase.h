@@ -199,7 +199,7 @@ enum CharacterDatabaseStatements : uint32
     CHAR_INS_EQUIP_SET,
     CHAR_DEL_EQUIP_SET,
 
-    CHAR_INS_AURA,
+    CHAR_REP_AURA,
 
     CHAR_SEL_ACCOUNT_DATA,
     CHAR_REP_ACCOUNT_DATA,
@@ -413,6 +413,7 @@ enum CharacterDatabaseStatements : uint32
     CHAR_DEL_CHARACTER,
     CHAR_DEL_CHAR_ACTION,
     CHAR_DEL_CHAR_AURA,
+    CHAR_DEL_CHAR_AURA_BY_KEY,
     CHAR_DEL_CHAR_GIFT,
     CHAR_DEL_CHAR_INSTANCE,
     CHAR_DEL_CHAR_INVENTORY,
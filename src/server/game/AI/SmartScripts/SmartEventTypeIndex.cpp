@@ -0,0 +1,54 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SmartEventTypeIndex.h"
+#include <algorithm>
+
+void SmartEventTypeIndex::Build(SmartAIEventList const& events)
+{
+    _entries.clear();
+    _eventTypes.reset();
+    _entries.reserve(events.size());
+    for (uint32 i = 0; i < uint32(events.size()); ++i)
+    {
+        uint32 eventType = events[i].GetEventType();
+        if (eventType == SMART_EVENT_LINK || eventType >= SMART_EVENT_END)
+            continue;
+
+        _entries.push_back({ eventType, i });
+        _eventTypes.set(eventType);
+    }
+
+    // stable, keeps list order within each event type
+    std::stable_sort(_entries.begin(), _entries.end(), [](Entry const& left, Entry const& right)
+    {
+        return left.EventType < right.EventType;
+    });
+
+    _dirty = false;
+}
+
+SmartEventTypeIndex::ListenerRange SmartEventTypeIndex::GetListeners(uint32 eventType) const
+{
+    if (!HasListeners(eventType))
+        return ListenerRange(_entries.end(), _entries.end());
+
+    return std::equal_range(_entries.begin(), _entries.end(), Entry{ eventType, 0 }, [](Entry const& left, Entry const& right)
+    {
+        return left.EventType < right.EventType;
+    });
+}
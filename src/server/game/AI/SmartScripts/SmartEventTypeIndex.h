@@ -0,0 +1,56 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SmartEventTypeIndex_h__
+#define SmartEventTypeIndex_h__
+
+#include "Define.h"
+#include "IteratorPair.h"
+#include "SmartScriptMgr.h"
+#include <bitset>
+#include <vector>
+
+/// Positions in a SmartScript event list grouped by event type, keeping list (priority) order within each type,
+/// so a fired event only visits its own listeners and events nobody listens to return right away.
+/// Must be rebuilt whenever the event list is resized or reordered, links are only processed through their source event and never indexed.
+class TC_GAME_API SmartEventTypeIndex
+{
+public:
+    struct Entry
+    {
+        uint32 EventType;
+        uint32 Position;
+    };
+
+    typedef Trinity::IteratorPair<std::vector<Entry>::const_iterator> ListenerRange;
+
+    SmartEventTypeIndex() : _dirty(false) { }
+
+    void Build(SmartAIEventList const& events);
+    void MarkDirty() { _dirty = true; }
+    bool IsDirty() const { return _dirty; }
+
+    bool HasListeners(uint32 eventType) const { return eventType < SMART_EVENT_END && _eventTypes.test(eventType); }
+    ListenerRange GetListeners(uint32 eventType) const;
+
+private:
+    std::vector<Entry> _entries;
+    std::bitset<SMART_EVENT_END> _eventTypes;
+    bool _dirty;
+};
+
+#endif // SmartEventTypeIndex_h__
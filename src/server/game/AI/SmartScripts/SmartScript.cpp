@@ -59,6 +59,11 @@ SmartScript::SmartScript()
     isProcessingTimedActionList = false;
     mCurrentPriority = 0;
     mEventSortingRequired = false;
+    mEventTimerBudget = 0;
+    mDeferredEventTimerDiff = 0;
+    mEventTimersEngaged = false;
+    mEventTimersNeedUnitStateCheck = false;
+    mEventTimerScheduleDirty = true;
     mNestedEventsCounter = 0;
     mAllEventFlags = 0;
 }
@@ -170,6 +175,8 @@ Creature* SmartScript::FindCreatureNear(WorldObject* searchObject, ObjectGuid::L
 
 void SmartScript::OnReset()
 {
+    FlushDeferredEventTimers();
+    mEventTimerScheduleDirty = true;
     ResetBaseObject();
     for (SmartScriptHolder& event : mEvents)
     {
@@ -221,6 +228,7 @@ void SmartScript::ResetBaseObject()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, SpellInfo const* spell, GameObject* gob)
 {
+    FlushDeferredEventTimers();
     mNestedEventsCounter++;
 
     // Allow only a fixed number of nested ProcessEventsFor calls
@@ -230,21 +238,38 @@ void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint3
     }
     else
     {
-        for (SmartScriptHolder& event : mEvents)
+        // never rebuild the index while an outer call may still be iterating it
+        if (mEventTypeIndex.IsDirty() && mNestedEventsCounter == 1)
+            mEventTypeIndex.Build(mEvents);
+
+        if (!mEventTypeIndex.IsDirty())
         {
-            SMART_EVENT eventType = SMART_EVENT(event.GetEventType());
-            if (eventType == SMART_EVENT_LINK)//special handling
-                continue;
+            for (SmartEventTypeIndex::Entry const& listener : mEventTypeIndex.GetListeners(e))
+                ProcessEventIfMeetingConditions(mEvents[listener.Position], unit, var0, var1, bvar, spell, gob);
+        }
+        else
+        {
+            for (SmartScriptHolder& event : mEvents)
+            {
+                SMART_EVENT eventType = SMART_EVENT(event.GetEventType());
+                if (eventType == SMART_EVENT_LINK)//special handling
+                    continue;
 
-            if (eventType == e)
-                if (sConditionMgr->IsObjectMeetingSmartEventConditions(event.entryOrGuid, event.event_id, event.source_type, unit, GetBaseObject()))
-                    ProcessEvent(event, unit, var0, var1, bvar, spell, gob);
+                if (eventType == e)
+                    ProcessEventIfMeetingConditions(event, unit, var0, var1, bvar, spell, gob);
+            }
         }
     }
 
     --mNestedEventsCounter;
 }
 
+void SmartScript::ProcessEventIfMeetingConditions(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, SpellInfo const* spell, GameObject* gob)
+{
+    if (sConditionMgr->IsObjectMeetingSmartEventConditions(e.entryOrGuid, e.event_id, e.source_type, unit, GetBaseObject()))
+        ProcessEvent(e, unit, var0, var1, bvar, spell, gob);
+}
+
 void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, SpellInfo const* spell, GameObject* gob)
 {
     e.runOnce = true; //used for repeat check
@@ -2922,6 +2947,10 @@ void SmartScript::GetWorldObjectsInDist(ObjectVector& targets, float dist) const
 
 void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, SpellInfo const* spell, GameObject* gob)
 {
+    // actions may change timers, phase or the base object, all of which the timer schedule depends on
+    FlushDeferredEventTimers();
+    mEventTimerScheduleDirty = true;
+
     if (!e.active && e.GetEventType() != SMART_EVENT_LINK)
         return;
 
@@ -3540,22 +3569,61 @@ void SmartScript::RecalcTimer(SmartScriptHolder& e, uint32 min, uint32 max)
     e.active = e.timer ? false : true;
 }
 
-void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
+bool SmartScript::IsTimedEvent(uint32 eventType)
+{
+    switch (eventType)
+    {
+        case SMART_EVENT_UPDATE:
+        case SMART_EVENT_UPDATE_OOC:
+        case SMART_EVENT_UPDATE_IC:
+        case SMART_EVENT_HEALTH_PCT:
+        case SMART_EVENT_TARGET_HEALTH_PCT:
+        case SMART_EVENT_MANA_PCT:
+        case SMART_EVENT_TARGET_MANA_PCT:
+        case SMART_EVENT_RANGE:
+        case SMART_EVENT_VICTIM_CASTING:
+        case SMART_EVENT_FRIENDLY_HEALTH:
+        case SMART_EVENT_FRIENDLY_IS_CC:
+        case SMART_EVENT_FRIENDLY_MISSING_BUFF:
+        case SMART_EVENT_HAS_AURA:
+        case SMART_EVENT_TARGET_BUFFED:
+        case SMART_EVENT_IS_BEHIND_TARGET:
+        case SMART_EVENT_FRIENDLY_HEALTH_PCT:
+        case SMART_EVENT_DISTANCE_CREATURE:
+        case SMART_EVENT_DISTANCE_GAMEOBJECT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool SmartScript::IsEventTimerRunning(SmartScriptHolder const& e, bool engaged) const
 {
     if (e.GetEventType() == SMART_EVENT_LINK)
-        return;
+        return false;
 
     if (e.event.event_phase_mask && !IsInPhase(e.event.event_phase_mask))
-        return;
+        return false;
 
-    if (e.GetEventType() == SMART_EVENT_UPDATE_IC && (!me || !me->IsEngaged()))
-        return;
+    if (e.GetEventType() == SMART_EVENT_UPDATE_IC && !engaged)
+        return false;
+
+    if (e.GetEventType() == SMART_EVENT_UPDATE_OOC && engaged) //can be used with me=nullptr (go script)
+        return false;
 
-    if (e.GetEventType() == SMART_EVENT_UPDATE_OOC && (me && me->IsEngaged())) //can be used with me=nullptr (go script)
+    return true;
+}
+
+void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
+{
+    if (!IsEventTimerRunning(e, me && me->IsEngaged()))
         return;
 
     if (e.timer < diff)
     {
+        if (SmartAITimerStats* stats = GetTimerStats())
+            ++stats->Fired;
+
         // delay spell cast event if another spell is being cast
         if (e.GetActionType() == SMART_ACTION_CAST)
         {
@@ -3581,48 +3649,27 @@ void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
 
         e.active = true;//activate events with cooldown
 
-        switch (e.GetEventType())//process ONLY timed events
-        {
-            case SMART_EVENT_UPDATE:
-            case SMART_EVENT_UPDATE_OOC:
-            case SMART_EVENT_UPDATE_IC:
-            case SMART_EVENT_HEALTH_PCT:
-            case SMART_EVENT_TARGET_HEALTH_PCT:
-            case SMART_EVENT_MANA_PCT:
-            case SMART_EVENT_TARGET_MANA_PCT:
-            case SMART_EVENT_RANGE:
-            case SMART_EVENT_VICTIM_CASTING:
-            case SMART_EVENT_FRIENDLY_HEALTH:
-            case SMART_EVENT_FRIENDLY_IS_CC:
-            case SMART_EVENT_FRIENDLY_MISSING_BUFF:
-            case SMART_EVENT_HAS_AURA:
-            case SMART_EVENT_TARGET_BUFFED:
-            case SMART_EVENT_IS_BEHIND_TARGET:
-            case SMART_EVENT_FRIENDLY_HEALTH_PCT:
-            case SMART_EVENT_DISTANCE_CREATURE:
-            case SMART_EVENT_DISTANCE_GAMEOBJECT:
-            {
-                if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
-                {
-                    Unit* invoker = nullptr;
-                    if (me && mTimedActionListInvoker)
-                        invoker = ObjectAccessor::GetUnit(*me, mTimedActionListInvoker);
-                    ProcessEvent(e, invoker);
-                    e.enableTimed = false;//disable event if it is in an ActionList and was processed once
-                    for (SmartScriptHolder& scriptholder : mTimedActionList)
+        if (IsTimedEvent(e.GetEventType()))//process ONLY timed events
+        {
+            if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
+            {
+                Unit* invoker = nullptr;
+                if (me && mTimedActionListInvoker)
+                    invoker = ObjectAccessor::GetUnit(*me, mTimedActionListInvoker);
+                ProcessEvent(e, invoker);
+                e.enableTimed = false;//disable event if it is in an ActionList and was processed once
+                for (SmartScriptHolder& scriptholder : mTimedActionList)
+                {
+                    //find the first event which is not the current one and enable it
+                    if (scriptholder.event_id > e.event_id)
                     {
-                        //find the first event which is not the current one and enable it
-                        if (scriptholder.event_id > e.event_id)
-                        {
-                            scriptholder.enableTimed = true;
-                            break;
-                        }
+                        scriptholder.enableTimed = true;
+                        break;
                     }
                 }
-                else
-                    ProcessEvent(e);
-                break;
             }
+            else
+                ProcessEvent(e);
         }
 
         if (e.priority != SmartScriptHolder::DEFAULT_PRIORITY)
@@ -3646,6 +3693,74 @@ bool SmartScript::CheckTimer(SmartScriptHolder const& e) const
     return e.active;
 }
 
+bool SmartScript::CanDeferEventTimers(uint32 diff) const
+{
+    if (mEventTimerScheduleDirty || !mInstallEvents.empty() || mEventSortingRequired)
+        return false;
+
+    if (mEventTimersEngaged != (me && me->IsEngaged()))
+        return false;
+
+    if (mEventTimersNeedUnitStateCheck && me && me->HasUnitState(UNIT_STATE_CASTING | UNIT_STATE_ROOT | UNIT_STATE_LOST_CONTROL))
+        return false;
+
+    // a timer expires in UpdateTimer once it drops below the tick diff
+    return uint64(mDeferredEventTimerDiff) + diff <= mEventTimerBudget;
+}
+
+void SmartScript::FlushDeferredEventTimers()
+{
+    if (!mDeferredEventTimerDiff)
+        return;
+
+    // CanDeferEventTimers guarantees none of these reached zero, so this is what UpdateTimer would have done tick by tick
+    for (uint32 position : mRunningEventTimers)
+        mEvents[position].timer -= mDeferredEventTimerDiff;
+
+    mDeferredEventTimerDiff = 0;
+}
+
+void SmartScript::ScheduleEventTimers()
+{
+    mRunningEventTimers.clear();
+    mEventTimerBudget = std::numeric_limits<uint32>::max();
+    mEventTimersEngaged = me && me->IsEngaged();
+    mEventTimersNeedUnitStateCheck = false;
+
+    for (uint32 i = 0; i < uint32(mEvents.size()); ++i)
+    {
+        SmartScriptHolder const& e = mEvents[i];
+        if (!IsEventTimerRunning(e, mEventTimersEngaged))
+            continue;
+
+        // An already active event without a timed handler and with default priority gains nothing when its timer expires,
+        // the timer is overwritten before anything reads it again. Cast and flee actions are the exception, they raise the
+        // event priority while the unit is casting or rooted.
+        if (e.active && e.priority == SmartScriptHolder::DEFAULT_PRIORITY && !IsTimedEvent(e.GetEventType()))
+        {
+            if (e.GetActionType() != SMART_ACTION_CAST && e.GetActionType() != SMART_ACTION_FLEE_FOR_ASSIST)
+                continue;
+
+            mEventTimersNeedUnitStateCheck = true;
+            if (!e.timer)
+                continue;
+        }
+
+        mRunningEventTimers.push_back(i);
+        mEventTimerBudget = std::min(mEventTimerBudget, e.timer);
+    }
+
+    mEventTimerScheduleDirty = false;
+}
+
+SmartAITimerStats* SmartScript::GetTimerStats() const
+{
+    if (WorldObject* obj = GetBaseObject())
+        return &obj->GetMap()->GetSmartAITimerStats();
+
+    return nullptr;
+}
+
 void SmartScript::InstallEvents()
 {
     if (!mInstallEvents.empty())
@@ -3654,6 +3769,7 @@ void SmartScript::InstallEvents()
             mEvents.push_back(installevent);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        mEventTypeIndex.MarkDirty();
     }
 }
 
@@ -3744,16 +3860,34 @@ void SmartScript::OnUpdate(uint32 const diff)
         return;
     }
 
-    InstallEvents();//before UpdateTimers
-
-    if (mEventSortingRequired)
+    SmartAITimerStats* timerStats = GetTimerStats();
+    if (CanDeferEventTimers(diff))
     {
-        SortEvents(mEvents);
-        mEventSortingRequired = false;
+        mDeferredEventTimerDiff += diff;
+        if (timerStats)
+            ++timerStats->Deferred;
     }
+    else
+    {
+        FlushDeferredEventTimers();
+
+        InstallEvents();//before UpdateTimers
 
-    for (SmartScriptHolder& mEvent : mEvents)
-        UpdateTimer(mEvent, diff);
+        if (mEventSortingRequired)
+        {
+            SortEvents(mEvents);
+            mEventSortingRequired = false;
+            mEventTypeIndex.MarkDirty();
+        }
+
+        if (timerStats)
+            timerStats->Scheduled += mEvents.size();
+
+        for (SmartScriptHolder& mEvent : mEvents)
+            UpdateTimer(mEvent, diff);
+
+        ScheduleEventTimers();
+    }
 
     if (!mStoredEvents.empty())
     {
@@ -3833,7 +3967,7 @@ void SmartScript::RetryLater(SmartScriptHolder& e, bool ignoreChanceRoll)
     e.runOnce = false;
 }
 
-void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEntry const* at)
+void SmartScript::FillScript(SmartAIEventList const& e, WorldObject* obj, AreaTriggerEntry const* at)
 {
     if (e.empty())
     {
@@ -3843,7 +3977,9 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
             TC_LOG_DEBUG("scripts.ai", "SmartScript: EventMap for AreaTrigger %u is empty but is using SmartScript.", at->ID);
         return;
     }
-    for (SmartScriptHolder& scriptholder : e)
+
+    mEvents.reserve(mEvents.size() + e.size());
+    for (SmartScriptHolder const& scriptholder : e)
     {
         #ifndef TRINITY_DEBUG
             if (scriptholder.event.event_flags & SMART_EVENT_FLAG_DEBUG_ONLY)
@@ -3861,30 +3997,28 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
         mAllEventFlags |= scriptholder.event.event_flags;
         mEvents.push_back(scriptholder);//NOTE: 'world(0)' events still get processed in ANY instance mode
     }
+
+    mEventTypeIndex.MarkDirty();
 }
 
 void SmartScript::GetScript()
 {
-    SmartAIEventList e;
     if (me)
     {
-        e = sSmartScriptMgr->GetScript(-((int32)me->GetSpawnId()), mScriptType);
-        if (e.empty())
-            e = sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType);
-        FillScript(e, me, nullptr);
+        SmartAIEventList const* e = &sSmartScriptMgr->GetScript(-((int32)me->GetSpawnId()), mScriptType);
+        if (e->empty())
+            e = &sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType);
+        FillScript(*e, me, nullptr);
     }
     else if (go)
     {
-        e = sSmartScriptMgr->GetScript(-((int32)go->GetSpawnId()), mScriptType);
-        if (e.empty())
-            e = sSmartScriptMgr->GetScript((int32)go->GetEntry(), mScriptType);
-        FillScript(e, go, nullptr);
+        SmartAIEventList const* e = &sSmartScriptMgr->GetScript(-((int32)go->GetSpawnId()), mScriptType);
+        if (e->empty())
+            e = &sSmartScriptMgr->GetScript((int32)go->GetEntry(), mScriptType);
+        FillScript(*e, go, nullptr);
     }
     else if (trigger)
-    {
-        e = sSmartScriptMgr->GetScript((int32)trigger->ID, mScriptType);
-        FillScript(e, nullptr, trigger);
-    }
+        FillScript(sSmartScriptMgr->GetScript((int32)trigger->ID, mScriptType), nullptr, trigger);
 }
 
 void SmartScript::OnInitialize(WorldObject* obj, AreaTriggerEntry const* at)
@@ -3925,6 +4059,9 @@ void SmartScript::OnInitialize(WorldObject* obj, AreaTriggerEntry const* at)
         return;
     }
 
+    FlushDeferredEventTimers();
+    mEventTimerScheduleDirty = true;
+
     GetScript();//load copy of script
 
     for (SmartScriptHolder& event : mEvents)
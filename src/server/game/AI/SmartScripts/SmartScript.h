@@ -19,6 +19,7 @@
 #define TRINITY_SMARTSCRIPT_H
 
 #include "Define.h"
+#include "SmartEventTypeIndex.h"
 #include "SmartScriptMgr.h"
 
 class Creature;
@@ -28,6 +29,7 @@ class SpellInfo;
 class Unit;
 class WorldObject;
 struct AreaTriggerEntry;
+struct SmartAITimerStats;
 
 class TC_GAME_API SmartScript
 {
@@ -37,7 +39,7 @@ class TC_GAME_API SmartScript
 
         void OnInitialize(WorldObject* obj, AreaTriggerEntry const* at = nullptr);
         void GetScript();
-        void FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEntry const* at);
+        void FillScript(SmartAIEventList const& e, WorldObject* obj, AreaTriggerEntry const* at);
 
         void ProcessEventsFor(SMART_EVENT e, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, SpellInfo const* spell = nullptr, GameObject* gob = nullptr);
         void ProcessEvent(SmartScriptHolder& e, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, SpellInfo const* spell = nullptr, GameObject* gob = nullptr);
@@ -45,6 +47,7 @@ class TC_GAME_API SmartScript
         static void RecalcTimer(SmartScriptHolder& e, uint32 min, uint32 max);
         void UpdateTimer(SmartScriptHolder& e, uint32 const diff);
         static void InitTimer(SmartScriptHolder& e);
+        static bool IsTimedEvent(uint32 eventType);
         void ProcessAction(SmartScriptHolder& e, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, SpellInfo const* spell = nullptr, GameObject* gob = nullptr);
         void ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, SpellInfo const* spell = nullptr, GameObject* gob = nullptr);
         void GetTargets(ObjectVector& targets, SmartScriptHolder const& e, WorldObject* invoker = nullptr) const;
@@ -106,7 +109,24 @@ class TC_GAME_API SmartScript
         void RaisePriority(SmartScriptHolder& e);
         void RetryLater(SmartScriptHolder& e, bool ignoreChanceRoll = false);
 
+        bool IsEventTimerRunning(SmartScriptHolder const& e, bool engaged) const;
+        bool CanDeferEventTimers(uint32 diff) const;
+        void FlushDeferredEventTimers();
+        void ScheduleEventTimers();
+        SmartAITimerStats* GetTimerStats() const;
+        void ProcessEventIfMeetingConditions(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, SpellInfo const* spell, GameObject* gob);
+
         SmartAIEventList mEvents;
+        SmartEventTypeIndex mEventTypeIndex;
+
+        // OnUpdate skips the mEvents timer scan until one of them can expire. The skipped diff is
+        // applied to the running timers on the next scan or before any event is processed.
+        std::vector<uint32> mRunningEventTimers;        // positions in mEvents counting down
+        uint32 mEventTimerBudget;                       // diff that can pass before any timer expires
+        uint32 mDeferredEventTimerDiff;
+        bool mEventTimersEngaged;                       // combat state the schedule was computed for
+        bool mEventTimersNeedUnitStateCheck;            // expired cast/flee events react to casting/root state
+        bool mEventTimerScheduleDirty;
         SmartAIEventList mInstallEvents;
         SmartAIEventList mTimedActionList;
         ObjectGuid mTimedActionListInvoker;
@@ -393,16 +393,17 @@ void SmartAIMgr::LoadSmartAIFromDB()
     UnLoadHelperStores();
 }
 
-SmartAIEventList SmartAIMgr::GetScript(int32 entry, SmartScriptType type)
+SmartAIEventList const& SmartAIMgr::GetScript(int32 entry, SmartScriptType type) const
 {
-    SmartAIEventList temp;
-    if (mEventMap[uint32(type)].find(entry) != mEventMap[uint32(type)].end())
-        return mEventMap[uint32(type)][entry];
+    static SmartAIEventList const empty;
+    auto itr = mEventMap[uint32(type)].find(entry);
+    if (itr != mEventMap[uint32(type)].end())
+        return itr->second;
     else
     {
         if (entry > 0)//first search is for guid (negative), do not drop error if not found
             TC_LOG_DEBUG("scripts.ai", "SmartAIMgr::GetScript: Could not load Script for Entry %d ScriptType %u.", entry, uint32(type));
-        return temp;
+        return empty;
     }
 }
 
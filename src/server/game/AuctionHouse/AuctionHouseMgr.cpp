@@ -595,12 +595,27 @@ void AuctionHouseObject::AddAuction(AuctionEntry* auction)
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+
+    if (ItemTemplate const* proto = sObjectMgr->GetItemTemplate(auction->itemEntry))
+    {
+        AuctionSearchIndex::Entry searchEntry;
+        searchEntry.AuctionId = auction->Id;
+        searchEntry.Auction = auction;
+        searchEntry.ItemClass = proto->Class;
+        searchEntry.ItemSubClass = proto->SubClass;
+        searchEntry.InventoryType = proto->InventoryType;
+        searchEntry.Quality = proto->Quality;
+        searchEntry.RequiredLevel = proto->RequiredLevel;
+        SearchIndex.Insert(searchEntry);
+    }
+
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction)
 {
     bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
+    SearchIndex.Remove(auction->Id);
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
@@ -735,103 +750,109 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
         return;
     }
 
-    for (AuctionEntryMap::const_iterator it = AuctionsMap.begin(); it != AuctionsMap.end(); ++it)
+    AuctionSearchIndex::Filter filter;
+    filter.ItemClass = itemClass;
+    filter.ItemSubClass = itemSubClass;
+    filter.InventoryType = inventoryType;
+    filter.Quality = quality;
+    filter.LevelMin = levelmin;
+    filter.LevelMax = levelmax;
+
+    // Template based filters are applied by the index, check the remaining ones from cheapest to most expensive
+    SearchIndex.Visit(filter, [&](AuctionSearchIndex::Entry& searchEntry)
     {
-        AuctionEntry* Aentry = it->second;
+        AuctionEntry* Aentry = searchEntry.Auction;
         // Skip expired auctions
         if (Aentry->expire_time < curTime)
-            continue;
+            return true;
 
         Item* item = sAuctionMgr->GetAItem(Aentry->itemGUIDLow);
         if (!item)
-            continue;
+            return true;
 
-        ItemTemplate const* proto = item->GetTemplate();
+        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
+        // No need to do any of this if no search term was entered
+        if (!wsearchedname.empty())
+        {
+            std::wstring const* name = searchEntry.GetName(localeConstant);
+            if (!name)
+                name = &searchEntry.SetName(localeConstant, BuildSearchName(item, localeConstant, locdbc_idx));
 
-        if (itemClass != 0xffffffff && proto->Class != itemClass)
-            continue;
+            // Perform the search (with or without suffix)
+            if (name->find(wsearchedname) == std::wstring::npos)
+                return true;
+        }
 
-        if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-            continue;
+        if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
+            return true;
 
-        if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
+        // Add the item if no search term or if entered search term was found
+        if (count < 50 && totalcount >= listfrom)
         {
-            // Cloth items can have INVTYPE_CHEST or INVTYPE_ROBE
-            if (!(inventoryType == INVTYPE_CHEST && proto->InventoryType == INVTYPE_ROBE))
-                continue;
+            ++count;
+            Aentry->BuildAuctionInfo(data, item);
         }
+        ++totalcount;
+        return true;
+    });
+}
 
-        if (quality != 0xffffffff && proto->Quality != quality)
-            continue;
-
-        if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
-            continue;
+std::wstring AuctionHouseObject::BuildSearchName(Item const* item, LocaleConstant localeConstant, int locdbc_idx)
+{
+    ItemTemplate const* proto = item->GetTemplate();
 
-        if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
-            continue;
+    std::string name = proto->Name1;
+    if (name.empty())
+        return {};
 
-        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-        // No need to do any of this if no search term was entered
-        if (!wsearchedname.empty())
-        {
-            std::string name = proto->Name1;
-            if (name.empty())
-                continue;
+    // local name
+    if (localeConstant != LOCALE_enUS)
+        if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
+            ObjectMgr::GetLocaleString(il->Name, localeConstant, name);
 
-            // local name
-            if (localeConstant != LOCALE_enUS)
-                if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
-                    ObjectMgr::GetLocaleString(il->Name, localeConstant, name);
+    // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+    //  that matches the search but it may not equal item->GetItemRandomPropertyId()
+    //  used in BuildAuctionInfo() which then causes wrong items to be listed
+    int32 propRefID = item->GetItemRandomPropertyId();
 
-            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-            int32 propRefID = item->GetItemRandomPropertyId();
+    if (propRefID)
+    {
+        // Append the suffix to the name (ie: of the Monkey) if one exists
+        // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
+        //  even though the DBC names seem misleading
 
-            if (propRefID)
-            {
-                // Append the suffix to the name (ie: of the Monkey) if one exists
-                // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
-                //  even though the DBC names seem misleading
-
-                std::array<char const*, 16> const* suffix = nullptr;
-
-                if (propRefID < 0)
-                {
-                    ItemRandomSuffixEntry const* itemRandSuffix = sItemRandomSuffixStore.LookupEntry(-propRefID);
-                    if (itemRandSuffix)
-                        suffix = &itemRandSuffix->Name;
-                }
-                else
-                {
-                    ItemRandomPropertiesEntry const* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
-                    if (itemRandProp)
-                        suffix = &itemRandProp->Name;
-                }
-
-                // dbc local name
-                if (suffix)
-                {
-                    // Append the suffix (ie: of the Monkey) to the name using localization
-                    // or default enUS if localization is invalid
-                    name += ' ';
-                    name += (*suffix)[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
-                }
-            }
+        std::array<char const*, 16> const* suffix = nullptr;
 
-            // Perform the search (with or without suffix)
-            if (!Utf8FitTo(name, wsearchedname))
-                continue;
+        if (propRefID < 0)
+        {
+            ItemRandomSuffixEntry const* itemRandSuffix = sItemRandomSuffixStore.LookupEntry(-propRefID);
+            if (itemRandSuffix)
+                suffix = &itemRandSuffix->Name;
+        }
+        else
+        {
+            ItemRandomPropertiesEntry const* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
+            if (itemRandProp)
+                suffix = &itemRandProp->Name;
         }
 
-        // Add the item if no search term or if entered search term was found
-        if (count < 50 && totalcount >= listfrom)
+        // dbc local name
+        if (suffix)
         {
-            ++count;
-            Aentry->BuildAuctionInfo(data, item);
+            // Append the suffix (ie: of the Monkey) to the name using localization
+            // or default enUS if localization is invalid
+            name += ' ';
+            name += (*suffix)[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
         }
-        ++totalcount;
     }
+
+    std::wstring wname;
+    if (!Utf8toWStr(name, wname))
+        return {};
+
+    // converting to lower case
+    wstrToLower(wname);
+    return wname;
 }
 
 //this function inserts to WorldPacket auction's data
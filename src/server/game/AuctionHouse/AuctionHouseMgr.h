@@ -18,6 +18,7 @@
 #ifndef _AUCTION_HOUSE_MGR_H
 #define _AUCTION_HOUSE_MGR_H
 
+#include "AuctionSearchIndex.h"
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
 #include "ObjectGuid.h"
@@ -29,6 +30,7 @@ class Item;
 class Player;
 class WorldPacket;
 struct AuctionHouseEntry;
+enum LocaleConstant : uint8;
 
 #define MIN_AUCTION_TIME (12*HOUR)
 #define MAX_AUCTION_ITEMS 160
@@ -149,8 +151,14 @@ public:
         uint32& count, uint32& totalcount, bool getall = false);
 
 private:
+    // Lower case localized item name including random suffix, as matched by BuildListAuctionItems
+    static std::wstring BuildSearchName(Item const* item, LocaleConstant localeConstant, int locdbc_idx);
+
     AuctionEntryMap AuctionsMap;
 
+    // Item properties of AuctionsMap entries used by BuildListAuctionItems
+    AuctionSearchIndex SearchIndex;
+
     // Map of throttled players for GetAll, and throttle expiry time
     // Stored here, rather than player object to maintain persistence after logout
     PlayerGetAllThrottleMap GetAllThrottleMap;
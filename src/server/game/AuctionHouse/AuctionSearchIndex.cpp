@@ -0,0 +1,176 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuctionSearchIndex.h"
+#include "ItemTemplate.h"
+#include <algorithm>
+
+std::wstring const* AuctionSearchIndex::Entry::GetName(uint8 locale) const
+{
+    for (auto const& [nameLocale, name] : _names)
+        if (nameLocale == locale)
+            return &name;
+
+    return nullptr;
+}
+
+std::wstring const& AuctionSearchIndex::Entry::SetName(uint8 locale, std::wstring name)
+{
+    for (auto& [nameLocale, existingName] : _names)
+    {
+        if (nameLocale == locale)
+        {
+            existingName = std::move(name);
+            return existingName;
+        }
+    }
+
+    return _names.emplace_back(locale, std::move(name)).second;
+}
+
+bool AuctionSearchIndex::Filter::Matches(Entry const& entry) const
+{
+    if (ItemClass != ANY && entry.ItemClass != ItemClass)
+        return false;
+
+    if (ItemSubClass != ANY && entry.ItemSubClass != ItemSubClass)
+        return false;
+
+    if (InventoryType != ANY && entry.InventoryType != InventoryType)
+    {
+        // Cloth items can have INVTYPE_CHEST or INVTYPE_ROBE
+        if (!(InventoryType == INVTYPE_CHEST && entry.InventoryType == INVTYPE_ROBE))
+            return false;
+    }
+
+    if (Quality != ANY && entry.Quality != Quality)
+        return false;
+
+    if (LevelMin != 0 && (entry.RequiredLevel < LevelMin || (LevelMax != 0 && entry.RequiredLevel > LevelMax)))
+        return false;
+
+    return true;
+}
+
+void AuctionSearchIndex::Insert(Entry const& entry)
+{
+    Remove(entry.AuctionId);
+
+    Entry* stored = &_entries.emplace(entry.AuctionId, entry).first->second;
+    _byClass[entry.ItemClass].emplace(entry.AuctionId, stored);
+    _bySubClass[MakeSubClassKey(entry.ItemClass, entry.ItemSubClass)].emplace(entry.AuctionId, stored);
+    _byQuality[entry.Quality].emplace(entry.AuctionId, stored);
+    _byRequiredLevel[entry.RequiredLevel].emplace(entry.AuctionId, stored);
+}
+
+namespace
+{
+    template<typename Container, typename Key>
+    void RemoveFromIndex(Container& container, Key const& key, uint32 auctionId)
+    {
+        auto itr = container.find(key);
+        if (itr == container.end())
+            return;
+
+        itr->second.erase(auctionId);
+        if (itr->second.empty())
+            container.erase(itr);
+    }
+}
+
+void AuctionSearchIndex::Remove(uint32 auctionId)
+{
+    auto itr = _entries.find(auctionId);
+    if (itr == _entries.end())
+        return;
+
+    Entry const& entry = itr->second;
+    RemoveFromIndex(_byClass, entry.ItemClass, auctionId);
+    RemoveFromIndex(_bySubClass, MakeSubClassKey(entry.ItemClass, entry.ItemSubClass), auctionId);
+    RemoveFromIndex(_byQuality, entry.Quality, auctionId);
+    RemoveFromIndex(_byRequiredLevel, entry.RequiredLevel, auctionId);
+    _entries.erase(itr);
+}
+
+AuctionSearchIndex::CandidateSource AuctionSearchIndex::SelectCandidates(Filter const& filter)
+{
+    CandidateSource source = CandidateSource::All;
+    std::size_t candidateCount = _entries.size();
+    _candidateIndex = nullptr;
+    _candidates.clear();
+
+    // client sent a reversed level range, nothing can match
+    if (filter.LevelMax != 0 && filter.LevelMax < filter.LevelMin)
+        return CandidateSource::None;
+
+    auto useIndex = [&](auto const& container, auto const& key)
+    {
+        auto itr = container.find(key);
+        if (itr == container.end())
+        {
+            source = CandidateSource::None;
+            candidateCount = 0;
+        }
+        else if (itr->second.size() < candidateCount)
+        {
+            source = CandidateSource::Index;
+            candidateCount = itr->second.size();
+            _candidateIndex = &itr->second;
+        }
+    };
+
+    if (filter.ItemClass != ANY)
+    {
+        if (filter.ItemSubClass != ANY)
+            useIndex(_bySubClass, MakeSubClassKey(filter.ItemClass, filter.ItemSubClass));
+        else
+            useIndex(_byClass, filter.ItemClass);
+    }
+
+    if (source != CandidateSource::None && filter.Quality != ANY)
+        useIndex(_byQuality, filter.Quality);
+
+    if (source != CandidateSource::None && filter.LevelMin != 0)
+    {
+        auto begin = _byRequiredLevel.lower_bound(filter.LevelMin);
+        auto end = filter.LevelMax != 0 ? _byRequiredLevel.upper_bound(filter.LevelMax) : _byRequiredLevel.end();
+
+        std::size_t levelCount = 0;
+        for (auto itr = begin; itr != end; ++itr)
+            levelCount += itr->second.size();
+
+        if (!levelCount)
+            source = CandidateSource::None;
+        else if (levelCount < candidateCount)
+        {
+            // Several levels are merged, restore auction id order
+            source = CandidateSource::Level;
+            _candidateIndex = nullptr;
+            _candidates.reserve(levelCount);
+            for (auto itr = begin; itr != end; ++itr)
+                for (auto const& [id, entry] : itr->second)
+                    _candidates.push_back(entry);
+
+            std::sort(_candidates.begin(), _candidates.end(), [](Entry const* left, Entry const* right)
+            {
+                return left->AuctionId < right->AuctionId;
+            });
+        }
+    }
+
+    return source;
+}
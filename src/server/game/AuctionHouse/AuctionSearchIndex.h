@@ -0,0 +1,128 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _AUCTION_SEARCH_INDEX_H
+#define _AUCTION_SEARCH_INDEX_H
+
+#include "Define.h"
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct AuctionEntry;
+
+// Keeps the item properties auction house searches filter on, so a search only touches
+// the auctions of the most selective index instead of every item of the auction house
+class TC_GAME_API AuctionSearchIndex
+{
+public:
+    static constexpr uint32 ANY = 0xFFFFFFFF;
+
+    struct TC_GAME_API Entry
+    {
+        uint32 AuctionId = 0;
+        AuctionEntry* Auction = nullptr;
+        uint32 ItemClass = 0;
+        uint32 ItemSubClass = 0;
+        uint32 InventoryType = 0;
+        uint32 Quality = 0;
+        uint32 RequiredLevel = 0;
+
+        // Lower case item names (with random suffix) by client locale, built on first search in that locale
+        std::wstring const* GetName(uint8 locale) const;
+        std::wstring const& SetName(uint8 locale, std::wstring name);
+
+    private:
+        std::vector<std::pair<uint8, std::wstring>> _names;
+    };
+
+    // Uses the same conventions as CMSG_AUCTION_LIST_ITEMS: ANY for unused fields, 0 for no level limit
+    struct TC_GAME_API Filter
+    {
+        uint32 ItemClass = ANY;
+        uint32 ItemSubClass = ANY;
+        uint32 InventoryType = ANY;
+        uint32 Quality = ANY;
+        uint8 LevelMin = 0;
+        uint8 LevelMax = 0;
+
+        bool Matches(Entry const& entry) const;
+    };
+
+    // Replaces the entry of an auction that was already added
+    void Insert(Entry const& entry);
+    void Remove(uint32 auctionId);
+
+    std::size_t GetSize() const { return _entries.size(); }
+
+    // Calls visitor for every entry matching filter in ascending auction id order, stops when visitor returns false
+    template<typename Visitor>
+    void Visit(Filter const& filter, Visitor&& visitor)
+    {
+        auto visit = [&](Entry& entry) { return !filter.Matches(entry) || visitor(entry); };
+
+        switch (SelectCandidates(filter))
+        {
+            case CandidateSource::None:
+                break;
+            case CandidateSource::All:
+                for (auto& [id, entry] : _entries)
+                    if (!visit(entry))
+                        break;
+                break;
+            case CandidateSource::Index:
+                for (auto const& [id, entry] : *_candidateIndex)
+                    if (!visit(*entry))
+                        break;
+                break;
+            case CandidateSource::Level:
+                for (Entry* entry : _candidates)
+                    if (!visit(*entry))
+                        break;
+                break;
+        }
+    }
+
+private:
+    typedef std::map<uint32, Entry*> EntryIndex;   // by auction id
+
+    enum class CandidateSource
+    {
+        None,
+        All,
+        Index,
+        Level
+    };
+
+    CandidateSource SelectCandidates(Filter const& filter);
+
+    static uint64 MakeSubClassKey(uint32 itemClass, uint32 itemSubClass) { return uint64(itemClass) << 32 | itemSubClass; }
+
+    std::map<uint32, Entry> _entries;
+    std::unordered_map<uint32, EntryIndex> _byClass;
+    std::unordered_map<uint64, EntryIndex> _bySubClass;
+    std::unordered_map<uint32, EntryIndex> _byQuality;
+    std::map<uint32, EntryIndex> _byRequiredLevel;
+
+    // Output of SelectCandidates
+    EntryIndex const* _candidateIndex = nullptr;
+    std::vector<Entry*> _candidates;
+};
+
+#endif // _AUCTION_SEARCH_INDEX_H
@@ -26,6 +26,7 @@
 #include "GridNotifiersImpl.h"
 #include "Language.h"
 #include "Log.h"
+#include "Metric.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Player.h"
@@ -203,6 +204,7 @@ void Channel::JoinChannel(Player* player, std::string const& pass)
         _nextActivityUpdateTime = 0; // force activity update on next channel tick
 
     PlayerInfo& pinfo = _playersStore[guid];
+    pinfo.player = player;
     pinfo.flags = MEMBER_FLAG_NONE;
     pinfo.invisible = !player->isGMVisible();
 
@@ -618,7 +620,7 @@ void Channel::List(Player const* player) const
     uint32 count  = 0;
     for (PlayerContainer::const_iterator i = _playersStore.begin(); i != _playersStore.end(); ++i)
     {
-        Player* member = ObjectAccessor::FindConnectedPlayer(i->first);
+        Player* member = i->second.player;
 
         // PLAYER can't see MODERATOR, GAME MASTER, ADMINISTRATOR characters
         // MODERATOR, GAME MASTER, ADMINISTRATOR can see all
@@ -706,7 +708,7 @@ void Channel::Say(ObjectGuid guid, std::string const& what, uint32 lang) const
     {
         LocaleConstant localeIdx = sWorld->GetAvailableDbcLocale(locale);
 
-        if (Player* player = ObjectAccessor::FindConnectedPlayer(guid))
+        if (Player* player = info.player)
             ChatHandler::BuildChatPacket(data, CHAT_MSG_CHANNEL, Language(lang), player, player, what, 0, GetName(localeIdx));
         else
             ChatHandler::BuildChatPacket(data, CHAT_MSG_CHANNEL, Language(lang), guid, guid, what, 0, "", "", 0, false, GetName(localeIdx));
@@ -861,10 +863,12 @@ void Channel::LeaveNotify(ObjectGuid guid) const
 template<class Builder>
 void Channel::SendToAll(Builder& builder, ObjectGuid guid /*= ObjectGuid::Empty*/) const
 {
+    TC_METRIC_TIMER("channel_fanout_time", TC_METRIC_TAG("type", GetMetricType()));
+
     Trinity::LocalizedPacketDo<Builder> localizer(builder);
 
     for (PlayerContainer::const_iterator i = _playersStore.begin(); i != _playersStore.end(); ++i)
-        if (Player* player = ObjectAccessor::FindConnectedPlayer(i->first))
+        if (Player* player = i->second.player)
             if (!guid || !player->GetSocial()->HasIgnore(guid))
                 localizer(player);
 }
@@ -872,11 +876,13 @@ void Channel::SendToAll(Builder& builder, ObjectGuid guid /*= ObjectGuid::Empty*
 template<class Builder>
 void Channel::SendToAllButOne(Builder& builder, ObjectGuid who) const
 {
+    TC_METRIC_TIMER("channel_fanout_time", TC_METRIC_TAG("type", GetMetricType()));
+
     Trinity::LocalizedPacketDo<Builder> localizer(builder);
 
     for (PlayerContainer::const_iterator i = _playersStore.begin(); i != _playersStore.end(); ++i)
         if (i->first != who)
-            if (Player* player = ObjectAccessor::FindConnectedPlayer(i->first))
+            if (Player* player = i->second.player)
                 localizer(player);
 }
 
@@ -885,6 +891,8 @@ void Channel::SendToOne(Builder& builder, ObjectGuid who) const
 {
     Trinity::LocalizedPacketDo<Builder> localizer(builder);
 
-    if (Player* player = ObjectAccessor::FindConnectedPlayer(who))
+    // Members are resolved without going through ObjectAccessor, others are only messaged for errors
+    PlayerContainer::const_iterator itr = _playersStore.find(who);
+    if (Player* player = itr != _playersStore.end() ? itr->second.player : ObjectAccessor::FindConnectedPlayer(who))
         localizer(player);
 }
@@ -120,6 +120,7 @@ class TC_GAME_API Channel
 {
     struct PlayerInfo
     {
+        Player* player;     // members leave all channels on logout, so this stays valid while the member is on the channel
         uint8 flags;
         bool invisible;
 
@@ -222,6 +223,9 @@ class TC_GAME_API Channel
         template<class Builder>
         void SendToOne(Builder& builder, ObjectGuid who) const;
 
+        // metric tag value, custom channel names are chosen by players and would create a series per channel
+        char const* GetMetricType() const { return HasFlag(CHANNEL_FLAG_CUSTOM) ? "custom" : (IsLFG() ? "lfg" : "world"); }
+
         bool IsOn(ObjectGuid who) const { return _playersStore.find(who) != _playersStore.end(); }
         bool IsBanned(ObjectGuid guid) const { return _bannedStore.find(guid) != _bannedStore.end(); }
 
@@ -32,9 +32,6 @@
 #include "WorldPacket.h"
 #include <algorithm>
 
-#include "Hacks/boost_1_74_fibonacci_heap.h"
-BOOST_1_74_FIBONACCI_HEAP_MSVC_COMPILE_FIX(ThreatManager::threat_list_heap::value_type)
-
 const CompareThreatLessThan ThreatManager::CompareThreat;
 
 void ThreatReference::AddThreat(float amount)
@@ -42,10 +39,7 @@ void ThreatReference::AddThreat(float amount)
     if (amount == 0.0f)
         return;
     _baseAmount = std::max<float>(_baseAmount + amount, 0.0f);
-    if (amount > 0.0f)
-        HeapNotifyIncreased();
-    else
-        HeapNotifyDecreased();
+    ListNotifyChanged();
     _mgr._needClientUpdate = true;
 }
 
@@ -54,10 +48,7 @@ void ThreatReference::ScaleThreat(float factor)
     if (factor == 1.0f)
         return;
     _baseAmount *= factor;
-    if (factor > 1.0f)
-        HeapNotifyIncreased();
-    else
-        HeapNotifyDecreased();
+    ListNotifyChanged();
     _mgr._needClientUpdate = true;
 }
 
@@ -70,13 +61,13 @@ void ThreatReference::UpdateOffline()
     if (shouldBeOffline)
     {
         _online = ONLINE_STATE_OFFLINE;
-        HeapNotifyDecreased();
+        ListNotifyChanged();
         _mgr.SendRemoveToClients(_victim);
     }
     else
     {
         _online = ShouldBeSuppressed() ? ONLINE_STATE_SUPPRESSED : ONLINE_STATE_ONLINE;
-        HeapNotifyIncreased();
+        ListNotifyChanged();
         _mgr.RegisterForAIUpdate(this);
     }
 }
@@ -131,12 +122,8 @@ void ThreatReference::UpdateTauntState(TauntState state)
     if (state == _taunted)
         return;
 
-    std::swap(state, _taunted);
-
-    if (_taunted < state)
-        HeapNotifyDecreased();
-    else
-        HeapNotifyIncreased();
+    _taunted = state;
+    ListNotifyChanged();
 
     _mgr._needClientUpdate = true;
 }
@@ -182,7 +169,7 @@ ThreatManager::ThreatManager(Unit* owner) : _owner(owner), _ownerCanHaveThreatLi
 ThreatManager::~ThreatManager()
 {
     ASSERT(_myThreatListEntries.empty(), "ThreatManager::~ThreatManager - %s: we still have %zu things threatening us, one of them is %s.", _owner->GetGUID().ToString().c_str(), _myThreatListEntries.size(), _myThreatListEntries.begin()->first.ToString().c_str());
-    ASSERT(_sortedThreatList.empty(), "ThreatManager::~ThreatManager - %s: we still have %zu things threatening us, one of them is %s.", _owner->GetGUID().ToString().c_str(), _sortedThreatList.size(), (*_sortedThreatList.begin())->GetVictim()->GetGUID().ToString().c_str());
+    ASSERT(_sortedThreatList.Empty(), "ThreatManager::~ThreatManager - %s: we still have %zu things threatening us, one of them is %s.", _owner->GetGUID().ToString().c_str(), _sortedThreatList.Size(), _sortedThreatList.GetUnsorted().front()->GetVictim()->GetGUID().ToString().c_str());
     ASSERT(_threatenedByMe.empty(), "ThreatManager::~ThreatManager - %s: we are still threatening %zu things, one of them is %s.", _owner->GetGUID().ToString().c_str(), _threatenedByMe.size(), _threatenedByMe.begin()->first.ToString().c_str());
 }
 
@@ -221,7 +208,7 @@ Unit* ThreatManager::GetLastVictim() const
 
 Unit* ThreatManager::GetAnyTarget() const
 {
-    for (ThreatReference const* ref : _sortedThreatList)
+    for (ThreatReference const* ref : _sortedThreatList.GetUnsorted())
         if (!ref->IsOffline())
             return ref->GetVictim();
     return nullptr;
@@ -230,8 +217,8 @@ Unit* ThreatManager::GetAnyTarget() const
 bool ThreatManager::IsThreatListEmpty(bool includeOffline) const
 {
     if (includeOffline)
-        return _sortedThreatList.empty();
-    for (ThreatReference const* ref : _sortedThreatList)
+        return _sortedThreatList.Empty();
+    for (ThreatReference const* ref : _sortedThreatList.GetUnsorted())
         if (ref->IsAvailable())
             return false;
     return true;
@@ -258,8 +245,8 @@ std::vector<ThreatReference*> ThreatManager::GetModifiableThreatList()
 {
     std::vector<ThreatReference*> list;
     list.reserve(_myThreatListEntries.size());
-    for (auto it = _sortedThreatList.ordered_begin(), end = _sortedThreatList.ordered_end(); it != end; ++it)
-        list.push_back(const_cast<ThreatReference*>(*it));
+    for (ThreatReference const* ref : _sortedThreatList.GetSorted())
+        list.push_back(const_cast<ThreatReference*>(ref));
     return list;
 }
 
@@ -290,12 +277,12 @@ void ThreatManager::EvaluateSuppressed(bool canExpire)
         if (pair.second->IsOnline() && shouldBeSuppressed)
         {
             pair.second->_online = ThreatReference::ONLINE_STATE_SUPPRESSED;
-            pair.second->HeapNotifyDecreased();
+            pair.second->ListNotifyChanged();
         }
         else if (canExpire && pair.second->IsSuppressed() && !shouldBeSuppressed)
         {
             pair.second->_online = ThreatReference::ONLINE_STATE_ONLINE;
-            pair.second->HeapNotifyIncreased();
+            pair.second->ListNotifyChanged();
         }
     }
 }
@@ -398,7 +385,7 @@ void ThreatManager::AddThreat(Unit* target, float amount, SpellInfo const* spell
             if (!ref->ShouldBeSuppressed())
             {
                 ref->_online = ThreatReference::ONLINE_STATE_ONLINE;
-                ref->HeapNotifyIncreased();
+                ref->ListNotifyChanged();
             }
 
         if (ref->IsOnline())
@@ -430,10 +417,10 @@ void ThreatManager::ScaleThreat(Unit* target, float factor)
 
 void ThreatManager::MatchUnitThreatToHighestThreat(Unit* target)
 {
-    if (_sortedThreatList.empty())
+    if (_sortedThreatList.Empty())
         return;
 
-    auto it = _sortedThreatList.ordered_begin(), end = _sortedThreatList.ordered_end();
+    auto it = _sortedThreatList.GetSorted().begin(), end = _sortedThreatList.GetSorted().end();
     ThreatReference const* highest = *it;
     if (!highest->IsAvailable())
         return;
@@ -542,7 +529,7 @@ void ThreatManager::UpdateVictim()
 
 ThreatReference const* ThreatManager::ReselectVictim()
 {
-    if (_sortedThreatList.empty())
+    if (_sortedThreatList.Empty())
         return nullptr;
 
     for (auto const& pair : _myThreatListEntries)
@@ -556,7 +543,7 @@ ThreatReference const* ThreatManager::ReselectVictim()
     if (oldVictimRef && oldVictimRef->IsOffline())
         oldVictimRef = nullptr;
     // in 99% of cases - we won't need to actually look at anything beyond the first element
-    ThreatReference const* highest = _sortedThreatList.top();
+    ThreatReference const* highest = _sortedThreatList.Top();
     // if the highest reference is offline, the entire list is offline, and we indicate this
     if (!highest->IsAvailable())
         return nullptr;
@@ -573,8 +560,8 @@ ThreatReference const* ThreatManager::ReselectVictim()
     if (_owner->IsWithinMeleeRange(highest->_victim))
         return highest;
     // If we get here, highest threat is ranged, but below 130% of current - there might be a melee that breaks 110% below us somewhere, so now we need to actually look at the next highest element
-    // luckily, this is a heap, so getting the next highest element is O(log n), and we're just gonna do that repeatedly until we've seen enough targets (or find a target)
-    auto it = _sortedThreatList.ordered_begin(), end = _sortedThreatList.ordered_end();
+    // the list was just sorted by Top(), so we can simply walk it until we've seen enough targets (or find a target)
+    auto it = _sortedThreatList.GetSorted().begin(), end = _sortedThreatList.GetSorted().end();
     while (it != end)
     {
         ThreatReference const* next = *it;
@@ -714,19 +701,11 @@ void ThreatManager::UpdateMyTempModifiers()
     for (AuraEffect const* eff : _owner->GetAuraEffectsByType(SPELL_AURA_MOD_TOTAL_THREAT))
         mod += eff->GetAmount();
 
-    if (_threatenedByMe.empty())
-        return;
-
-    auto it = _threatenedByMe.begin();
-    bool const isIncrease = (it->second->_tempModifier < mod);
-    do
+    for (auto const& pair : _threatenedByMe)
     {
-        it->second->_tempModifier = mod;
-        if (isIncrease)
-            it->second->HeapNotifyIncreased();
-        else
-            it->second->HeapNotifyDecreased();
-    } while ((++it) != _threatenedByMe.end());
+        pair.second->_tempModifier = mod;
+        pair.second->ListNotifyChanged();
+    }
 }
 
 void ThreatManager::UpdateMySpellSchoolModifiers()
@@ -781,14 +760,14 @@ void ThreatManager::SendRemoveToClients(Unit const* victim) const
 
 void ThreatManager::SendThreatListToClients(bool newHighest) const
 {
-    WorldPacket data(newHighest ? SMSG_HIGHEST_THREAT_UPDATE : SMSG_THREAT_UPDATE, (_sortedThreatList.size() + 2) * 8); // guess
+    WorldPacket data(newHighest ? SMSG_HIGHEST_THREAT_UPDATE : SMSG_THREAT_UPDATE, (_sortedThreatList.Size() + 2) * 8); // guess
     data << _owner->GetPackGUID();
     if (newHighest)
         data << _currentVictimRef->GetVictim()->GetPackGUID();
     size_t countPos = data.wpos();
     data << uint32(0); // placeholder
     uint32 count = 0;
-    for (ThreatReference const* ref : _sortedThreatList)
+    for (ThreatReference const* ref : _sortedThreatList.GetUnsorted())
     {
         if (!ref->IsAvailable())
             continue;
@@ -806,7 +785,7 @@ void ThreatManager::PutThreatListRef(ObjectGuid const& guid, ThreatReference* re
     auto& inMap = _myThreatListEntries[guid];
     ASSERT(!inMap, "Duplicate threat reference at %p being inserted on %s for %s - memory leak!", ref, _owner->GetGUID().ToString().c_str(), guid.ToString().c_str());
     inMap = ref;
-    ref->_handle = _sortedThreatList.push(ref);
+    _sortedThreatList.Insert(ref);
 }
 
 void ThreatManager::PurgeThreatListRef(ObjectGuid const& guid)
@@ -816,7 +795,7 @@ void ThreatManager::PurgeThreatListRef(ObjectGuid const& guid)
         return;
     ThreatReference* ref = it->second;
     _myThreatListEntries.erase(it);
-    _sortedThreatList.erase(ref->_handle);
+    _sortedThreatList.Remove(ref);
 
     if (_fixateRef == ref)
         _fixateRef = nullptr;
@@ -20,9 +20,9 @@
 
 #include "Common.h"
 #include "IteratorPair.h"
+#include "LazySortedVector.h"
 #include "ObjectGuid.h"
 #include "SharedDefines.h"
-#include <boost/heap/fibonacci_heap.hpp>
 #include <array>
 #include <unordered_map>
 #include <vector>
@@ -47,8 +47,8 @@ class SpellInfo;
  *  - Adding threat will also create a combat reference between the units if one doesn't exist yet (even if the owner can't have a threat list!)        *
  *  - Ending combat between two units will also delete any threat references that may exist between them.                                               *
  *                                                                                                                                                      *
- * To manage a creature's threat list, ThreatManager maintains a heap of threat reference const pointers.                                               *
- * This heap is kept well-structured in all methods that modify ThreatReference, and is used to select the next target.                                 *
+ * To manage a creature's threat list, ThreatManager maintains a lazily sorted vector of threat reference const pointers.                                *
+ * All methods that modify ThreatReference mark it unsorted, and it is re-sorted on the next ordered access (such as selecting the next target).         *
  *                                                                                                                                                      *
  * Selection uses the following properties on ThreatReference, in order:                                                                                *
  * - Online state (one of ONLINE, SUPPRESSED, OFFLINE):                                                                                                 *
@@ -65,7 +65,7 @@ class SpellInfo;
  * The current (= last selected) victim can be accessed using GetCurrentVictim.                                                                         *
  * Beyond that, ThreatManager has a variety of helpers and notifiers, which are documented inline below.                                                *
  *                                                                                                                                                      *
- * SPECIAL NOTE: Please be aware that any iterator may be invalidated if you modify a ThreatReference. The heap holds const pointers for a reason, but  *
+ * SPECIAL NOTE: Please be aware that any iterator may be invalidated if you modify a ThreatReference. The list holds const pointers for a reason, but  *
  *                 that doesn't mean you're scot free. A variety of actions (casting spells, teleporting units, and so forth) can cause changes to      *
  *                 the threat list. Use with care - or default to GetModifiableThreatList(), which inherently copies entries.                           *
 \********************************************************************************************************************************************************/
@@ -81,7 +81,7 @@ struct CompareThreatLessThan
 class TC_GAME_API ThreatManager
 {
     public:
-        typedef boost::heap::fibonacci_heap<ThreatReference const*, boost::heap::compare<CompareThreatLessThan>> threat_list_heap;
+        typedef Trinity::LazySortedVector<ThreatReference const*, CompareThreatLessThan> sorted_threat_list;
         class ThreatListIterator;
         static const uint32 THREAT_UPDATE_INTERVAL = 1000u;
 
@@ -115,14 +115,14 @@ class TC_GAME_API ThreatManager
         bool IsThreatenedBy(Unit const* who, bool includeOffline = false) const;
         // returns ThreatReference amount if a ref exists, 0.0f otherwise
         float GetThreat(Unit const* who, bool includeOffline = false) const;
-        size_t GetThreatListSize() const { return _sortedThreatList.size(); }
+        size_t GetThreatListSize() const { return _sortedThreatList.Size(); }
         // fastest of the three threat list getters - gets the threat list in "arbitrary" order
         // iterators will invalidate on adding/removing entries from the threat list; slightly less finicky than GetSorted.
         Trinity::IteratorPair<ThreatListIterator> GetUnsortedThreatList() const { return { _myThreatListEntries.begin(), _myThreatListEntries.end() }; }
         // slightly slower than GetUnsorted, but, well...sorted - only use it if you need the sorted property, of course
         // this iterator pair will invalidate on any modification (even indirect) of the threat list; spell casts and similar can all induce this!
         // note: current tank is NOT guaranteed to be the first entry in this list - check GetLastVictim separately if you want that!
-        Trinity::IteratorPair<threat_list_heap::ordered_iterator> GetSortedThreatList() const { return { _sortedThreatList.ordered_begin(), _sortedThreatList.ordered_end() }; }
+        Trinity::IteratorPair<sorted_threat_list::const_iterator> GetSortedThreatList() const { auto const& list = _sortedThreatList.GetSorted(); return { list.begin(), list.end() }; }
         // slowest of the three threat list getters (by far), but lets you modify the threat references - this is also sorted
         std::vector<ThreatReference*> GetModifiableThreatList();
 
@@ -198,7 +198,7 @@ class TC_GAME_API ThreatManager
 
         bool _needClientUpdate;
         uint32 _updateTimer;
-        threat_list_heap _sortedThreatList;
+        sorted_threat_list _sortedThreatList;
         std::unordered_map<ObjectGuid, ThreatReference*> _myThreatListEntries;
 
         // AI notifies are delayed to ensure we are in a consistent state before we call out to arbitrary logic
@@ -291,14 +291,12 @@ class TC_GAME_API ThreatReference
         void UpdateTauntState(TauntState state = TAUNT_STATE_NONE);
         Creature* const _owner;
         ThreatManager& _mgr;
-        void HeapNotifyIncreased() { _mgr._sortedThreatList.increase(_handle); }
-        void HeapNotifyDecreased() { _mgr._sortedThreatList.decrease(_handle); }
+        void ListNotifyChanged() { _mgr._sortedThreatList.Invalidate(); }
         Unit* const _victim;
         OnlineState _online;
         float _baseAmount;
         int32 _tempModifier; // Temporary effects (auras with SPELL_AURA_MOD_TOTAL_THREAT) - set from victim's threatmanager in ThreatManager::UpdateMyTempModifiers
         TauntState _taunted;
-        ThreatManager::threat_list_heap::handle_type _handle;
 
     public:
         ThreatReference(ThreatReference const&) = delete;
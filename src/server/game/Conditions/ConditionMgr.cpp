@@ -735,6 +735,50 @@ uint32 Condition::GetSearcherTypeMaskForCondition() const
     return mask;
 }
 
+ConditionEvaluationCost Condition::GetEvaluationCost() const
+{
+    if (ReferenceId)
+        return CONDITION_COST_REFERENCE;
+
+    switch (ConditionType)
+    {
+        case CONDITION_NONE:
+        case CONDITION_ZONEID:
+        case CONDITION_TEAM:
+        case CONDITION_DRUNKENSTATE:
+        case CONDITION_CLASS:
+        case CONDITION_RACE:
+        case CONDITION_SPAWNMASK:
+        case CONDITION_GENDER:
+        case CONDITION_UNIT_STATE:
+        case CONDITION_MAPID:
+        case CONDITION_AREAID:
+        case CONDITION_CREATURE_TYPE:
+        case CONDITION_PHASEMASK:
+        case CONDITION_LEVEL:
+        case CONDITION_OBJECT_ENTRY_GUID:
+        case CONDITION_TYPE_MASK:
+        case CONDITION_DISTANCE_TO:
+        case CONDITION_ALIVE:
+        case CONDITION_HP_VAL:
+        case CONDITION_HP_PCT:
+        case CONDITION_IN_WATER:
+        case CONDITION_STAND_STATE:
+        case CONDITION_CHARMED:
+        case CONDITION_TAXI:
+        case CONDITION_DIFFICULTY_ID:
+        case CONDITION_GAMEMASTER:
+            return CONDITION_COST_FIELD;
+        case CONDITION_ITEM:
+        case CONDITION_ITEM_EQUIPPED:
+        case CONDITION_NEAR_CREATURE:
+        case CONDITION_NEAR_GAMEOBJECT:
+            return CONDITION_COST_SCAN;
+        default:
+            return CONDITION_COST_LOOKUP;
+    }
+}
+
 uint32 Condition::GetMaxAvailableConditionTargets() const
 {
     // returns number of targets which are available for given source type
@@ -833,48 +877,44 @@ uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionContainer cons
 
 bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const
 {
-    //     groupId, groupCheckPassed
-    std::map<uint32, bool> elseGroupStore;
-    for (Condition const* condition : conditions)
+    // lists are kept grouped by ElseGroup and sorted by cost at load, see AddToConditionList
+    return IsAnyElseGroupMet(conditions, [&](Condition const* condition)
     {
-        TC_LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList %s val1: %u", condition->ToString().c_str(), condition->ConditionValue1);
-        if (condition->isLoaded())
-        {
-            //! Find ElseGroup in ElseGroupStore
-            std::map<uint32, bool>::const_iterator itr = elseGroupStore.find(condition->ElseGroup);
-            //! If not found, add an entry in the store and set to true (placeholder)
-            if (itr == elseGroupStore.end())
-                elseGroupStore[condition->ElseGroup] = true;
-            else if (!(*itr).second) //! If another condition in this group was unmatched before this, don't bother checking (the group is false anyway)
-                continue;
-
-            if (condition->ReferenceId)//handle reference
-            {
-                ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find(condition->ReferenceId);
-                if (ref != ConditionReferenceStore.end())
-                {
-                    if (!IsObjectMeetToConditionList(sourceInfo, ref->second))
-                        elseGroupStore[condition->ElseGroup] = false;
-                }
-                else
-                {
-                    TC_LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList %s Reference template -%u not found",
-                        condition->ToString().c_str(), condition->ReferenceId); // checked at loading, should never happen
-                }
+        if (condition->ReferenceId) // handle reference
+        {
+            ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find(condition->ReferenceId);
+            if (ref != ConditionReferenceStore.end())
+                return IsObjectMeetToConditionList(sourceInfo, ref->second);
 
-            }
-            else //handle normal condition
-            {
-                if (!condition->Meets(sourceInfo))
-                    elseGroupStore[condition->ElseGroup] = false;
-            }
-        }
-    }
-    for (std::map<uint32, bool>::const_iterator i = elseGroupStore.begin(); i != elseGroupStore.end(); ++i)
-        if (i->second)
+            TC_LOG_DEBUG("condition", "ConditionMgr::IsObjectMeetToConditionList %s Reference template -%u not found",
+                condition->ToString().c_str(), condition->ReferenceId); // checked at loading, should never happen
             return true;
+        }
 
-    return false;
+        return condition->Meets(sourceInfo);
+    });
+}
+
+void ConditionMgr::AddToConditionList(ConditionContainer& conditions, Condition* cond)
+{
+    // spell conditions keep their load order, the last failed one decides the cast error sent to the client.
+    // So do reference templates (no source type), a spell condition list referencing one evaluates its rows in place
+    auto costOf = [](Condition const* condition)
+    {
+        if (condition->SourceType == CONDITION_SOURCE_TYPE_SPELL || condition->SourceType == CONDITION_SOURCE_TYPE_NONE)
+            return CONDITION_COST_FIELD;
+
+        return condition->GetEvaluationCost();
+    };
+
+    auto itr = std::upper_bound(conditions.begin(), conditions.end(), cond, [&](Condition const* left, Condition const* right)
+    {
+        if (left->ElseGroup != right->ElseGroup)
+            return left->ElseGroup < right->ElseGroup;
+
+        return costOf(left) < costOf(right);
+    });
+    conditions.insert(itr, cond);
 }
 
 bool ConditionMgr::IsObjectMeetToConditions(WorldObject* object, ConditionContainer const& conditions) const
@@ -1151,7 +1191,7 @@ void ConditionMgr::LoadConditions(bool isReload)
 
         if (iSourceTypeOrReferenceId < 0)//it is a reference template
         {
-            ConditionReferenceStore[std::abs(iSourceTypeOrReferenceId)].push_back(cond);//add to reference storage
+            AddToConditionList(ConditionReferenceStore[std::abs(iSourceTypeOrReferenceId)], cond);//add to reference storage
             ++count;
             continue;
         }//end of reference templates
@@ -1239,7 +1279,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT:
                 {
-                    SpellClickEventConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToConditionList(SpellClickEventConditionStore[cond->SourceGroup][cond->SourceEntry], cond);
                     if (cond->ConditionType == CONDITION_AURA)
                         SpellsUsedInSpellClickConditions.insert(cond->ConditionValue1);
                     valid = true;
@@ -1251,7 +1291,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_VEHICLE_SPELL:
                 {
-                    VehicleSpellConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToConditionList(VehicleSpellConditionStore[cond->SourceGroup][cond->SourceEntry], cond);
                     valid = true;
                     ++count;
                     continue;   // do not add to m_AllocatedMemory to avoid double deleting
@@ -1260,14 +1300,14 @@ void ConditionMgr::LoadConditions(bool isReload)
                 {
                     //! TODO: PAIR_32 ?
                     std::pair<int32, uint32> key = std::make_pair(cond->SourceEntry, cond->SourceId);
-                    SmartEventConditionStore[key][cond->SourceGroup].push_back(cond);
+                    AddToConditionList(SmartEventConditionStore[key][cond->SourceGroup], cond);
                     valid = true;
                     ++count;
                     continue;
                 }
                 case CONDITION_SOURCE_TYPE_NPC_VENDOR:
                 {
-                    NpcVendorConditionContainerStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToConditionList(NpcVendorConditionContainerStore[cond->SourceGroup][cond->SourceEntry], cond);
                     valid = true;
                     ++count;
                     continue;
@@ -1293,7 +1333,7 @@ void ConditionMgr::LoadConditions(bool isReload)
         //add new Condition to storage based on Type/Entry
         if (cond->SourceType == CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT && cond->ConditionType == CONDITION_AURA)
             SpellsUsedInSpellClickConditions.insert(cond->ConditionValue1);
-        ConditionStore[cond->SourceType][cond->SourceEntry].push_back(cond);
+        AddToConditionList(ConditionStore[cond->SourceType][cond->SourceEntry], cond);
         ++count;
     }
     while (result->NextRow());
@@ -1326,7 +1366,7 @@ bool ConditionMgr::addToGossipMenus(Condition* cond) const
         {
             if ((*itr).second.MenuID == cond->SourceGroup && (*itr).second.TextID == uint32(cond->SourceEntry))
             {
-                (*itr).second.Conditions.push_back(cond);
+                AddToConditionList((*itr).second.Conditions, cond);
                 return true;
             }
         }
@@ -1345,7 +1385,7 @@ bool ConditionMgr::addToGossipMenuItems(Condition* cond) const
         {
             if ((*itr).second.MenuID == cond->SourceGroup && (*itr).second.OptionID == uint32(cond->SourceEntry))
             {
-                (*itr).second.Conditions.push_back(cond);
+                AddToConditionList((*itr).second.Conditions, cond);
                 return true;
             }
         }
@@ -1461,7 +1501,7 @@ bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond) const
                     return false;
                 }
             }
-            sharedList->push_back(cond);
+            AddToConditionList(*sharedList, cond);
             break;
         }
     }
@@ -115,6 +115,7 @@ enum ConditionTypes
             checks the conditions.
 
     Step 7: Implement loading for your source type in ConditionMgr::LoadConditions.
+            Conditions must be added to their container with ConditionMgr::AddToConditionList.
 
     Step 8: Implement memory cleaning for your source type in ConditionMgr::Clean.
 */
@@ -175,6 +176,15 @@ enum MaxConditionTargets
     MAX_CONDITION_TARGETS = 3
 };
 
+// Rough cost of Condition::Meets, cheaper conditions of an else group are checked first
+enum ConditionEvaluationCost : uint8
+{
+    CONDITION_COST_FIELD = 0,       // compares a value stored on the object or map
+    CONDITION_COST_LOOKUP,          // single container lookup (auras, quests, reputation...)
+    CONDITION_COST_SCAN,            // walks inventory or grid cells
+    CONDITION_COST_REFERENCE        // nested condition list
+};
+
 struct TC_GAME_API ConditionSourceInfo
 {
     WorldObject* mConditionTargets[MAX_CONDITION_TARGETS]; // an array of targets available for conditions
@@ -227,6 +237,7 @@ struct TC_GAME_API Condition
 
     bool Meets(ConditionSourceInfo& sourceInfo) const;
     uint32 GetSearcherTypeMaskForCondition() const;
+    ConditionEvaluationCost GetEvaluationCost() const;
     bool isLoaded() const { return ConditionType > CONDITION_NONE || ReferenceId; }
     uint32 GetMaxAvailableConditionTargets() const;
 
@@ -269,6 +280,38 @@ class TC_GAME_API ConditionMgr
 
         bool IsSpellUsedInSpellClickConditions(uint32 spellId) const;
 
+        // Inserts cond so that every else group is stored contiguously, cheapest conditions first
+        static void AddToConditionList(ConditionContainer& conditions, Condition* cond);
+
+        // Returns true for the first else group whose conditions all pass check
+        // conditions must have been built with AddToConditionList
+        template<typename Check>
+        static bool IsAnyElseGroupMet(ConditionContainer const& conditions, Check&& check)
+        {
+            auto itr = conditions.begin();
+            while (itr != conditions.end())
+            {
+                uint32 elseGroup = (*itr)->ElseGroup;
+                bool groupMet = true;
+                for (; itr != conditions.end() && (*itr)->ElseGroup == elseGroup; ++itr)
+                {
+                    if (!check(*itr))
+                    {
+                        groupMet = false;
+                        break;
+                    }
+                }
+
+                if (groupMet)
+                    return true;
+
+                // skip the rest of the failed group
+                while (itr != conditions.end() && (*itr)->ElseGroup == elseGroup)
+                    ++itr;
+            }
+            return false;
+        }
+
         struct ConditionTypeInfo
         {
             char const* Name;
@@ -0,0 +1,98 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LFGCompatibilityCache.h"
+#include <algorithm>
+
+namespace lfg
+{
+
+bool LfgCompatibilityKey::AddSlot(uint32 slot)
+{
+    if (size >= MAX_SLOTS)
+    {
+        Invalidate();
+        return false;
+    }
+
+    auto itr = std::upper_bound(slots.begin(), slots.begin() + size, slot);
+    std::move_backward(itr, slots.begin() + size, slots.begin() + size + 1);
+    *itr = slot;
+    ++size;
+    return true;
+}
+
+bool LfgCompatibilityKey::Contains(uint32 slot) const
+{
+    return IsValid() && std::binary_search(slots.begin(), slots.begin() + size, slot);
+}
+
+std::size_t LfgCompatibilityKeyHash::operator()(LfgCompatibilityKey const& key) const
+{
+    std::size_t hash = key.size;
+    for (uint8 i = 0; i < key.size; ++i)
+        hash = hash * 0x100000001B3ull ^ key.slots[i];
+
+    return hash;
+}
+
+LfgCompatibilityData* LfgCompatibilityCache::Find(LfgCompatibilityKey const& key)
+{
+    Container::iterator itr = _store.find(key);
+    if (itr != _store.end())
+        return &itr->second;
+
+    return nullptr;
+}
+
+LfgCompatibilityData& LfgCompatibilityCache::Get(LfgCompatibilityKey const& key)
+{
+    std::pair<Container::iterator, bool> result = _store.try_emplace(key);
+    if (result.second)
+    {
+        for (uint8 i = 0; i < key.size; ++i)
+        {
+            uint32 slot = key.slots[i];
+            if (slot >= _keysBySlot.size())
+                _keysBySlot.resize(slot + 1);
+
+            std::vector<LfgCompatibilityKey>& keys = _keysBySlot[slot];
+
+            // Drop combinations removed through other slots now and then, so the list of a long queued slot does not keep growing
+            if (keys.size() >= 16 && !(keys.size() & (keys.size() - 1)))
+                keys.erase(std::remove_if(keys.begin(), keys.end(), [this](LfgCompatibilityKey const& oldKey) { return !_store.count(oldKey); }), keys.end());
+
+            keys.push_back(key);
+        }
+    }
+
+    return result.first->second;
+}
+
+void LfgCompatibilityCache::RemoveSlot(uint32 slot)
+{
+    if (slot >= _keysBySlot.size())
+        return;
+
+    // Other members of removed combinations still list them, Find/VisitSlot skip those
+    std::vector<LfgCompatibilityKey> keys;
+    keys.swap(_keysBySlot[slot]);
+    for (LfgCompatibilityKey const& key : keys)
+        _store.erase(key);
+}
+
+} // namespace lfg
@@ -0,0 +1,121 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _LFGCOMPATIBILITYCACHE_H
+#define _LFGCOMPATIBILITYCACHE_H
+
+#include "LFG.h"
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+namespace lfg
+{
+
+enum LfgCompatibility
+{
+    LFG_COMPATIBILITY_PENDING,
+    LFG_INCOMPATIBLES_WRONG_GROUP_SIZE,
+    LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS,
+    LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS,
+    LFG_INCOMPATIBLES_HAS_IGNORES,
+    LFG_INCOMPATIBLES_NO_ROLES,
+    LFG_INCOMPATIBLES_NO_DUNGEONS,
+    LFG_COMPATIBLES_WITH_LESS_PLAYERS,                     // Values under this = not compatible (do not modify order)
+    LFG_COMPATIBLES_BAD_STATES,
+    LFG_COMPATIBLES_MATCH                                  // Must be the last one
+};
+
+struct LfgCompatibilityData
+{
+    LfgCompatibilityData(): compatibility(LFG_COMPATIBILITY_PENDING) { }
+    LfgCompatibilityData(LfgCompatibility _compatibility): compatibility(_compatibility) { }
+    LfgCompatibilityData(LfgCompatibility _compatibility, LfgRolesMap const& _roles):
+        compatibility(_compatibility), roles(_roles) { }
+
+    LfgCompatibility compatibility;
+    LfgRolesMap roles;
+};
+
+/// Identifies a combination of queued players/groups by their queue slots, independent of the order they were added
+struct TC_GAME_API LfgCompatibilityKey
+{
+    static constexpr uint32 MAX_SLOTS = 5;                 ///< MAXGROUPSIZE, one slot per queued player or group
+    static constexpr uint32 INVALID_SLOT = 0xFFFFFFFF;
+
+    LfgCompatibilityKey() : size(0) { slots.fill(INVALID_SLOT); }
+
+    /// Returns false (and leaves the key invalid) if the key is full
+    bool AddSlot(uint32 slot);
+    bool Contains(uint32 slot) const;
+
+    bool IsValid() const { return size != 0 && size <= MAX_SLOTS; }
+    void Invalidate() { size = MAX_SLOTS + 1; }
+    void Clear() { *this = LfgCompatibilityKey(); }
+
+    bool operator==(LfgCompatibilityKey const& right) const { return size == right.size && slots == right.slots; }
+    bool operator!=(LfgCompatibilityKey const& right) const { return !(*this == right); }
+
+    std::array<uint32, MAX_SLOTS> slots;                   ///< Sorted, unused ones are INVALID_SLOT
+    uint8 size;
+};
+
+struct LfgCompatibilityKeyHash
+{
+    std::size_t operator()(LfgCompatibilityKey const& key) const;
+};
+
+/**
+    Caches the compatibility of combinations of queued players/groups.
+    Entries are also indexed by each of their slots, so everything related to a slot
+    can be found or dropped without looking at the rest of the cache.
+*/
+class TC_GAME_API LfgCompatibilityCache
+{
+    public:
+        typedef std::unordered_map<LfgCompatibilityKey, LfgCompatibilityData, LfgCompatibilityKeyHash> Container;
+
+        LfgCompatibilityData* Find(LfgCompatibilityKey const& key);
+        LfgCompatibilityData& Get(LfgCompatibilityKey const& key);  ///< Creates a pending entry if not found
+        void RemoveSlot(uint32 slot);
+
+        /// Calls visitor(key, data) for every cached combination containing slot
+        template<typename Visitor>
+        void VisitSlot(uint32 slot, Visitor&& visitor) const
+        {
+            if (slot >= _keysBySlot.size())
+                return;
+
+            for (LfgCompatibilityKey const& key : _keysBySlot[slot])
+            {
+                Container::const_iterator itr = _store.find(key);
+                if (itr != _store.end())
+                    visitor(itr->first, itr->second);
+            }
+        }
+
+        std::size_t GetSize() const { return _store.size(); }
+        Container const& GetStore() const { return _store; }
+
+    private:
+        Container _store;
+        std::vector<std::vector<LfgCompatibilityKey>> _keysBySlot; ///< May contain keys already removed through another slot
+};
+
+} // namespace lfg
+
+#endif
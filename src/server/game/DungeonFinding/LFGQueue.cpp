@@ -28,30 +28,6 @@
 namespace lfg
 {
 
-/**
-   Given a list of guids returns the concatenation using | as delimiter
-
-   @param[in]     check list of guids
-   @returns Concatenated string
-*/
-std::string ConcatenateGuids(GuidList const& check)
-{
-    if (check.empty())
-        return "";
-
-    // need the guids in order to avoid duplicates
-    GuidSet guids(check.begin(), check.end());
-
-    std::ostringstream o;
-
-    GuidSet::const_iterator it = guids.begin();
-    o << it->GetRawValue();
-    for (++it; it != guids.end(); ++it)
-        o << '|' << it->GetRawValue();
-
-    return o.str();
-}
-
 char const* GetCompatibleString(LfgCompatibility compatibles)
 {
     switch (compatibles)
@@ -82,9 +58,81 @@ char const* GetCompatibleString(LfgCompatibility compatibles)
 }
 
 LfgQueueData::LfgQueueData() : joinTime(GameTime::GetGameTime()), tanks(LFG_TANKS_NEEDED),
-healers(LFG_HEALERS_NEEDED), dps(LFG_DPS_NEEDED)
+healers(LFG_HEALERS_NEEDED), dps(LFG_DPS_NEEDED), slot(LfgCompatibilityKey::INVALID_SLOT)
 { }
 
+/**
+   Given a list of guids returns the key of their combination in the compatibility cache
+
+   @param[in]     check list of guids
+   @returns Key of the combination, invalid if a guid is not queued or there are too many guids
+*/
+LfgCompatibilityKey LFGQueue::GetCompatibilityKey(GuidList const& check) const
+{
+    LfgCompatibilityKey key;
+    for (ObjectGuid guid : check)
+    {
+        LfgQueueDataContainer::const_iterator itQueue = QueueDataStore.find(guid);
+        if (itQueue == QueueDataStore.end() || itQueue->second.slot == LfgCompatibilityKey::INVALID_SLOT)
+        {
+            key.Invalidate();
+            break;
+        }
+
+        if (!key.AddSlot(itQueue->second.slot))
+            break;
+    }
+
+    return key;
+}
+
+/**
+   Given a compatibility key returns the concatenation of its guids using | as delimiter
+
+   @param[in]     key compatibility key
+   @returns Concatenated string
+*/
+std::string LFGQueue::GetCompatibilityKeyString(LfgCompatibilityKey const& key) const
+{
+    if (!key.IsValid())
+        return "";
+
+    std::ostringstream o;
+    for (uint8 i = 0; i < key.size; ++i)
+    {
+        if (i)
+            o << '|';
+        o << slotStore[key.slots[i]].GetRawValue();
+    }
+
+    return o.str();
+}
+
+void LFGQueue::AssignSlot(LfgQueueData& queueData, ObjectGuid guid)
+{
+    if (!freeSlotStore.empty())
+    {
+        queueData.slot = freeSlotStore.back();
+        freeSlotStore.pop_back();
+        slotStore[queueData.slot] = guid;
+    }
+    else
+    {
+        queueData.slot = slotStore.size();
+        slotStore.push_back(guid);
+    }
+}
+
+void LFGQueue::ReleaseSlot(LfgQueueData& queueData)
+{
+    if (queueData.slot == LfgCompatibilityKey::INVALID_SLOT)
+        return;
+
+    slotStore[queueData.slot].Clear();
+    freeSlotStore.push_back(queueData.slot);
+    queueData.slot = LfgCompatibilityKey::INVALID_SLOT;
+}
+
 std::string LFGQueue::GetDetailedMatchRoles(GuidList const& check) const
 {
     if (check.empty())
@@ -141,27 +189,7 @@ void LFGQueue::RemoveFromQueue(ObjectGuid guid)
 {
     RemoveFromNewQueue(guid);
     RemoveFromCurrentQueue(guid);
-    RemoveFromCompatibles(guid);
-
-    std::ostringstream o;
-    o << guid.GetRawValue();
-    std::string sguid = o.str();
-
-    LfgQueueDataContainer::iterator itDelete = QueueDataStore.end();
-    for (LfgQueueDataContainer::iterator itr = QueueDataStore.begin(); itr != QueueDataStore.end(); ++itr)
-        if (itr->first != guid)
-        {
-            if (std::string::npos != itr->second.bestCompatible.find(sguid))
-            {
-                itr->second.bestCompatible.clear();
-                FindBestCompatibleInQueue(itr);
-            }
-        }
-        else
-            itDelete = itr;
-
-    if (itDelete != QueueDataStore.end())
-        QueueDataStore.erase(itDelete);
+    RemoveQueueData(guid);
 }
 
 void LFGQueue::AddToNewQueue(ObjectGuid guid)
@@ -191,15 +219,40 @@ void LFGQueue::RemoveFromCurrentQueue(ObjectGuid guid)
 
 void LFGQueue::AddQueueData(ObjectGuid guid, time_t joinTime, LfgDungeonSet const& dungeons, LfgRolesMap const& rolesMap)
 {
-    QueueDataStore[guid] = LfgQueueData(joinTime, dungeons, rolesMap);
+    LfgQueueData& queueData = QueueDataStore[guid];
+    uint32 slot = queueData.slot;
+    queueData = LfgQueueData(joinTime, dungeons, rolesMap);
+    if (slot != LfgCompatibilityKey::INVALID_SLOT)
+        queueData.slot = slot;
+    else
+        AssignSlot(queueData, guid);
+
     AddToQueue(guid);
 }
 
 void LFGQueue::RemoveQueueData(ObjectGuid guid)
 {
-    LfgQueueDataContainer::iterator it = QueueDataStore.find(guid);
-    if (it != QueueDataStore.end())
-        QueueDataStore.erase(it);
+    LfgQueueDataContainer::iterator itDelete = QueueDataStore.find(guid);
+    if (itDelete == QueueDataStore.end())
+        return;
+
+    RemoveFromCompatibles(guid);
+
+    uint32 slot = itDelete->second.slot;
+    if (slot != LfgCompatibilityKey::INVALID_SLOT)
+    {
+        for (LfgQueueDataContainer::iterator itr = QueueDataStore.begin(); itr != QueueDataStore.end(); ++itr)
+        {
+            if (itr != itDelete && itr->second.bestCompatible.Contains(slot))
+            {
+                itr->second.bestCompatible.Clear();
+                FindBestCompatibleInQueue(itr);
+            }
+        }
+    }
+
+    ReleaseSlot(itDelete->second);
+    QueueDataStore.erase(itDelete);
 }
 
 void LFGQueue::UpdateWaitTimeAvg(int32 waitTime, uint32 dungeonId)
@@ -237,58 +290,57 @@ void LFGQueue::UpdateWaitTimeDps(int32 waitTime, uint32 dungeonId)
 */
 void LFGQueue::RemoveFromCompatibles(ObjectGuid guid)
 {
-    std::stringstream out;
-    out << guid.GetRawValue();
-    std::string strGuid = out.str();
+    LfgQueueDataContainer::const_iterator itQueue = QueueDataStore.find(guid);
+    if (itQueue == QueueDataStore.end())
+        return;
 
     TC_LOG_DEBUG("lfg.queue.data.compatibles.remove", "Removing %s", guid.ToString().c_str());
-    for (LfgCompatibleContainer::iterator itNext = CompatibleMapStore.begin(); itNext != CompatibleMapStore.end();)
-    {
-        LfgCompatibleContainer::iterator it = itNext++;
-        if (std::string::npos != it->first.find(strGuid))
-            CompatibleMapStore.erase(it);
-    }
+    CompatibleMapStore.RemoveSlot(itQueue->second.slot);
 }
 
 /**
    Stores the compatibility of a list of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Compatibility key of the guids
    @param[in]     compatibles type of compatibility
 */
-void LFGQueue::SetCompatibles(std::string const& key, LfgCompatibility compatibles)
+void LFGQueue::SetCompatibles(LfgCompatibilityKey const& key, LfgCompatibility compatibles)
 {
-    LfgCompatibilityData& data = CompatibleMapStore[key];
+    if (!key.IsValid())
+        return;
+
+    LfgCompatibilityData& data = CompatibleMapStore.Get(key);
     data.compatibility = compatibles;
 }
 
-void LFGQueue::SetCompatibilityData(std::string const& key, LfgCompatibilityData const& data)
+void LFGQueue::SetCompatibilityData(LfgCompatibilityKey const& key, LfgCompatibilityData const& data)
 {
-    CompatibleMapStore[key] = data;
+    if (!key.IsValid())
+        return;
+
+    CompatibleMapStore.Get(key) = data;
 }
 
 /**
    Get the compatibility of a group of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Compatibility key of the guids
    @return LfgCompatibility type of compatibility
 */
-LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
+LfgCompatibility LFGQueue::GetCompatibles(LfgCompatibilityKey const& key)
 {
-    LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
-    if (itr != CompatibleMapStore.end())
-        return itr->second.compatibility;
+    if (LfgCompatibilityData const* data = GetCompatibilityData(key))
+        return data->compatibility;
 
     return LFG_COMPATIBILITY_PENDING;
 }
 
-LfgCompatibilityData* LFGQueue::GetCompatibilityData(std::string const& key)
+LfgCompatibilityData* LFGQueue::GetCompatibilityData(LfgCompatibilityKey const& key)
 {
-    LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
-    if (itr != CompatibleMapStore.end())
-        return &(itr->second);
+    if (!key.IsValid())
+        return nullptr;
 
-    return nullptr;
+    return CompatibleMapStore.Find(key);
 }
 
 uint8 LFGQueue::FindGroups()
@@ -305,8 +357,9 @@ uint8 LFGQueue::FindGroups()
         firstNew.push_back(frontguid);
         RemoveFromNewQueue(frontguid);
 
-        GuidList temporalList = currentQueueStore;
-        LfgCompatibility compatibles = FindNewGroups(firstNew, temporalList);
+        matchCandidates.assign(currentQueueStore.begin(), currentQueueStore.end());
+        std::size_t nextCandidate = 0;
+        LfgCompatibility compatibles = FindNewGroups(firstNew, matchCandidates, nextCandidate);
 
         if (compatibles == LFG_COMPATIBLES_MATCH)
             ++proposals;
@@ -321,21 +374,22 @@ uint8 LFGQueue::FindGroups()
 
    @param[in]     check List of guids trying to match with other groups
    @param[in]     all List of all other guids in main queue to match against
+   @param[in,out] next Index of the first guid of all not tried yet
    @return LfgCompatibility type of compatibility between groups
 */
-LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
+LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidVector const& all, std::size_t& next)
 {
-    std::string strGuids = ConcatenateGuids(check);
-    LfgCompatibility compatibles = GetCompatibles(strGuids);
+    LfgCompatibilityKey key = GetCompatibilityKey(check);
+    LfgCompatibility compatibles = GetCompatibles(key);
 
-    TC_LOG_DEBUG("lfg.queue.match.check", "Guids: (%s): %s - all(%s)", GetDetailedMatchRoles(check).c_str(), GetCompatibleString(compatibles), GetDetailedMatchRoles(all).c_str());
+    TC_LOG_DEBUG("lfg.queue.match.check", "Guids: (%s): %s - all(%s)", GetDetailedMatchRoles(check).c_str(), GetCompatibleString(compatibles), GetDetailedMatchRoles(GuidList(all.begin() + next, all.end())).c_str());
     if (compatibles == LFG_COMPATIBILITY_PENDING) // Not previously cached, calculate
         compatibles = CheckCompatibility(check);
 
     if (compatibles == LFG_COMPATIBLES_BAD_STATES && sLFGMgr->AllQueued(check))
     {
         TC_LOG_DEBUG("lfg.queue.match.check", "Guids: (%s) compatibles (cached) changed from bad states to match", GetDetailedMatchRoles(check).c_str());
-        SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+        SetCompatibles(key, LFG_COMPATIBLES_MATCH);
         return LFG_COMPATIBLES_MATCH;
     }
 
@@ -343,11 +397,10 @@ LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
         return compatibles;
 
     // Try to match with queued groups
-    while (!all.empty())
+    while (next < all.size())
     {
-        check.push_back(all.front());
-        all.pop_front();
-        LfgCompatibility subcompatibility = FindNewGroups(check, all);
+        check.push_back(all[next++]);
+        LfgCompatibility subcompatibility = FindNewGroups(check, all, next);
         if (subcompatibility == LFG_COMPATIBLES_MATCH)
             return LFG_COMPATIBLES_MATCH;
         check.pop_back();
@@ -363,7 +416,7 @@ LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
 */
 LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
 {
-    std::string strGuids = ConcatenateGuids(check);
+    LfgCompatibilityKey key = GetCompatibilityKey(check);
     LfgProposal proposal;
     LfgDungeonSet proposalDungeons;
     LfgGroupsMap proposalGroups;
@@ -386,8 +439,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         LfgCompatibility child_compatibles = CheckCompatibility(check);
         if (child_compatibles < LFG_COMPATIBLES_WITH_LESS_PLAYERS) // Group not compatible
         {
-            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) child %s not compatibles", strGuids.c_str(), GetDetailedMatchRoles(check).c_str());
-            SetCompatibles(strGuids, child_compatibles);
+            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) child %s not compatibles", GetCompatibilityKeyString(key).c_str(), GetDetailedMatchRoles(check).c_str());
+            SetCompatibles(key, child_compatibles);
             return child_compatibles;
         }
         check.push_front(frontGuid);
@@ -431,22 +484,22 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         data.roles = itQueue->second.roles;
         LFGMgr::CheckGroupRoles(data.roles);
 
-        UpdateBestCompatibleInQueue(itQueue, strGuids, data.roles);
-        SetCompatibilityData(strGuids, data);
+        UpdateBestCompatibleInQueue(itQueue, key, data.roles);
+        SetCompatibilityData(key, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
     if (numLfgGroups > 1)
     {
         TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) More than one Lfggroup (%u)", GetDetailedMatchRoles(check).c_str(), numLfgGroups);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
+        SetCompatibles(key, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
         return LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS;
     }
 
     if (numPlayers > MAXGROUPSIZE)
     {
         TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) Too many players (%u)", GetDetailedMatchRoles(check).c_str(), numPlayers);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
+        SetCompatibles(key, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
         return LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS;
     }
 
@@ -474,7 +527,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         if (uint8 playersize = numPlayers - proposalRoles.size())
         {
             TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) not compatible, %u players are ignoring each other", GetDetailedMatchRoles(check).c_str(), playersize);
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_HAS_IGNORES);
+            SetCompatibles(key, LFG_INCOMPATIBLES_HAS_IGNORES);
             return LFG_INCOMPATIBLES_HAS_IGNORES;
         }
 
@@ -486,7 +539,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
                 o << ", " << it->first.GetRawValue() << ": " << GetRolesString(it->second);
 
             TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) Roles not compatible%s", GetDetailedMatchRoles(check).c_str(), o.str().c_str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_ROLES);
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_ROLES);
             return LFG_INCOMPATIBLES_NO_ROLES;
         }
 
@@ -506,7 +559,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         if (proposalDungeons.empty())
         {
             TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) No compatible dungeons%s", GetDetailedMatchRoles(check).c_str(), o.str().c_str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_DUNGEONS);
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_DUNGEONS);
             return LFG_INCOMPATIBLES_NO_DUNGEONS;
         }
     }
@@ -527,9 +580,9 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         data.roles = proposalRoles;
 
         for (GuidList::const_iterator itr = check.begin(); itr != check.end(); ++itr)
-            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), strGuids, data.roles);
+            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), key, data.roles);
 
-        SetCompatibilityData(strGuids, data);
+        SetCompatibilityData(key, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
@@ -540,7 +593,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
     if (!sLFGMgr->AllQueued(check))
     {
         TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) Group MATCH but can't create proposal!", GetDetailedMatchRoles(check).c_str());
-        SetCompatibles(strGuids, LFG_COMPATIBLES_BAD_STATES);
+        SetCompatibles(key, LFG_COMPATIBLES_BAD_STATES);
         return LFG_COMPATIBLES_BAD_STATES;
     }
 
@@ -582,7 +635,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
     sLFGMgr->AddProposal(proposal);
 
     TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) MATCH! Group formed", GetDetailedMatchRoles(check).c_str());
-    SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+    SetCompatibles(key, LFG_COMPATIBLES_MATCH);
     return LFG_COMPATIBLES_MATCH;
 }
 
@@ -624,7 +677,7 @@ void LFGQueue::UpdateQueueTimers(time_t currTime)
                 break;
         }
 
-        if (queueinfo.bestCompatible.empty())
+        if (!queueinfo.bestCompatible.IsValid())
             FindBestCompatibleInQueue(itQueue);
 
         LfgQueueStatusData queueData(dungeonId, waitTime, wtAvg, wtTank, wtHealer, wtDps, queuedTime, queueinfo.tanks, queueinfo.healers, queueinfo.dps);
@@ -670,11 +723,11 @@ std::string LFGQueue::DumpQueueInfo() const
 std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
 {
     std::ostringstream o;
-    o << "Compatible Map size: " << CompatibleMapStore.size() << "\n";
+    o << "Compatible Map size: " << CompatibleMapStore.GetSize() << "\n";
     if (full)
-        for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
+        for (LfgCompatibilityCache::Container::const_iterator itr = CompatibleMapStore.GetStore().begin(); itr != CompatibleMapStore.GetStore().end(); ++itr)
         {
-            o << "(" << itr->first << "): " << GetCompatibleString(itr->second.compatibility);
+            o << "(" << GetCompatibilityKeyString(itr->first) << "): " << GetCompatibleString(itr->second.compatibility);
             if (!itr->second.roles.empty())
             {
                 o << " (";
@@ -697,32 +750,26 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
 void LFGQueue::FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue)
 {
     TC_LOG_DEBUG("lfg.queue.compatibles.find", "%s", itrQueue->first.ToString().c_str());
-    std::ostringstream o;
-    o << itrQueue->first.GetRawValue();
-    std::string sguid = o.str();
 
-    for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
-        if (itr->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS &&
-            std::string::npos != itr->first.find(sguid))
-        {
-            UpdateBestCompatibleInQueue(itrQueue, itr->first, itr->second.roles);
-        }
+    CompatibleMapStore.VisitSlot(itrQueue->second.slot, [&](LfgCompatibilityKey const& key, LfgCompatibilityData const& data)
+    {
+        if (data.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS)
+            UpdateBestCompatibleInQueue(itrQueue, key, data.roles);
+    });
 }
 
-void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles)
+void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibilityKey const& key, LfgRolesMap const& roles)
 {
     LfgQueueData& queueData = itrQueue->second;
 
-    uint8 storedSize = queueData.bestCompatible.empty() ? 0 :
-        std::count(queueData.bestCompatible.begin(), queueData.bestCompatible.end(), '|') + 1;
-
-    uint8 size = std::count(key.begin(), key.end(), '|') + 1;
+    uint8 storedSize = queueData.bestCompatible.IsValid() ? queueData.bestCompatible.size : 0;
+    uint8 size = key.IsValid() ? key.size : 0;
 
     if (size <= storedSize)
         return;
 
     TC_LOG_DEBUG("lfg.queue.compatibles.update", "Changed (%s) to (%s) as best compatible group for %s",
-        queueData.bestCompatible.c_str(), key.c_str(), itrQueue->first.ToString().c_str());
+        GetCompatibilityKeyString(queueData.bestCompatible).c_str(), GetCompatibilityKeyString(key).c_str(), itrQueue->first.ToString().c_str());
 
     queueData.bestCompatible = key;
     queueData.tanks = LFG_TANKS_NEEDED;
@@ -18,36 +18,11 @@
 #ifndef _LFGQUEUE_H
 #define _LFGQUEUE_H
 
-#include "LFG.h"
+#include "LFGCompatibilityCache.h"
 
 namespace lfg
 {
 
-enum LfgCompatibility
-{
-    LFG_COMPATIBILITY_PENDING,
-    LFG_INCOMPATIBLES_WRONG_GROUP_SIZE,
-    LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS,
-    LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS,
-    LFG_INCOMPATIBLES_HAS_IGNORES,
-    LFG_INCOMPATIBLES_NO_ROLES,
-    LFG_INCOMPATIBLES_NO_DUNGEONS,
-    LFG_COMPATIBLES_WITH_LESS_PLAYERS,                     // Values under this = not compatible (do not modify order)
-    LFG_COMPATIBLES_BAD_STATES,
-    LFG_COMPATIBLES_MATCH                                  // Must be the last one
-};
-
-struct LfgCompatibilityData
-{
-    LfgCompatibilityData(): compatibility(LFG_COMPATIBILITY_PENDING) { }
-    LfgCompatibilityData(LfgCompatibility _compatibility): compatibility(_compatibility) { }
-    LfgCompatibilityData(LfgCompatibility _compatibility, LfgRolesMap const& _roles):
-        compatibility(_compatibility), roles(_roles) { }
-
-    LfgCompatibility compatibility;
-    LfgRolesMap roles;
-};
-
 /// Stores player or group queue info
 struct LfgQueueData
 {
@@ -55,7 +30,7 @@ struct LfgQueueData
 
     LfgQueueData(time_t _joinTime, LfgDungeonSet const& _dungeons, LfgRolesMap const& _roles):
         joinTime(_joinTime), tanks(LFG_TANKS_NEEDED), healers(LFG_HEALERS_NEEDED),
-        dps(LFG_DPS_NEEDED), dungeons(_dungeons), roles(_roles)
+        dps(LFG_DPS_NEEDED), dungeons(_dungeons), roles(_roles), slot(LfgCompatibilityKey::INVALID_SLOT)
         { }
 
     time_t joinTime;                                       ///< Player queue join time (to calculate wait times)
@@ -64,7 +39,8 @@ struct LfgQueueData
     uint8 dps;                                             ///< Dps needed
     LfgDungeonSet dungeons;                                ///< Selected Player/Group Dungeon/s
     LfgRolesMap roles;                                     ///< Selected Player Role/s
-    std::string bestCompatible;                            ///< Best compatible combination of people queued
+    LfgCompatibilityKey bestCompatible;                    ///< Best compatible combination of people queued
+    uint32 slot;                                           ///< Compact id used in compatibility keys
 };
 
 struct LfgWaitTime
@@ -75,7 +51,6 @@ struct LfgWaitTime
 };
 
 typedef std::map<uint32, LfgWaitTime> LfgWaitTimesContainer;
-typedef std::map<std::string, LfgCompatibilityData> LfgCompatibleContainer;
 typedef std::map<ObjectGuid, LfgQueueData> LfgQueueDataContainer;
 
 /**
@@ -110,7 +85,10 @@ class TC_GAME_API LFGQueue
         std::string DumpCompatibleInfo(bool full = false) const;
 
     private:
-        void SetQueueUpdateData(std::string const& strGuids, LfgRolesMap const& proposalRoles);
+        LfgCompatibilityKey GetCompatibilityKey(GuidList const& check) const;
+        std::string GetCompatibilityKeyString(LfgCompatibilityKey const& key) const;
+        void AssignSlot(LfgQueueData& queueData, ObjectGuid guid);
+        void ReleaseSlot(LfgQueueData& queueData);
 
         void AddToNewQueue(ObjectGuid guid);
         void AddToCurrentQueue(ObjectGuid guid);
@@ -118,21 +96,23 @@ class TC_GAME_API LFGQueue
         void RemoveFromNewQueue(ObjectGuid guid);
         void RemoveFromCurrentQueue(ObjectGuid guid);
 
-        void SetCompatibles(std::string const& key, LfgCompatibility compatibles);
-        LfgCompatibility GetCompatibles(std::string const& key);
+        void SetCompatibles(LfgCompatibilityKey const& key, LfgCompatibility compatibles);
+        LfgCompatibility GetCompatibles(LfgCompatibilityKey const& key);
         void RemoveFromCompatibles(ObjectGuid guid);
 
-        void SetCompatibilityData(std::string const& key, LfgCompatibilityData const& compatibles);
-        LfgCompatibilityData* GetCompatibilityData(std::string const& key);
+        void SetCompatibilityData(LfgCompatibilityKey const& key, LfgCompatibilityData const& compatibles);
+        LfgCompatibilityData* GetCompatibilityData(LfgCompatibilityKey const& key);
         void FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue);
-        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles);
+        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibilityKey const& key, LfgRolesMap const& roles);
 
-        LfgCompatibility FindNewGroups(GuidList& check, GuidList& all);
+        LfgCompatibility FindNewGroups(GuidList& check, GuidVector const& all, std::size_t& next);
         LfgCompatibility CheckCompatibility(GuidList check);
 
         // Queue
         LfgQueueDataContainer QueueDataStore;              ///< Queued groups
-        LfgCompatibleContainer CompatibleMapStore;         ///< Compatible dungeons
+        LfgCompatibilityCache CompatibleMapStore;          ///< Compatible dungeons
+        GuidVector slotStore;                              ///< Queued guid of each slot
+        std::vector<uint32> freeSlotStore;                 ///< Released slots, reused before growing slotStore
 
         LfgWaitTimesContainer waitTimesAvgStore;           ///< Average wait time to find a group queuing as multiple roles
         LfgWaitTimesContainer waitTimesTankStore;          ///< Average wait time to find a group queuing as tank
@@ -140,6 +120,7 @@ class TC_GAME_API LFGQueue
         LfgWaitTimesContainer waitTimesDpsStore;           ///< Average wait time to find a group queuing as dps
         GuidList currentQueueStore;                        ///< Ordered list. Used to find groups
         GuidList newToQueueStore;                          ///< New groups to add to queue
+        GuidVector matchCandidates;                        ///< Copy of currentQueueStore used by FindGroups
 };
 
 } // namespace lfg
@@ -1800,6 +1800,48 @@ void WorldObject::SendMessageToSet(WorldPacket const* data, Player const* skippe
     Cell::VisitWorldObjects(this, notifier, GetVisibilityRange());
 }
 
+void WorldObject::SendCombatLogMessage(bool(*build)(void const* builder, WorldPacket* data), void const* builder, std::vector<Player*>* receivers /*= nullptr*/) const
+{
+    if (!IsInWorld())
+        return;
+
+    CombatLogStats& stats = GetMap()->GetCombatLogStats();
+    WorldPacket data;
+
+    // players always see their own combat log
+    if (GetTypeId() == TYPEID_PLAYER)
+    {
+        if (build(builder, &data))
+        {
+            ++stats.Built;
+            if (receivers)
+            {
+                ToPlayer()->SendDirectMessage(&data);
+                Trinity::MessageDistDeliverer notifier(this, &data, GetVisibilityRange(), *receivers);
+                Cell::VisitWorldObjects(this, notifier, GetVisibilityRange());
+            }
+            else
+                SendMessageToSet(&data, true);
+        }
+        return;
+    }
+
+    // far sight viewers are on the map too, no player means no receiver
+    if (!GetMap()->HavePlayers())
+    {
+        ++stats.Skipped;
+        return;
+    }
+
+    Trinity::MessageDistDeliverer notifier(this, &data, build, builder, GetVisibilityRange(), receivers);
+    Cell::VisitWorldObjects(this, notifier, GetVisibilityRange());
+
+    if (notifier.IsMessageBuilt())
+        ++stats.Built;
+    else
+        ++stats.Skipped;
+}
+
 void WorldObject::SendObjectDeSpawnAnim(ObjectGuid guid)
 {
     WorldPacket data(SMSG_GAMEOBJECT_DESPAWN_ANIM, 8);
@@ -2591,16 +2633,20 @@ SpellMissInfo WorldObject::SpellHitResult(Unit* victim, SpellInfo const* spellIn
 
 void WorldObject::SendSpellMiss(Unit* target, uint32 spellID, SpellMissInfo missInfo)
 {
-    WorldPacket data(SMSG_SPELLLOGMISS, (4 + 8 + 1 + 4 + 8 + 1));
-    data << uint32(spellID);
-    data << uint64(GetGUID());
-    data << uint8(0);                                       // can be 0 or 1
-    data << uint32(1);                                      // target count
-    // for (i = 0; i < target count; ++i)
-    data << uint64(target->GetGUID());                      // target GUID
-    data << uint8(missInfo);
-    // end loop
-    SendMessageToSet(&data, true);
+    SendCombatLogMessage([&](WorldPacket* packet)
+    {
+        WorldPacket& data = *packet;
+        data.Initialize(SMSG_SPELLLOGMISS, (4 + 8 + 1 + 4 + 8 + 1));
+        data << uint32(spellID);
+        data << uint64(GetGUID());
+        data << uint8(0);                                   // can be 0 or 1
+        data << uint32(1);                                  // target count
+        // for (i = 0; i < target count; ++i)
+        data << uint64(target->GetGUID());                  // target GUID
+        data << uint8(missInfo);
+        // end loop
+        return true;
+    });
 }
 
 FactionTemplateEntry const* WorldObject::GetFactionTemplateEntry() const
@@ -354,6 +354,16 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         virtual void SendMessageToSet(WorldPacket const* data, bool self) const;
         virtual void SendMessageToSetInRange(WorldPacket const* data, float dist, bool self) const;
         virtual void SendMessageToSet(WorldPacket const* data, Player const* skipped_rcvr) const;
+        // combat log broadcast, the packet is only built once a receiver is found - builder returns false if there is nothing to send.
+        // receivers (optional) collects the players the packet was sent to, except self
+        template<typename Builder>
+        void SendCombatLogMessage(Builder const& builder, std::vector<Player*>* receivers = nullptr) const
+        {
+            SendCombatLogMessage([](void const* context, WorldPacket* data) -> bool { return (*static_cast<Builder const*>(context))(data); }, &builder, receivers);
+        }
+
+        // non owning reference to the builder, it is only called while SendCombatLogMessage runs
+        void SendCombatLogMessage(bool(*build)(void const* builder, WorldPacket* data), void const* builder, std::vector<Player*>* receivers = nullptr) const;
 
         virtual uint8 GetLevelForTarget(WorldObject const* /*target*/) const { return 1; }
 
@@ -65,6 +65,7 @@
 #include "Mail.h"
 #include "MailPackets.h"
 #include "MapManager.h"
+#include "Metric.h"
 #include "MiscPackets.h"
 #include "MotionMaster.h"
 #include "ObjectAccessor.h"
@@ -373,6 +374,7 @@ Player::Player(WorldSession* session): Unit(true)
 
     m_grantableLevels = 0;
     m_fishingSteps = 0;
+    m_savedGlyphsSpecsCount = 0;
 
     m_ControlledByPlayer = true;
 
@@ -6395,6 +6397,11 @@ void Player::SendDirectMessage(WorldPacket const* data) const
     m_session->SendPacket(data);
 }
 
+void Player::SendDirectMessage(std::shared_ptr<WorldPacket const> const& data) const
+{
+    m_session->SendPacket(data);
+}
+
 void Player::SendCinematicStart(uint32 CinematicSequenceId) const
 {
     WorldPackets::Misc::TriggerCinematic packet;
@@ -19320,10 +19327,7 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create /* = false
 
     CharacterDatabasePreparedStatement* stmt = nullptr;
     uint8 index = 0;
-
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_FISHINGSTEPS);
-    stmt->setUInt32(0, GetGUID().GetCounter());
-    trans->Append(stmt);
+    std::size_t const statementsBefore = trans->GetSize();
 
     auto finiteAlways = [](float f) { return std::isfinite(f) ? f : 0.0f; };
 
@@ -19572,14 +19576,7 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create /* = false
 
     trans->Append(stmt);
 
-    if (m_fishingSteps != 0)
-    {
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_FISHINGSTEPS);
-        index = 0;
-        stmt->setUInt32(index++, GetGUID().GetCounter());
-        stmt->setUInt32(index++, m_fishingSteps);
-        trans->Append(stmt);
-    }
+    _SaveFishingSteps(trans);
 
     if (m_mailsUpdated)                                     //save mails only when needed
         _SaveMail(trans);
@@ -19609,11 +19606,33 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create /* = false
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
         _SaveStats(trans);
 
+    TC_METRIC_VALUE("player_save_statements", uint64(trans->GetSize() - statementsBefore));
+
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
         pet->SavePetToDB(PET_SAVE_AS_CURRENT);
 }
 
+void Player::_SaveFishingSteps(CharacterDatabaseTransaction trans)
+{
+    if (m_savedFishingSteps == m_fishingSteps)
+        return;
+
+    m_savedFishingSteps = m_fishingSteps;
+
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_FISHINGSTEPS);
+    stmt->setUInt32(0, GetGUID().GetCounter());
+    trans->Append(stmt);
+
+    if (m_fishingSteps != 0)
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_FISHINGSTEPS);
+        stmt->setUInt32(0, GetGUID().GetCounter());
+        stmt->setUInt32(1, m_fishingSteps);
+        trans->Append(stmt);
+    }
+}
+
 // fast save function for item/money cheating preventing - save only inventory and money state
 void Player::SaveInventoryAndGoldToDB(CharacterDatabaseTransaction trans)
 {
@@ -19679,10 +19698,21 @@ void Player::_SaveActions(CharacterDatabaseTransaction trans)
 
 void Player::_SaveAuras(CharacterDatabaseTransaction trans)
 {
-    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
-    stmt->setUInt32(0, GetGUID().GetCounter());
-    trans->Append(stmt);
+    CharacterDatabasePreparedStatement* stmt;
 
+    // The first save of the session rewrites all rows, this also drops rows of auras that could not be loaded.
+    // Later saves only write the auras that were added, changed or removed since then.
+    SavedAuraMap previousAuras;
+    if (m_savedAuras)
+        previousAuras = std::move(*m_savedAuras);
+    else
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
+        stmt->setUInt32(0, GetGUID().GetCounter());
+        trans->Append(stmt);
+    }
+
+    SavedAuraMap& savedAuras = m_savedAuras.emplace();
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
         if (!itr->second->CanBeSaved())
@@ -19690,47 +19720,78 @@ void Player::_SaveAuras(CharacterDatabaseTransaction trans)
 
         Aura* aura = itr->second;
 
-        int32 damage[MAX_SPELL_EFFECTS];
-        int32 baseDamage[MAX_SPELL_EFFECTS];
-        uint8 effMask = 0;
-        uint8 recalculateMask = 0;
+        SavedAuraKey key;
+        key.CasterGuid = aura->GetCasterGUID();
+        key.ItemGuid = aura->GetCastItemGUID();
+        key.SpellId = aura->GetId();
+        key.EffectMask = 0;
+
+        SavedAuraData data;
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
             if (AuraEffect const* effect = aura->GetEffect(i))
             {
-                baseDamage[i] = effect->GetBaseAmount();
-                damage[i] = effect->GetAmount();
-                effMask |= 1 << i;
+                data.BaseAmount[i] = effect->GetBaseAmount();
+                data.Amount[i] = effect->GetAmount();
+                key.EffectMask |= 1 << i;
                 if (effect->CanBeRecalculated())
-                    recalculateMask |= 1 << i;
-            }
-            else
-            {
-                baseDamage[i] = 0;
-                damage[i] = 0;
+                    data.RecalculateMask |= 1 << i;
             }
         }
 
+        data.StackAmount = aura->GetStackAmount();
+        data.MaxDuration = aura->GetMaxDuration();
+        data.Duration = aura->GetDuration();
+        data.Charges = aura->GetCharges();
+        data.CritChance = aura->GetCritChance();
+        data.ApplyResilience = aura->CanApplyResilience();
+
+        // reuse the map node of the previous save, the snapshot is rebuilt without allocations for known auras
+        SavedAuraMap::iterator previous = previousAuras.find(key);
+        if (previous != previousAuras.end())
+        {
+            SavedAuraMap::node_type node = previousAuras.extract(previous);
+            bool const changed = node.mapped() != data;
+            node.mapped() = data;
+            savedAuras.insert(std::move(node));
+            if (!changed)
+                continue;
+        }
+        else
+            savedAuras.emplace(key, data);
+
         uint8 index = 0;
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_AURA);
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_AURA);
         stmt->setUInt32(index++, GetGUID().GetCounter());
-        stmt->setUInt64(index++, itr->second->GetCasterGUID().GetRawValue());
-        stmt->setUInt64(index++, itr->second->GetCastItemGUID().GetRawValue());
-        stmt->setUInt32(index++, itr->second->GetId());
-        stmt->setUInt8(index++, effMask);
-        stmt->setUInt8(index++, recalculateMask);
-        stmt->setUInt8(index++, itr->second->GetStackAmount());
-        stmt->setInt32(index++, damage[0]);
-        stmt->setInt32(index++, damage[1]);
-        stmt->setInt32(index++, damage[2]);
-        stmt->setInt32(index++, baseDamage[0]);
-        stmt->setInt32(index++, baseDamage[1]);
-        stmt->setInt32(index++, baseDamage[2]);
-        stmt->setInt32(index++, itr->second->GetMaxDuration());
-        stmt->setInt32(index++, itr->second->GetDuration());
-        stmt->setUInt8(index++, itr->second->GetCharges());
-        stmt->setFloat(index++, itr->second->GetCritChance());
-        stmt->setBool (index++, itr->second->CanApplyResilience());
+        stmt->setUInt64(index++, key.CasterGuid.GetRawValue());
+        stmt->setUInt64(index++, key.ItemGuid.GetRawValue());
+        stmt->setUInt32(index++, key.SpellId);
+        stmt->setUInt8(index++, key.EffectMask);
+        stmt->setUInt8(index++, data.RecalculateMask);
+        stmt->setUInt8(index++, data.StackAmount);
+        stmt->setInt32(index++, data.Amount[0]);
+        stmt->setInt32(index++, data.Amount[1]);
+        stmt->setInt32(index++, data.Amount[2]);
+        stmt->setInt32(index++, data.BaseAmount[0]);
+        stmt->setInt32(index++, data.BaseAmount[1]);
+        stmt->setInt32(index++, data.BaseAmount[2]);
+        stmt->setInt32(index++, data.MaxDuration);
+        stmt->setInt32(index++, data.Duration);
+        stmt->setUInt8(index++, data.Charges);
+        stmt->setFloat(index++, data.CritChance);
+        stmt->setBool (index++, data.ApplyResilience);
+        trans->Append(stmt);
+    }
+
+    // whatever is left was removed since the last save
+    for (SavedAuraMap::value_type const& removed : previousAuras)
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA_BY_KEY);
+        stmt->setUInt32(0, GetGUID().GetCounter());
+        stmt->setUInt64(1, removed.first.CasterGuid.GetRawValue());
+        stmt->setUInt64(2, removed.first.ItemGuid.GetRawValue());
+        stmt->setUInt32(3, removed.first.SpellId);
+        stmt->setUInt8(4, removed.first.EffectMask);
         trans->Append(stmt);
     }
 }
@@ -25844,6 +25905,19 @@ void Player::_SaveEquipmentSets(CharacterDatabaseTransaction trans)
 
 void Player::_SaveBGData(CharacterDatabaseTransaction trans)
 {
+    SavedBGData data;
+    data.InstanceId = m_bgData.bgInstanceID;
+    data.Team = m_bgData.bgTeam;
+    data.JoinPos = m_bgData.joinPos;
+    data.TaxiPath[0] = m_bgData.taxiPath[0];
+    data.TaxiPath[1] = m_bgData.taxiPath[1];
+    data.MountSpell = m_bgData.mountSpell;
+
+    if (m_savedBGData == data)
+        return;
+
+    m_savedBGData = data;
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYER_BGDATA);
     stmt->setUInt32(0, GetGUID().GetCounter());
     trans->Append(stmt);
@@ -25936,8 +26010,19 @@ void Player::_LoadGlyphs(PreparedQueryResult result)
     while (result->NextRow());
 }
 
-void Player::_SaveGlyphs(CharacterDatabaseTransaction trans) const
+void Player::_SaveGlyphs(CharacterDatabaseTransaction trans)
 {
+    std::array<uint32, MAX_TALENT_SPECS * MAX_GLYPH_SLOT_INDEX> glyphs;
+    for (uint8 spec = 0; spec < MAX_TALENT_SPECS; ++spec)
+        for (uint8 i = 0; i < MAX_GLYPH_SLOT_INDEX; ++i)
+            glyphs[spec * MAX_GLYPH_SLOT_INDEX + i] = m_Glyphs[spec][i];
+
+    if (m_savedGlyphs == glyphs && m_savedGlyphsSpecsCount == m_specsCount)
+        return;
+
+    m_savedGlyphs = glyphs;
+    m_savedGlyphsSpecsCount = m_specsCount;
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_GLYPHS);
     stmt->setUInt32(0, GetGUID().GetCounter());
     trans->Append(stmt);
@@ -26573,9 +26658,11 @@ void Player::_LoadPetStable(uint8 petStableSlots, PreparedQueryResult result)
 
 void Player::_SaveInstanceTimeRestrictions(CharacterDatabaseTransaction trans)
 {
-    if (_instanceResetTimes.empty())
+    if (_instanceResetTimes.empty() || _savedInstanceResetTimes == _instanceResetTimes)
         return;
 
+    _savedInstanceResetTimes = _instanceResetTimes;
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ACCOUNT_INSTANCE_LOCK_TIMES);
     stmt->setUInt32(0, GetSession()->GetAccountId());
     trans->Append(stmt);
@@ -30,8 +30,10 @@
 #include "PetDefines.h"
 #include "PlayerTaxi.h"
 #include "QuestDef.h"
+#include <array>
 #include <memory>
 #include <queue>
+#include <tuple>
 #include <unordered_set>
 
 struct AccessRequirement;
@@ -857,6 +859,62 @@ struct BGData
     bool HasTaxiPath() const { return taxiPath[0] && taxiPath[1]; }
 };
 
+// Persisted part of BGData as it was written by the last Player::_SaveBGData
+struct SavedBGData
+{
+    uint32 InstanceId = 0;
+    uint32 Team = 0;
+    WorldLocation JoinPos;
+    uint32 TaxiPath[2] = { };
+    uint32 MountSpell = 0;
+
+    bool operator==(SavedBGData const& right) const
+    {
+        return InstanceId == right.InstanceId && Team == right.Team && JoinPos.GetMapId() == right.JoinPos.GetMapId()
+            && JoinPos.GetPositionX() == right.JoinPos.GetPositionX() && JoinPos.GetPositionY() == right.JoinPos.GetPositionY()
+            && JoinPos.GetPositionZ() == right.JoinPos.GetPositionZ() && JoinPos.GetOrientation() == right.JoinPos.GetOrientation()
+            && TaxiPath[0] == right.TaxiPath[0] && TaxiPath[1] == right.TaxiPath[1] && MountSpell == right.MountSpell;
+    }
+    bool operator!=(SavedBGData const& right) const { return !(*this == right); }
+};
+
+// Primary key of a character_aura row
+struct SavedAuraKey
+{
+    ObjectGuid CasterGuid;
+    ObjectGuid ItemGuid;
+    uint32 SpellId;
+    uint8 EffectMask;
+
+    bool operator<(SavedAuraKey const& right) const
+    {
+        return std::tie(CasterGuid, ItemGuid, SpellId, EffectMask) < std::tie(right.CasterGuid, right.ItemGuid, right.SpellId, right.EffectMask);
+    }
+};
+
+// Values of a character_aura row as they were written by the last Player::_SaveAuras
+struct SavedAuraData
+{
+    uint8 RecalculateMask = 0;
+    uint8 StackAmount = 0;
+    std::array<int32, MAX_SPELL_EFFECTS> Amount = { };
+    std::array<int32, MAX_SPELL_EFFECTS> BaseAmount = { };
+    int32 MaxDuration = 0;
+    int32 Duration = 0;
+    uint8 Charges = 0;
+    float CritChance = 0.0f;
+    bool ApplyResilience = false;
+
+    bool operator==(SavedAuraData const& right) const
+    {
+        return std::tie(RecalculateMask, StackAmount, Amount, BaseAmount, MaxDuration, Duration, Charges, CritChance, ApplyResilience)
+            == std::tie(right.RecalculateMask, right.StackAmount, right.Amount, right.BaseAmount, right.MaxDuration, right.Duration, right.Charges, right.CritChance, right.ApplyResilience);
+    }
+    bool operator!=(SavedAuraData const& right) const { return !(*this == right); }
+};
+
+typedef std::map<SavedAuraKey, SavedAuraData> SavedAuraMap;
+
 struct TradeStatusInfo
 {
     TradeStatusInfo() : Status(TRADE_STATUS_BUSY), TraderGuid(), Result(EQUIP_ERR_OK),
@@ -1895,6 +1953,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void SendInitWorldStates(uint32 zoneId, uint32 areaId);
         void SendUpdateWorldState(uint32 variable, uint32 value) const;
         void SendDirectMessage(WorldPacket const* data) const;
+        void SendDirectMessage(std::shared_ptr<WorldPacket const> const& data) const;
         void SendBGWeekendWorldStates() const;
         void SendBattlefieldWorldStates() const;
 
@@ -2276,10 +2335,19 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void _SaveSpells(CharacterDatabaseTransaction trans);
         void _SaveEquipmentSets(CharacterDatabaseTransaction trans);
         void _SaveBGData(CharacterDatabaseTransaction trans);
-        void _SaveGlyphs(CharacterDatabaseTransaction trans) const;
+        void _SaveGlyphs(CharacterDatabaseTransaction trans);
         void _SaveTalents(CharacterDatabaseTransaction trans);
         void _SaveStats(CharacterDatabaseTransaction trans) const;
         void _SaveInstanceTimeRestrictions(CharacterDatabaseTransaction trans);
+        void _SaveFishingSteps(CharacterDatabaseTransaction trans);
+
+        // State of the tables that are rewritten as a whole, as written by the last save.
+        // Empty until the first save of the session, which always writes everything.
+        Optional<SavedAuraMap> m_savedAuras;
+        Optional<SavedBGData> m_savedBGData;
+        Optional<std::array<uint32, MAX_TALENT_SPECS * MAX_GLYPH_SLOT_INDEX>> m_savedGlyphs;
+        uint8 m_savedGlyphsSpecsCount;
+        Optional<uint8> m_savedFishingSteps;
 
         /*********************************************************/
         /***              ENVIRONMENTAL SYSTEM                 ***/
@@ -2503,6 +2571,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         uint32 m_ChampioningFaction;
 
         InstanceTimeMap _instanceResetTimes;
+        Optional<InstanceTimeMap> _savedInstanceResetTimes;
         uint32 _pendingBindId;
         uint32 _pendingBindTimer;
 
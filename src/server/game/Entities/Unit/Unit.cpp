@@ -68,6 +68,7 @@
 #include "SpellMgr.h"
 #include "StringConvert.h"
 #include "TemporarySummon.h"
+#include "TickProfiler.h"
 #include "Transport.h"
 #include "Totem.h"
 #include "UnitAI.h"
@@ -297,7 +298,7 @@ bool DispelableAura::RollDispel() const
 Unit::Unit(bool isWorldObject) :
     WorldObject(isWorldObject), m_lastSanctuaryTime(0), LastCharmerGUID(), movespline(new Movement::MoveSpline()),
     m_ControlledByPlayer(false), m_AutoRepeatFirstCast(false), m_procDeep(0), m_transformSpell(0),
-    m_removedAurasCount(0), m_charmer(nullptr), m_charmed(nullptr),
+    m_removedAurasCount(0), m_procAuraIndexGeneration(sSpellMgr->GetSpellProcsGeneration()), m_charmer(nullptr), m_charmed(nullptr),
     i_motionMaster(new MotionMaster(this)), m_regenTimer(0), m_vehicle(nullptr), m_vehicleKit(nullptr),
     m_unitTypeMask(UNIT_MASK_NONE), m_Diminishing(), m_combatManager(this), m_threatManager(this),
     m_aiLocked(false), m_comboTarget(nullptr), m_comboPoints(0), m_spellHistory(new SpellHistory(this))
@@ -445,6 +446,10 @@ void Unit::Update(uint32 p_time)
 
     m_combatManager.Update(p_time);
 
+    // keeps an adaptive instance update rate at full speed, see Map::HasUpdateActivity
+    if (IsInCombat() || HasUnitState(UNIT_STATE_CASTING))
+        GetMap()->NoteUnitActivity();
+
     // not implemented before 3.0.2
     if (uint32 base_att = getAttackTimer(BASE_ATTACK))
         setAttackTimer(BASE_ATTACK, (p_time >= base_att ? 0 : base_att - p_time));
@@ -3329,6 +3334,9 @@ AuraApplication* Unit::_CreateAuraApplication(Aura* aura, uint8 effMask)
     AuraApplication * aurApp = new AuraApplication(this, caster, aura, effMask);
     m_appliedAuras.insert(AuraApplicationMap::value_type(aurId, aurApp));
 
+    if (SpellProcEntry const* procEntry = sSpellMgr->GetSpellProcEntry(aurId))
+        m_procAuraIndex.Insert(aurId, procEntry->ProcFlags, aurApp);
+
     if (aurSpellInfo->AuraInterruptFlags)
     {
         m_interruptableAuras.push_back(aurApp);
@@ -3423,6 +3431,7 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator& i, AuraRemoveMode removeMo
 
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
     m_appliedAuras.erase(i);
+    m_procAuraIndex.Remove(aurApp);
 
     if (aura->GetSpellInfo()->AuraInterruptFlags)
     {
@@ -3553,6 +3562,8 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
         m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+
+    m_auraModifierCache.Invalidate(aurEff->GetAuraType());
 }
 
 // All aura base removes should go through this function!
@@ -4700,13 +4711,14 @@ uint32 Unit::GetDoTsByCaster(ObjectGuid casterGUID) const
     return dots;
 }
 
-int32 Unit::GetTotalAuraModifier(AuraType auraType, std::function<bool(AuraEffect const*)> const& predicate) const
+template<typename Predicate>
+int32 Unit::CalculateTotalAuraModifier(AuraType auraType, Predicate const& predicate) const
 {
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auraType);
     if (mTotalAuraList.empty())
         return 0;
 
-    std::map<SpellGroup, int32> sameEffectSpellGroup;
+    SameEffectSpellGroupAmounts sameEffectSpellGroup;
     int32 modifier = 0;
 
     for (AuraEffect const* aurEff : mTotalAuraList)
@@ -4721,19 +4733,20 @@ int32 Unit::GetTotalAuraModifier(AuraType auraType, std::function<bool(AuraEffec
     }
 
     // Add the highest of the Same Effect Stack Rule SpellGroups to the accumulator
-    for (auto itr = sameEffectSpellGroup.begin(); itr != sameEffectSpellGroup.end(); ++itr)
-        modifier += itr->second;
+    for (auto const& groupAmount : sameEffectSpellGroup)
+        modifier += groupAmount.second;
 
     return modifier;
 }
 
-float Unit::GetTotalAuraMultiplier(AuraType auraType, std::function<bool(AuraEffect const*)> const& predicate) const
+template<typename Predicate>
+float Unit::CalculateTotalAuraMultiplier(AuraType auraType, Predicate const& predicate) const
 {
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auraType);
     if (mTotalAuraList.empty())
         return 1.0f;
 
-    std::map<SpellGroup, int32> sameEffectSpellGroup;
+    SameEffectSpellGroupAmounts sameEffectSpellGroup;
     float multiplier = 1.0f;
 
     for (AuraEffect const* aurEff : mTotalAuraList)
@@ -4747,14 +4760,16 @@ float Unit::GetTotalAuraMultiplier(AuraType auraType, std::function<bool(AuraEff
         }
     }
 
-    // Add the highest of the Same Effect Stack Rule SpellGroups to the multiplier
-    for (auto itr = sameEffectSpellGroup.begin(); itr != sameEffectSpellGroup.end(); ++itr)
-        AddPct(multiplier, itr->second);
+    // Add the highest of the Same Effect Stack Rule SpellGroups to the multiplier, in group order to keep the result stable
+    std::sort(sameEffectSpellGroup.begin(), sameEffectSpellGroup.end());
+    for (auto const& groupAmount : sameEffectSpellGroup)
+        AddPct(multiplier, groupAmount.second);
 
     return multiplier;
 }
 
-int32 Unit::GetMaxPositiveAuraModifier(AuraType auraType, std::function<bool(AuraEffect const*)> const& predicate) const
+template<typename Predicate>
+int32 Unit::CalculateMaxPositiveAuraModifier(AuraType auraType, Predicate const& predicate) const
 {
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auraType);
     if (mTotalAuraList.empty())
@@ -4770,7 +4785,8 @@ int32 Unit::GetMaxPositiveAuraModifier(AuraType auraType, std::function<bool(Aur
     return modifier;
 }
 
-int32 Unit::GetMaxNegativeAuraModifier(AuraType auraType, std::function<bool(AuraEffect const*)> const& predicate) const
+template<typename Predicate>
+int32 Unit::CalculateMaxNegativeAuraModifier(AuraType auraType, Predicate const& predicate) const
 {
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auraType);
     if (mTotalAuraList.empty())
@@ -4786,49 +4802,133 @@ int32 Unit::GetMaxNegativeAuraModifier(AuraType auraType, std::function<bool(Aur
     return modifier;
 }
 
+namespace
+{
+    struct AuraModifierFilterCheck
+    {
+        AuraModifierFilterCheck(AuraModifierFilter filter, int32 misc) : Filter(filter), Misc(misc) { }
+
+        bool operator()(AuraEffect const* aurEff) const
+        {
+            switch (Filter)
+            {
+                case AuraModifierFilter::MiscMask:
+                    return (uint32(aurEff->GetMiscValue()) & uint32(Misc)) != 0;
+                case AuraModifierFilter::MiscValue:
+                    return aurEff->GetMiscValue() == Misc;
+                default:
+                    return true;
+            }
+        }
+
+        AuraModifierFilter Filter;
+        int32 Misc;
+    };
+}
+
+int32 Unit::GetCachedAuraModifier(AuraType auraType, AuraModifierTotal total, AuraModifierFilter filter, int32 misc) const
+{
+    if (m_modAuras[auraType].empty())
+        return 0;
+
+    m_auraModifierCache.ValidateSpellGroups(sSpellMgr->GetSpellGroupsGeneration());
+
+    int32 modifier = 0;
+    if (m_auraModifierCache.GetModifier(auraType, total, filter, misc, modifier))
+        return modifier;
+
+    AuraModifierFilterCheck predicate(filter, misc);
+    switch (total)
+    {
+        case AuraModifierTotal::Modifier:
+            modifier = CalculateTotalAuraModifier(auraType, predicate);
+            break;
+        case AuraModifierTotal::MaxPositiveModifier:
+            modifier = CalculateMaxPositiveAuraModifier(auraType, predicate);
+            break;
+        case AuraModifierTotal::MaxNegativeModifier:
+            modifier = CalculateMaxNegativeAuraModifier(auraType, predicate);
+            break;
+        default:
+            ABORT_MSG("Unit::GetCachedAuraModifier called for a multiplier");
+    }
+
+    m_auraModifierCache.StoreModifier(auraType, total, filter, misc, modifier);
+    return modifier;
+}
+
+float Unit::GetCachedAuraMultiplier(AuraType auraType, AuraModifierFilter filter, int32 misc) const
+{
+    if (m_modAuras[auraType].empty())
+        return 1.0f;
+
+    m_auraModifierCache.ValidateSpellGroups(sSpellMgr->GetSpellGroupsGeneration());
+
+    float multiplier = 1.0f;
+    if (m_auraModifierCache.GetMultiplier(auraType, filter, misc, multiplier))
+        return multiplier;
+
+    multiplier = CalculateTotalAuraMultiplier(auraType, AuraModifierFilterCheck(filter, misc));
+    m_auraModifierCache.StoreMultiplier(auraType, filter, misc, multiplier);
+    return multiplier;
+}
+
+int32 Unit::GetTotalAuraModifier(AuraType auraType, std::function<bool(AuraEffect const*)> const& predicate) const
+{
+    return CalculateTotalAuraModifier(auraType, predicate);
+}
+
+float Unit::GetTotalAuraMultiplier(AuraType auraType, std::function<bool(AuraEffect const*)> const& predicate) const
+{
+    return CalculateTotalAuraMultiplier(auraType, predicate);
+}
+
+int32 Unit::GetMaxPositiveAuraModifier(AuraType auraType, std::function<bool(AuraEffect const*)> const& predicate) const
+{
+    return CalculateMaxPositiveAuraModifier(auraType, predicate);
+}
+
+int32 Unit::GetMaxNegativeAuraModifier(AuraType auraType, std::function<bool(AuraEffect const*)> const& predicate) const
+{
+    return CalculateMaxNegativeAuraModifier(auraType, predicate);
+}
+
 int32 Unit::GetTotalAuraModifier(AuraType auraType) const
 {
-    return GetTotalAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return GetCachedAuraModifier(auraType, AuraModifierTotal::Modifier, AuraModifierFilter::None, 0);
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auraType) const
 {
-    return GetTotalAuraMultiplier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return GetCachedAuraMultiplier(auraType, AuraModifierFilter::None, 0);
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auraType) const
 {
-    return GetMaxPositiveAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return GetCachedAuraModifier(auraType, AuraModifierTotal::MaxPositiveModifier, AuraModifierFilter::None, 0);
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auraType) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return GetCachedAuraModifier(auraType, AuraModifierTotal::MaxNegativeModifier, AuraModifierFilter::None, 0);
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetTotalAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
-    {
-        if ((aurEff->GetMiscValue() & miscMask) != 0)
-            return true;
-        return false;
-    });
+    return GetCachedAuraModifier(auraType, AuraModifierTotal::Modifier, AuraModifierFilter::MiscMask, int32(miscMask));
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetTotalAuraMultiplier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
-    {
-        if ((aurEff->GetMiscValue() & miscMask) != 0)
-            return true;
-        return false;
-    });
+    return GetCachedAuraMultiplier(auraType, AuraModifierFilter::MiscMask, int32(miscMask));
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auraType, uint32 miscMask, AuraEffect const* except /*= nullptr*/) const
 {
-    return GetMaxPositiveAuraModifier(auraType, [miscMask, except](AuraEffect const* aurEff) -> bool
+    if (!except)
+        return GetCachedAuraModifier(auraType, AuraModifierTotal::MaxPositiveModifier, AuraModifierFilter::MiscMask, int32(miscMask));
+
+    return CalculateMaxPositiveAuraModifier(auraType, [miscMask, except](AuraEffect const* aurEff) -> bool
     {
         if (except != aurEff && (aurEff->GetMiscValue() & miscMask) != 0)
             return true;
@@ -4838,57 +4938,32 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auraType, uint32 miscM
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
-    {
-        if ((aurEff->GetMiscValue() & miscMask) != 0)
-            return true;
-        return false;
-    });
+    return GetCachedAuraModifier(auraType, AuraModifierTotal::MaxNegativeModifier, AuraModifierFilter::MiscMask, int32(miscMask));
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetTotalAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
-    {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
-    });
+    return GetCachedAuraModifier(auraType, AuraModifierTotal::Modifier, AuraModifierFilter::MiscValue, miscValue);
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetTotalAuraMultiplier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
-    {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
-    });
+    return GetCachedAuraMultiplier(auraType, AuraModifierFilter::MiscValue, miscValue);
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetMaxPositiveAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
-    {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
-    });
+    return GetCachedAuraModifier(auraType, AuraModifierTotal::MaxPositiveModifier, AuraModifierFilter::MiscValue, miscValue);
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
-    {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
-    });
+    return GetCachedAuraModifier(auraType, AuraModifierTotal::MaxNegativeModifier, AuraModifierFilter::MiscValue, miscValue);
 }
 
 int32 Unit::GetTotalAuraModifierByAffectMask(AuraType auraType, SpellInfo const* affectedSpell) const
 {
-    return GetTotalAuraModifier(auraType, [affectedSpell](AuraEffect const* aurEff) -> bool
+    return CalculateTotalAuraModifier(auraType, [affectedSpell](AuraEffect const* aurEff) -> bool
     {
         if (aurEff->IsAffectedOnSpell(affectedSpell))
             return true;
@@ -4898,7 +4973,7 @@ int32 Unit::GetTotalAuraModifierByAffectMask(AuraType auraType, SpellInfo const*
 
 float Unit::GetTotalAuraMultiplierByAffectMask(AuraType auraType, SpellInfo const* affectedSpell) const
 {
-    return GetTotalAuraMultiplier(auraType, [affectedSpell](AuraEffect const* aurEff) -> bool
+    return CalculateTotalAuraMultiplier(auraType, [affectedSpell](AuraEffect const* aurEff) -> bool
     {
         if (aurEff->IsAffectedOnSpell(affectedSpell))
             return true;
@@ -4908,7 +4983,7 @@ float Unit::GetTotalAuraMultiplierByAffectMask(AuraType auraType, SpellInfo cons
 
 int32 Unit::GetMaxPositiveAuraModifierByAffectMask(AuraType auraType, SpellInfo const* affectedSpell) const
 {
-    return GetMaxPositiveAuraModifier(auraType, [affectedSpell](AuraEffect const* aurEff) -> bool
+    return CalculateMaxPositiveAuraModifier(auraType, [affectedSpell](AuraEffect const* aurEff) -> bool
     {
         if (aurEff->IsAffectedOnSpell(affectedSpell))
             return true;
@@ -4918,7 +4993,7 @@ int32 Unit::GetMaxPositiveAuraModifierByAffectMask(AuraType auraType, SpellInfo
 
 int32 Unit::GetMaxNegativeAuraModifierByAffectMask(AuraType auraType, SpellInfo const* affectedSpell) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [affectedSpell](AuraEffect const* aurEff) -> bool
+    return CalculateMaxNegativeAuraModifier(auraType, [affectedSpell](AuraEffect const* aurEff) -> bool
     {
         if (aurEff->IsAffectedOnSpell(affectedSpell))
             return true;
@@ -5169,9 +5244,10 @@ void Unit::RemoveAllGameObjects()
     }
 }
 
-void Unit::SendSpellNonMeleeDamageLog(SpellNonMeleeDamage* log)
+/*static*/ void Unit::BuildSpellNonMeleeDamageLog(SpellNonMeleeDamage const* log, WorldPacket* packet)
 {
-    WorldPacket data(SMSG_SPELLNONMELEEDAMAGELOG, (16+4+4+4+1+4+4+1+1+4+4+1)); // we guess size
+    WorldPacket& data = *packet;
+    data.Initialize(SMSG_SPELLNONMELEEDAMAGELOG, (16+4+4+4+1+4+4+1+1+4+4+1)); // we guess size
     data << log->target->GetPackGUID();
     data << log->attacker->GetPackGUID();
     data << uint32(log->SpellID);
@@ -5205,7 +5281,15 @@ void Unit::SendSpellNonMeleeDamageLog(SpellNonMeleeDamage* log)
     //    data << float(log->GlanceChance);
     //    data << float(log->CrushChance);
     //}
-    SendMessageToSet(&data, true);
+}
+
+void Unit::SendSpellNonMeleeDamageLog(SpellNonMeleeDamage* log)
+{
+    SendCombatLogMessage([log](WorldPacket* data)
+    {
+        BuildSpellNonMeleeDamageLog(log, data);
+        return true;
+    });
 }
 
 void Unit::SendSpellNonMeleeDamageLog(Unit* target, uint32 spellID, uint32 damage, SpellSchoolMask damageSchoolMask, uint32 absorbedDamage, uint32 resist, bool isPeriodic, uint32 blocked, bool criticalHit, bool split)
@@ -5239,135 +5323,149 @@ void Unit::SendSpellNonMeleeDamageLog(Unit* target, uint32 spellID, uint32 damag
 
 void Unit::SendPeriodicAuraLog(SpellPeriodicAuraLogInfo* pInfo)
 {
-    AuraEffect const* aura = pInfo->auraEff;
-
-    WorldPacket data(SMSG_PERIODICAURALOG, 30);
-    data << GetPackGUID();
-    data << aura->GetCasterGUID().WriteAsPacked();
-    data << uint32(aura->GetId());                          // spellId
-    data << uint32(1);                                      // count
-    data << uint32(aura->GetAuraType());                    // auraId
-    switch (aura->GetAuraType())
-    {
-        case SPELL_AURA_PERIODIC_DAMAGE:
-        case SPELL_AURA_PERIODIC_DAMAGE_PERCENT:
-            data << uint32(pInfo->damage);                  // damage
-            data << uint32(pInfo->overDamage);              // overkill?
-            data << uint32(aura->GetSpellInfo()->GetSchoolMask());
-            data << uint32(pInfo->absorb);                  // absorb
-            data << uint32(pInfo->resist);                  // resist
-            data << uint8(pInfo->critical);                 // new 3.1.2 critical tick
-            break;
-        case SPELL_AURA_PERIODIC_HEAL:
-        case SPELL_AURA_OBS_MOD_HEALTH:
-            data << uint32(pInfo->damage);                  // damage
-            data << uint32(pInfo->overDamage);              // overheal
-            data << uint32(pInfo->absorb);                  // absorb
-            data << uint8(pInfo->critical);                 // new 3.1.2 critical tick
-            break;
-        case SPELL_AURA_OBS_MOD_POWER:
-        case SPELL_AURA_PERIODIC_ENERGIZE:
-            data << uint32(aura->GetMiscValue());           // power type
-            data << uint32(pInfo->damage);                  // damage
-            break;
-        case SPELL_AURA_PERIODIC_MANA_LEECH:
-            data << uint32(aura->GetMiscValue());           // power type
-            data << uint32(pInfo->damage);                  // amount
-            data << float(pInfo->multiplier);               // gain multiplier
-            break;
-        default:
-            TC_LOG_ERROR("entities.unit", "Unit::SendPeriodicAuraLog: unknown aura %u", uint32(aura->GetAuraType()));
-            return;
-    }
+    SendCombatLogMessage([&](WorldPacket* packet)
+    {
+        AuraEffect const* aura = pInfo->auraEff;
 
-    SendMessageToSet(&data, true);
+        WorldPacket& data = *packet;
+        data.Initialize(SMSG_PERIODICAURALOG, 30);
+        data << GetPackGUID();
+        data << aura->GetCasterGUID().WriteAsPacked();
+        data << uint32(aura->GetId());                          // spellId
+        data << uint32(1);                                      // count
+        data << uint32(aura->GetAuraType());                    // auraId
+        switch (aura->GetAuraType())
+        {
+            case SPELL_AURA_PERIODIC_DAMAGE:
+            case SPELL_AURA_PERIODIC_DAMAGE_PERCENT:
+                data << uint32(pInfo->damage);                  // damage
+                data << uint32(pInfo->overDamage);              // overkill?
+                data << uint32(aura->GetSpellInfo()->GetSchoolMask());
+                data << uint32(pInfo->absorb);                  // absorb
+                data << uint32(pInfo->resist);                  // resist
+                data << uint8(pInfo->critical);                 // new 3.1.2 critical tick
+                break;
+            case SPELL_AURA_PERIODIC_HEAL:
+            case SPELL_AURA_OBS_MOD_HEALTH:
+                data << uint32(pInfo->damage);                  // damage
+                data << uint32(pInfo->overDamage);              // overheal
+                data << uint32(pInfo->absorb);                  // absorb
+                data << uint8(pInfo->critical);                 // new 3.1.2 critical tick
+                break;
+            case SPELL_AURA_OBS_MOD_POWER:
+            case SPELL_AURA_PERIODIC_ENERGIZE:
+                data << uint32(aura->GetMiscValue());           // power type
+                data << uint32(pInfo->damage);                  // damage
+                break;
+            case SPELL_AURA_PERIODIC_MANA_LEECH:
+                data << uint32(aura->GetMiscValue());           // power type
+                data << uint32(pInfo->damage);                  // amount
+                data << float(pInfo->multiplier);               // gain multiplier
+                break;
+            default:
+                TC_LOG_ERROR("entities.unit", "Unit::SendPeriodicAuraLog: unknown aura %u", uint32(aura->GetAuraType()));
+                return false;
+        }
+        return true;
+    });
 }
 
 void Unit::SendSpellDamageResist(Unit* target, uint32 spellId)
 {
-    WorldPacket data(SMSG_PROCRESIST, 8+8+4+1);
-    data << uint64(GetGUID());
-    data << uint64(target->GetGUID());
-    data << uint32(spellId);
-    data << uint8(0); // bool - log format: 0-default, 1-debug
-    SendMessageToSet(&data, true);
+    SendCombatLogMessage([&](WorldPacket* packet)
+    {
+        WorldPacket& data = *packet;
+        data.Initialize(SMSG_PROCRESIST, 8+8+4+1);
+        data << uint64(GetGUID());
+        data << uint64(target->GetGUID());
+        data << uint32(spellId);
+        data << uint8(0); // bool - log format: 0-default, 1-debug
+        return true;
+    });
 }
 
 void Unit::SendSpellDamageImmune(Unit* target, uint32 spellId)
 {
-    WorldPacket data(SMSG_SPELLORDAMAGE_IMMUNE, 8+8+4+1);
-    data << uint64(GetGUID());
-    data << uint64(target->GetGUID());
-    data << uint32(spellId);
-    data << uint8(0); // bool - log format: 0-default, 1-debug
-    SendMessageToSet(&data, true);
+    SendCombatLogMessage([&](WorldPacket* packet)
+    {
+        WorldPacket& data = *packet;
+        data.Initialize(SMSG_SPELLORDAMAGE_IMMUNE, 8+8+4+1);
+        data << uint64(GetGUID());
+        data << uint64(target->GetGUID());
+        data << uint32(spellId);
+        data << uint8(0); // bool - log format: 0-default, 1-debug
+        return true;
+    });
 }
 
 void Unit::SendAttackStateUpdate(CalcDamageInfo* damageInfo)
 {
-    uint32 count = 1;
-    if (damageInfo->Damages[1].Damage || damageInfo->Damages[1].Absorb || damageInfo->Damages[1].Resist)
-        ++count;
-
-    // guess size
-    size_t const maxsize = 4+5+5+4+4+1+(4+4+4)*2+4*2+4*2+1+4+4+4+4+4*12;
-    WorldPacket data(SMSG_ATTACKERSTATEUPDATE, maxsize);
+    SendCombatLogMessage([&](WorldPacket* packet)
+    {
+        uint32 count = 1;
+        if (damageInfo->Damages[1].Damage || damageInfo->Damages[1].Absorb || damageInfo->Damages[1].Resist)
+            ++count;
 
-    data << uint32(damageInfo->HitInfo);
-    data << damageInfo->Attacker->GetPackGUID();
-    data << damageInfo->Target->GetPackGUID();
-    data << uint32(damageInfo->Damages[0].Damage + damageInfo->Damages[1].Damage); // Full damage
-    int32 overkill = damageInfo->Damages[0].Damage + damageInfo->Damages[1].Damage - damageInfo->Target->GetHealth();
-    data << uint32(overkill < 0 ? 0 : overkill);            // Overkill
-    data << uint8(count);                                   // Sub damage count
+        // guess size
+        size_t const maxsize = 4+5+5+4+4+1+(4+4+4)*2+4*2+4*2+1+4+4+4+4+4*12;
+        WorldPacket& data = *packet;
+        data.Initialize(SMSG_ATTACKERSTATEUPDATE, maxsize);
 
-    for (uint32 i = 0; i < count; ++i)
-    {
-        data << uint32(damageInfo->Damages[i].DamageSchoolMask);       // School of sub damage
-        data << float(damageInfo->Damages[i].Damage);                  // sub damage
-        data << uint32(damageInfo->Damages[i].Damage);                 // Sub Damage
-    }
+        data << uint32(damageInfo->HitInfo);
+        data << damageInfo->Attacker->GetPackGUID();
+        data << damageInfo->Target->GetPackGUID();
+        data << uint32(damageInfo->Damages[0].Damage + damageInfo->Damages[1].Damage); // Full damage
+        int32 overkill = damageInfo->Damages[0].Damage + damageInfo->Damages[1].Damage - damageInfo->Target->GetHealth();
+        data << uint32(overkill < 0 ? 0 : overkill);            // Overkill
+        data << uint8(count);                                   // Sub damage count
 
-    if (damageInfo->HitInfo & (HITINFO_FULL_ABSORB | HITINFO_PARTIAL_ABSORB))
-    {
         for (uint32 i = 0; i < count; ++i)
-            data << uint32(damageInfo->Damages[i].Absorb);             // Absorb
-    }
+        {
+            data << uint32(damageInfo->Damages[i].DamageSchoolMask);       // School of sub damage
+            data << float(damageInfo->Damages[i].Damage);                  // sub damage
+            data << uint32(damageInfo->Damages[i].Damage);                 // Sub Damage
+        }
 
-    if (damageInfo->HitInfo & (HITINFO_FULL_RESIST | HITINFO_PARTIAL_RESIST))
-    {
-        for (uint32 i = 0; i < count; ++i)
-            data << uint32(damageInfo->Damages[i].Resist);             // Resist
-    }
+        if (damageInfo->HitInfo & (HITINFO_FULL_ABSORB | HITINFO_PARTIAL_ABSORB))
+        {
+            for (uint32 i = 0; i < count; ++i)
+                data << uint32(damageInfo->Damages[i].Absorb);             // Absorb
+        }
 
-    data << uint8(damageInfo->TargetState);
-    data << uint32(0);  // Unknown attackerstate
-    data << uint32(0);  // Melee spellid
+        if (damageInfo->HitInfo & (HITINFO_FULL_RESIST | HITINFO_PARTIAL_RESIST))
+        {
+            for (uint32 i = 0; i < count; ++i)
+                data << uint32(damageInfo->Damages[i].Resist);             // Resist
+        }
 
-    if (damageInfo->HitInfo & HITINFO_BLOCK)
-        data << uint32(damageInfo->Blocked);
+        data << uint8(damageInfo->TargetState);
+        data << uint32(0);  // Unknown attackerstate
+        data << uint32(0);  // Melee spellid
 
-    if (damageInfo->HitInfo & HITINFO_RAGE_GAIN)
-        data << uint32(0);
+        if (damageInfo->HitInfo & HITINFO_BLOCK)
+            data << uint32(damageInfo->Blocked);
 
-    //! Probably used for debugging purposes, as it is not known to appear on retail servers
-    if (damageInfo->HitInfo & HITINFO_UNK1)
-    {
-        data << uint32(0);
-        data << float(0);
-        data << float(0);
-        data << float(0);
-        data << float(0);
-        data << float(0);
-        data << float(0);
-        data << float(0);
-        data << float(0);
-        data << float(0);       // Found in a loop with 1 iteration
-        data << float(0);       // ditto ^
-        data << uint32(0);
-    }
+        if (damageInfo->HitInfo & HITINFO_RAGE_GAIN)
+            data << uint32(0);
 
-    SendMessageToSet(&data, true);
+        //! Probably used for debugging purposes, as it is not known to appear on retail servers
+        if (damageInfo->HitInfo & HITINFO_UNK1)
+        {
+            data << uint32(0);
+            data << float(0);
+            data << float(0);
+            data << float(0);
+            data << float(0);
+            data << float(0);
+            data << float(0);
+            data << float(0);
+            data << float(0);
+            data << float(0);       // Found in a loop with 1 iteration
+            data << float(0);       // ditto ^
+            data << uint32(0);
+        }
+        return true;
+    });
 }
 
 void Unit::SendAttackStateUpdate(uint32 HitInfo, Unit* target, uint8 /*SwingType*/, SpellSchoolMask damageSchoolMask, uint32 Damage, uint32 AbsorbDamage, uint32 Resist, VictimState TargetState, uint32 BlockedAmount)
@@ -6385,17 +6483,21 @@ void Unit::UnsummonAllTotems()
 
 void Unit::SendHealSpellLog(HealInfo& healInfo, bool critical /*= false*/)
 {
-    // we guess size
-    WorldPacket data(SMSG_SPELLHEALLOG, 8 + 8 + 4 + 4 + 4 + 4 + 1 + 1);
-    data << healInfo.GetTarget()->GetPackGUID();
-    data << healInfo.GetHealer()->GetPackGUID();
-    data << uint32(healInfo.GetSpellInfo()->Id);
-    data << uint32(healInfo.GetHeal());
-    data << uint32(healInfo.GetHeal() - healInfo.GetEffectiveHeal());
-    data << uint32(healInfo.GetAbsorb()); // Absorb amount
-    data << uint8(critical ? 1 : 0);
-    data << uint8(0); // unused
-    SendMessageToSet(&data, true);
+    SendCombatLogMessage([&](WorldPacket* packet)
+    {
+        // we guess size
+        WorldPacket& data = *packet;
+        data.Initialize(SMSG_SPELLHEALLOG, 8 + 8 + 4 + 4 + 4 + 4 + 1 + 1);
+        data << healInfo.GetTarget()->GetPackGUID();
+        data << healInfo.GetHealer()->GetPackGUID();
+        data << uint32(healInfo.GetSpellInfo()->Id);
+        data << uint32(healInfo.GetHeal());
+        data << uint32(healInfo.GetHeal() - healInfo.GetEffectiveHeal());
+        data << uint32(healInfo.GetAbsorb()); // Absorb amount
+        data << uint8(critical ? 1 : 0);
+        data << uint8(0); // unused
+        return true;
+    });
 }
 
 int32 Unit::HealBySpell(HealInfo& healInfo, bool critical /*= false*/)
@@ -6409,13 +6511,17 @@ int32 Unit::HealBySpell(HealInfo& healInfo, bool critical /*= false*/)
 
 void Unit::SendEnergizeSpellLog(Unit* victim, uint32 spellId, int32 damage, Powers powerType)
 {
-    WorldPacket data(SMSG_SPELLENERGIZELOG, (8+8+4+4+4+1));
-    data << victim->GetPackGUID();
-    data << GetPackGUID();
-    data << uint32(spellId);
-    data << uint32(powerType);
-    data << int32(damage);
-    SendMessageToSet(&data, true);
+    SendCombatLogMessage([&](WorldPacket* packet)
+    {
+        WorldPacket& data = *packet;
+        data.Initialize(SMSG_SPELLENERGIZELOG, (8+8+4+4+4+1));
+        data << victim->GetPackGUID();
+        data << GetPackGUID();
+        data << uint32(spellId);
+        data << uint32(powerType);
+        data << int32(damage);
+        return true;
+    });
 }
 
 void Unit::EnergizeBySpell(Unit* victim, uint32 spellId, int32 damage, Powers powerType)
@@ -9444,6 +9550,7 @@ void Unit::AIUpdateTick(uint32 diff)
 {
     if (UnitAI* ai = GetAI())
     {
+        TC_PROFILE_ZONE("UnitAI::UpdateAI");
         m_aiLocked = true;
         ai->UpdateAI(diff);
         m_aiLocked = false;
@@ -10083,17 +10190,39 @@ void Unit::GetProcAurasTriggeredOnEvent(AuraApplicationProcContainer& aurasTrigg
     // or generate one on our own
     else
     {
-        for (AuraApplicationMap::iterator itr = GetAppliedAuras().begin(); itr != GetAppliedAuras().end(); ++itr)
+        if (m_procAuraIndexGeneration != sSpellMgr->GetSpellProcsGeneration())
+            RebuildProcAuraIndex();
+
+        // only auras whose proc entry reacts to the event type can trigger, collect them first
+        // as proc checks and scripts are allowed to apply or remove auras
+        AuraProcIndex::Candidates candidates;
+        m_procAuraIndex.Collect(eventInfo.GetTypeMask(), candidates);
+
+        for (AuraApplication* aurApp : candidates)
         {
-            if (uint8 procEffectMask = itr->second->GetBase()->GetProcEffectMask(itr->second, eventInfo, now))
+            if (aurApp->GetRemoveMode())
+                continue;
+
+            if (uint8 procEffectMask = aurApp->GetBase()->GetProcEffectMask(aurApp, eventInfo, now))
             {
-                itr->second->GetBase()->PrepareProcToTrigger(itr->second, eventInfo, now);
-                aurasTriggeringProc.emplace_back(procEffectMask, itr->second);
+                aurApp->GetBase()->PrepareProcToTrigger(aurApp, eventInfo, now);
+                aurasTriggeringProc.emplace_back(procEffectMask, aurApp);
             }
         }
     }
 }
 
+// spell_proc was reloaded, proc flags of applied auras may have changed
+void Unit::RebuildProcAuraIndex()
+{
+    m_procAuraIndex.Clear();
+    for (AuraApplicationMap::value_type const& pair : m_appliedAuras)
+        if (SpellProcEntry const* procEntry = sSpellMgr->GetSpellProcEntry(pair.first))
+            m_procAuraIndex.Insert(pair.first, procEntry->ProcFlags, pair.second);
+
+    m_procAuraIndexGeneration = sSpellMgr->GetSpellProcsGeneration();
+}
+
 void Unit::TriggerAurasProcOnEvent(Unit* actionTarget, uint32 typeMaskActor, uint32 typeMaskActionTarget, uint32 spellTypeMask, uint32 spellPhaseMask, uint32 hitMask, Spell* spell, DamageInfo* damageInfo, HealInfo* healInfo)
 {
     // prepare data for self trigger
@@ -10496,26 +10625,19 @@ void Unit::UpdateReactives(uint32 p_time)
 
 Unit* Unit::SelectNearbyTarget(Unit* exclude, float dist) const
 {
-    std::list<Unit*> targets;
+    std::vector<Unit*> targets;
     Trinity::AnyUnfriendlyUnitInObjectRangeCheck u_check(this, this, dist);
-    Trinity::UnitListSearcher<Trinity::AnyUnfriendlyUnitInObjectRangeCheck> searcher(this, targets, u_check);
-    Cell::VisitAllObjects(this, searcher, dist);
-
-    // remove current target
-    if (GetVictim())
-        targets.remove(GetVictim());
+    Trinity::SearchUnitsInCachedCells(this, targets, u_check, dist);
 
-    if (exclude)
-        targets.remove(exclude);
-
-    // remove not LoS targets
-    for (std::list<Unit*>::iterator tIter = targets.begin(); tIter != targets.end();)
+    // remove current target and not LoS targets
+    Unit* victim = GetVictim();
+    targets.erase(std::remove_if(targets.begin(), targets.end(), [this, victim, exclude](Unit* target)
     {
-        if (!IsWithinLOSInMap(*tIter) || (*tIter)->IsTotem() || (*tIter)->IsSpiritService() || (*tIter)->IsCritter())
-            targets.erase(tIter++);
-        else
-            ++tIter;
-    }
+        if (target == victim || target == exclude)
+            return true;
+
+        return !IsWithinLOSInMap(target) || target->IsTotem() || target->IsSpiritService() || target->IsCritter();
+    }), targets.end());
 
     // no appropriate targets
     if (targets.empty())
@@ -19,6 +19,8 @@
 #define __UNIT_H
 
 #include "Object.h"
+#include "AuraModifierCache.h"
+#include "AuraProcIndex.h"
 #include "CombatManager.h"
 #include "SpellAuraDefines.h"
 #include "ThreatManager.h"
@@ -984,6 +986,7 @@ class TC_GAME_API Unit : public WorldObject
                                      uint32 spellTypeMask, uint32 spellPhaseMask, uint32 hitMask, Spell* spell,
                                      DamageInfo* damageInfo, HealInfo* healInfo);
         void TriggerAurasProcOnEvent(ProcEventInfo& eventInfo, AuraApplicationProcContainer& procAuras);
+        void RebuildProcAuraIndex();
 
         void HandleEmoteCommand(Emote emoteId);
         void AttackerStateUpdate (Unit* victim, WeaponAttackType attType = BASE_ATTACK, bool extra = false);
@@ -1130,6 +1133,7 @@ class TC_GAME_API Unit : public WorldObject
 
         void SendAttackStateUpdate(CalcDamageInfo* damageInfo);
         void SendAttackStateUpdate(uint32 HitInfo, Unit* target, uint8 SwingType, SpellSchoolMask damageSchoolMask, uint32 Damage, uint32 AbsorbDamage, uint32 Resist, VictimState TargetState, uint32 BlockedAmount);
+        static void BuildSpellNonMeleeDamageLog(SpellNonMeleeDamage const* log, WorldPacket* data);
         void SendSpellNonMeleeDamageLog(SpellNonMeleeDamage* log);
         void SendSpellNonMeleeDamageLog(Unit* target, uint32 spellID, uint32 damage, SpellSchoolMask damageSchoolMask, uint32 absorbedDamage, uint32 resist, bool isPeriodic, uint32 blocked, bool criticalHit = false, bool split = false);
         void SendPeriodicAuraLog(SpellPeriodicAuraLogInfo* pInfo);
@@ -1379,6 +1383,9 @@ class TC_GAME_API Unit : public WorldObject
         int32 GetMaxPositiveAuraModifierByAffectMask(AuraType auraType, SpellInfo const* affectedSpell) const;
         int32 GetMaxNegativeAuraModifierByAffectMask(AuraType auraType, SpellInfo const* affectedSpell) const;
 
+        // totals of the misc value/mask variants above are cached until an effect of the aura type changes
+        void InvalidateAuraModifierCache(AuraType auraType) { m_auraModifierCache.Invalidate(auraType); }
+
         void UpdateResistanceBuffModsMod(SpellSchools school);
         void InitStatBuffMods();
         void UpdateStatBuffMod(Stats stat);
@@ -1792,6 +1799,9 @@ class TC_GAME_API Unit : public WorldObject
         AuraList m_scAuras;                        // cast singlecast auras
         AuraApplicationList m_interruptableAuras;  // auras which have interrupt mask applied on unit
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
+        AuraProcIndex m_procAuraIndex;             // applied auras that can proc, with the proc flags they react to
+        uint32 m_procAuraIndexGeneration;          // SpellMgr spell_proc generation m_procAuraIndex was built from
+        mutable AuraModifierCache m_auraModifierCache;
         uint32 m_interruptMask;
 
         float m_auraFlatModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_FLAT_END];
@@ -1847,6 +1857,18 @@ class TC_GAME_API Unit : public WorldObject
 
         void ProcSkillsAndReactives(bool isVictim, Unit* procTarget, uint32 typeMask, uint32 hitMask, WeaponAttackType attType);
 
+        template<typename Predicate>
+        int32 CalculateTotalAuraModifier(AuraType auraType, Predicate const& predicate) const;
+        template<typename Predicate>
+        float CalculateTotalAuraMultiplier(AuraType auraType, Predicate const& predicate) const;
+        template<typename Predicate>
+        int32 CalculateMaxPositiveAuraModifier(AuraType auraType, Predicate const& predicate) const;
+        template<typename Predicate>
+        int32 CalculateMaxNegativeAuraModifier(AuraType auraType, Predicate const& predicate) const;
+
+        int32 GetCachedAuraModifier(AuraType auraType, AuraModifierTotal total, AuraModifierFilter filter, int32 misc) const;
+        float GetCachedAuraMultiplier(AuraType auraType, AuraModifierFilter filter, int32 misc) const;
+
     protected:
 
         void SetFeared(bool apply);
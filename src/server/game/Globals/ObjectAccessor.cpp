@@ -37,26 +37,19 @@ void HashMapHolder<T>::Insert(T* o)
         || std::is_same<Transport, T>::value,
         "Only Player and Transport can be registered in global HashMapHolder");
 
-    std::unique_lock<std::shared_mutex> lock(*GetLock());
-
-    GetContainer()[o->GetGUID()] = o;
+    GetContainer().Insert(o->GetGUID(), o);
 }
 
 template<class T>
 void HashMapHolder<T>::Remove(T* o)
 {
-    std::unique_lock<std::shared_mutex> lock(*GetLock());
-
-    GetContainer().erase(o->GetGUID());
+    GetContainer().Remove(o->GetGUID());
 }
 
 template<class T>
 T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    std::shared_lock<std::shared_mutex> lock(*GetLock());
-
-    typename MapType::iterator itr = GetContainer().find(guid);
-    return (itr != GetContainer().end()) ? itr->second : nullptr;
+    return GetContainer().Find(guid);
 }
 
 template<class T>
@@ -66,13 +59,6 @@ auto HashMapHolder<T>::GetContainer() -> MapType&
     return _objectMap;
 }
 
-template<class T>
-std::shared_mutex* HashMapHolder<T>::GetLock()
-{
-    static std::shared_mutex _lock;
-    return &_lock;
-}
-
 HashMapHolder<Player>::MapType const& ObjectAccessor::GetPlayers()
 {
     return HashMapHolder<Player>::GetContainer();
@@ -263,11 +249,10 @@ Player* ObjectAccessor::FindConnectedPlayerByName(std::string_view name)
 
 void ObjectAccessor::SaveAllPlayers()
 {
-    std::shared_lock<std::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
-
-    HashMapHolder<Player>::MapType const& m = GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
-        itr->second->SaveToDB();
+    GetPlayers().DoForAll([](ObjectGuid const& /*guid*/, Player* player)
+    {
+        player->SaveToDB();
+    });
 }
 
 template<>
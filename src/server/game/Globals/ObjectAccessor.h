@@ -19,8 +19,7 @@
 #define TRINITY_OBJECTACCESSOR_H
 
 #include "ObjectGuid.h"
-#include <shared_mutex>
-#include <unordered_map>
+#include "ShardedHashMap.h"
 
 class Corpse;
 class Creature;
@@ -42,7 +41,7 @@ class TC_GAME_API HashMapHolder
 
 public:
 
-    typedef std::unordered_map<ObjectGuid, T*> MapType;
+    typedef Trinity::ShardedHashMap<ObjectGuid, T*> MapType;
 
     static void Insert(T* o);
 
@@ -51,8 +50,6 @@ public:
     static T* Find(ObjectGuid guid);
 
     static MapType& GetContainer();
-
-    static std::shared_mutex* GetLock();
 };
 
 namespace ObjectAccessor
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_CELLSEARCHCACHE_H
+#define TRINITY_CELLSEARCHCACHE_H
+
+#include "Define.h"
+#include <unordered_map>
+#include <vector>
+
+/// Objects of a grid cell, collected by the first area search touching the cell and reused
+/// by later searches until the map invalidates the cache (objects added or removed)
+template<class T>
+class CellSearchCache
+{
+    public:
+        typedef std::vector<T> ObjectList;
+
+        /// Returns the cached objects of the cell, fill(ObjectList&) collects them when the entry is stale
+        template<class Fill>
+        ObjectList const& GetCell(uint32 cellId, Fill&& fill)
+        {
+            Entry& entry = _cells[cellId];
+            entry.LastUpdate = _update;
+            if (entry.Generation != _generation)
+            {
+                entry.Objects.clear();
+                fill(entry.Objects);
+                entry.Generation = _generation;
+                ++_filled;
+            }
+            else
+                ++_reused;
+
+            return entry.Objects;
+        }
+
+        void Invalidate() { ++_generation; }
+
+        /// Starts a new map update: everything is invalidated and cells unused during the last update are dropped
+        void NewUpdate()
+        {
+            for (auto itr = _cells.begin(); itr != _cells.end();)
+            {
+                if (itr->second.LastUpdate != _update)
+                    itr = _cells.erase(itr);
+                else
+                    ++itr;
+            }
+
+            ++_update;
+            ++_generation;
+            _filled = 0;
+            _reused = 0;
+        }
+
+        uint32 GetFilledCount() const { return _filled; }
+        uint32 GetReusedCount() const { return _reused; }
+
+    private:
+        struct Entry
+        {
+            uint32 Generation = 0;
+            uint32 LastUpdate = 0;
+            ObjectList Objects;
+        };
+
+        std::unordered_map<uint32, Entry> _cells;
+        uint32 _generation = 1;
+        uint32 _update = 1;
+        uint32 _filled = 0;
+        uint32 _reused = 0;
+};
+
+#endif
@@ -397,6 +397,18 @@ MessageDistDeliverer::VisitObject(Player* player)
 }
 */
 
+void UnitCollector::Visit(PlayerMapType &m)
+{
+    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+        i_units.push_back(iter->GetSource());
+}
+
+void UnitCollector::Visit(CreatureMapType &m)
+{
+    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+        i_units.push_back(iter->GetSource());
+}
+
 template<class T>
 void ObjectUpdater::Visit(GridRefManager<T> &m)
 {
@@ -28,6 +28,7 @@
 #include "SpellInfo.h"
 #include "UnitAI.h"
 #include "UpdateData.h"
+#include "WorldPacket.h"
 
 namespace Trinity
 {
@@ -113,16 +114,57 @@ namespace Trinity
         void Visit(CorpseMapType &m) { updateObjects<Corpse>(m); }
     };
 
+    // Sends one packet to any number of receivers. A packet with a build callback is only built once the first receiver is found,
+    // receivers (optional) collects everyone the packet was sent to
+    template<class Receiver>
+    class PacketDelivery
+    {
+    public:
+        PacketDelivery(WorldPacket const* msg, std::vector<Receiver*>* receivers)
+            : _message(msg), _build(nullptr), _builder(nullptr), _unbuiltMessage(nullptr), _messageDropped(false), _receivers(receivers) { }
+
+        // msg is filled by builder when the first receiver is found
+        PacketDelivery(WorldPacket* msg, bool(*build)(void const* builder, WorldPacket* data), void const* builder, std::vector<Receiver*>* receivers)
+            : _message(msg), _build(build), _builder(builder), _unbuiltMessage(msg), _messageDropped(false), _receivers(receivers) { }
+
+        bool IsMessageBuilt() const { return !_build && !_messageDropped; }
+
+        void Send(Receiver* receiver)
+        {
+            if (_build)
+            {
+                _messageDropped = !_build(_builder, _unbuiltMessage);
+                _build = nullptr;
+            }
+
+            if (_messageDropped)
+                return;
+
+            if (_receivers)
+                _receivers->push_back(receiver);
+
+            receiver->SendDirectMessage(_message.Get());
+        }
+
+    private:
+        SharedWorldPacket _message;
+        bool(*_build)(void const* builder, WorldPacket* data);
+        void const* _builder;
+        WorldPacket* _unbuiltMessage;
+        bool _messageDropped;
+        std::vector<Receiver*>* _receivers;
+    };
+
     struct TC_GAME_API MessageDistDeliverer
     {
         WorldObject const* i_source;
-        WorldPacket const* i_message;
+        PacketDelivery<Player> i_delivery;
         uint32 i_phaseMask;
         float i_distSq;
         uint32 team;
         Player const* skipped_receiver;
         MessageDistDeliverer(WorldObject const* src, WorldPacket const* msg, float dist, bool own_team_only = false, Player const* skipped = nullptr)
-            : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
+            : i_source(src), i_delivery(msg, nullptr), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
             , team(0)
             , skipped_receiver(skipped)
         {
@@ -131,6 +173,24 @@ namespace Trinity
                     team = player->GetTeam();
         }
 
+        // every player the packet is sent to is also added to receivers
+        MessageDistDeliverer(WorldObject const* src, WorldPacket const* msg, float dist, std::vector<Player*>& receivers)
+            : i_source(src), i_delivery(msg, &receivers), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
+            , team(0)
+            , skipped_receiver(nullptr)
+        {
+        }
+
+        // msg is filled by builder when the first receiver is found, receivers (optional) collects everyone it was sent to
+        MessageDistDeliverer(WorldObject const* src, WorldPacket* msg, bool(*build)(void const* builder, WorldPacket* data), void const* builder, float dist, std::vector<Player*>* receivers = nullptr)
+            : i_source(src), i_delivery(msg, build, builder, receivers), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
+            , team(0)
+            , skipped_receiver(nullptr)
+        {
+        }
+
+        bool IsMessageBuilt() const { return i_delivery.IsMessageBuilt(); }
+
         void Visit(PlayerMapType &m);
         void Visit(CreatureMapType &m);
         void Visit(DynamicObjectMapType &m);
@@ -145,14 +205,14 @@ namespace Trinity
             if (!player->HaveAtClient(i_source))
                 return;
 
-            player->SendDirectMessage(i_message);
+            i_delivery.Send(player);
         }
     };
 
     struct TC_GAME_API MessageDistDelivererToHostile
     {
         Unit* i_source;
-        WorldPacket const* i_message;
+        SharedWorldPacket i_message;
         uint32 i_phaseMask;
         float i_distSq;
 
@@ -172,7 +232,7 @@ namespace Trinity
             if (player == i_source || !player->HaveAtClient(i_source) || player->IsFriendlyTo(i_source))
                 return;
 
-            player->SendDirectMessage(i_message);
+            player->SendDirectMessage(i_message.Get());
         }
     };
 
@@ -456,6 +516,27 @@ namespace Trinity
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
     };
 
+    // All units of the visited cells, unfiltered, used to fill Map::GetUnitSearchCache
+    struct TC_GAME_API UnitCollector
+    {
+        std::vector<Unit*>& i_units;
+
+        UnitCollector(std::vector<Unit*>& units) : i_units(units) { }
+
+        void Visit(PlayerMapType &m);
+        void Visit(CreatureMapType &m);
+
+        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+    };
+
+    // Same result as UnitListSearcher with Cell::VisitAllObjects, but the units of each cell are
+    // taken from the map's unit search cache so repeated searches around the same spot in one map
+    // update (area auras, persistent area auras) skip walking the grid containers.
+    // Units farther than radius plus both combat reaches from the searcher are dropped before
+    // check runs, so check must measure its range from the searcher
+    template<class Check>
+    void SearchUnitsInCachedCells(WorldObject const* searcher, std::vector<Unit*>& units, Check& check, float radius);
+
     // Creature searchers
 
     template<class Check>
@@ -1594,17 +1675,11 @@ namespace Trinity
         public:
             explicit LocalizedPacketDo(Builder& builder) : i_builder(builder) { }
 
-            ~LocalizedPacketDo()
-            {
-                for (size_t i = 0; i < i_data_cache.size(); ++i)
-                    delete i_data_cache[i];
-            }
-
             void operator()(Player* p);
 
         private:
             Builder& i_builder;
-            std::vector<WorldPacket*> i_data_cache;         // 0 = default, i => i-1 locale index
+            std::vector<std::shared_ptr<WorldPacket const>> i_data_cache; // 0 = default, i => i-1 locale index, shared by all receivers
     };
 
     // Prepare using Builder localized packets with caching and send to player
@@ -1613,20 +1688,15 @@ namespace Trinity
     {
         public:
             typedef std::vector<WorldPacket*> WorldPacketList;
+            typedef std::vector<std::shared_ptr<WorldPacket const>> SharedWorldPacketList;
             explicit LocalizedPacketListDo(Builder& builder) : i_builder(builder) { }
 
-            ~LocalizedPacketListDo()
-            {
-                for (size_t i = 0; i < i_data_cache.size(); ++i)
-                    for (size_t j = 0; j < i_data_cache[i].size(); ++j)
-                        delete i_data_cache[i][j];
-            }
             void operator()(Player* p);
 
         private:
             Builder& i_builder;
-            std::vector<WorldPacketList> i_data_cache;
-                                                            // 0 = default, i => i-1 locale index
+            std::vector<SharedWorldPacketList> i_data_cache;
+                                                            // 0 = default, i => i-1 locale index, shared by all receivers
     };
 }
 #endif
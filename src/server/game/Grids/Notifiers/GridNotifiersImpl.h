@@ -19,6 +19,8 @@
 #define TRINITY_GRIDNOTIFIERSIMPL_H
 
 #include "GridNotifiers.h"
+#include "CellImpl.h"
+#include "DistanceKernels.h"
 #include "Corpse.h"
 #include "CreatureAI.h"
 #include "Player.h"
@@ -421,6 +423,75 @@ void Trinity::UnitListSearcher<Check>::Visit(CreatureMapType &m)
                 Insert(itr->GetSource());
 }
 
+template<class Check>
+void Trinity::SearchUnitsInCachedCells(WorldObject const* searcher, std::vector<Unit*>& units, Check& check, float radius)
+{
+    CellCoord standingCell(Trinity::ComputeCellCoord(searcher->GetPositionX(), searcher->GetPositionY()));
+    if (!standingCell.IsCoordValid())
+        return;
+
+    // same cell range as Cell::Visit, wide areas are visited as a circle there so they are not cached
+    float cellRadius = std::min(std::max(radius + searcher->GetCombatReach(), 0.0f), float(SIZE_OF_GRIDS));
+    CellArea area = Cell::CalculateCellArea(searcher->GetPositionX(), searcher->GetPositionY(), cellRadius);
+    if ((area.high_bound.x_coord > (area.low_bound.x_coord + 4)) && (area.high_bound.y_coord > (area.low_bound.y_coord + 4)))
+    {
+        UnitListSearcher<Check> unitSearcher(searcher, units, check);
+        Cell::VisitAllObjects(searcher, unitSearcher, radius);
+        return;
+    }
+
+    Map* map = searcher->GetMap();
+    uint32 phaseMask = searcher->GetPhaseMask();
+    float range = radius + searcher->GetCombatReach();
+
+    // positions are gathered in batches so the distance broad phase runs vectorized and the checks
+    // (faction, visibility, conditions) only see units that can possibly be in range
+    constexpr uint32 BatchSize = 64;
+    float batchX[BatchSize];
+    float batchY[BatchSize];
+    float batchReach[BatchSize];
+    uint32 selected[BatchSize];
+
+    for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+    {
+        for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+        {
+            CellCoord cellCoord(x, y);
+            std::vector<Unit*> const& cellUnits = map->GetUnitSearchCache().GetCell(cellCoord.GetId(), [map, &cellCoord](std::vector<Unit*>& cached)
+            {
+                Cell cell(cellCoord);
+                cell.SetNoCreate();
+
+                UnitCollector collector(cached);
+                TypeContainerVisitor<UnitCollector, WorldTypeMapContainer> worldVisitor(collector);
+                TypeContainerVisitor<UnitCollector, GridTypeMapContainer> gridVisitor(collector);
+                map->Visit(cell, worldVisitor);
+                map->Visit(cell, gridVisitor);
+            });
+
+            for (std::size_t begin = 0; begin < cellUnits.size(); begin += BatchSize)
+            {
+                uint32 batchCount = uint32(std::min<std::size_t>(cellUnits.size() - begin, BatchSize));
+                for (uint32 i = 0; i < batchCount; ++i)
+                {
+                    Unit const* unit = cellUnits[begin + i];
+                    batchX[i] = unit->GetPositionX();
+                    batchY[i] = unit->GetPositionY();
+                    batchReach[i] = unit->GetCombatReach();
+                }
+
+                uint32 inRange = SelectInRange2d(batchX, batchY, batchReach, batchCount, searcher->GetPositionX(), searcher->GetPositionY(), range, selected);
+                for (uint32 i = 0; i < inRange; ++i)
+                {
+                    Unit* unit = cellUnits[begin + selected[i]];
+                    if (unit->InSamePhase(phaseMask) && check(unit))
+                        units.push_back(unit);
+                }
+            }
+        }
+    }
+}
+
 // Creature searchers
 
 template<class Check>
@@ -512,7 +583,6 @@ void Trinity::LocalizedPacketDo<Builder>::operator()(Player* p)
 {
     LocaleConstant loc_idx = p->GetSession()->GetSessionDbLocaleIndex();
     uint32 cache_idx = loc_idx+1;
-    WorldPacket* data;
 
     // create if not cached yet
     if (i_data_cache.size() < cache_idx + 1 || !i_data_cache[cache_idx])
@@ -520,16 +590,14 @@ void Trinity::LocalizedPacketDo<Builder>::operator()(Player* p)
         if (i_data_cache.size() < cache_idx + 1)
             i_data_cache.resize(cache_idx + 1);
 
-        data = new WorldPacket();
+        std::shared_ptr<WorldPacket> data = std::make_shared<WorldPacket>();
 
         i_builder(*data, loc_idx);
 
-        i_data_cache[cache_idx] = data;
+        i_data_cache[cache_idx] = std::move(data);
     }
-    else
-        data = i_data_cache[cache_idx];
 
-    p->SendDirectMessage(data);
+    p->SendDirectMessage(i_data_cache[cache_idx]);
 }
 
 template<class Builder>
@@ -537,7 +605,6 @@ void Trinity::LocalizedPacketListDo<Builder>::operator()(Player* p)
 {
     LocaleConstant loc_idx = p->GetSession()->GetSessionDbLocaleIndex();
     uint32 cache_idx = loc_idx+1;
-    WorldPacketList* data_list;
 
     // create if not cached yet
     if (i_data_cache.size() < cache_idx+1 || i_data_cache[cache_idx].empty())
@@ -545,15 +612,18 @@ void Trinity::LocalizedPacketListDo<Builder>::operator()(Player* p)
         if (i_data_cache.size() < cache_idx+1)
             i_data_cache.resize(cache_idx+1);
 
-        data_list = &i_data_cache[cache_idx];
+        WorldPacketList data_list;
+        i_builder(data_list, loc_idx);
 
-        i_builder(*data_list, loc_idx);
+        // take ownership of the built packets
+        SharedWorldPacketList& shared_list = i_data_cache[cache_idx];
+        shared_list.reserve(data_list.size());
+        for (WorldPacket* data : data_list)
+            shared_list.emplace_back(data);
     }
-    else
-        data_list = &i_data_cache[cache_idx];
 
-    for (size_t i = 0; i < data_list->size(); ++i)
-        p->SendDirectMessage((*data_list)[i]);
+    for (std::shared_ptr<WorldPacket const> const& data : i_data_cache[cache_idx])
+        p->SendDirectMessage(data);
 }
 
 #endif                                                      // TRINITY_GRIDNOTIFIERSIMPL_H
@@ -724,7 +724,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
         {
             if ((*i)->itemid == uint32(cond->SourceEntry))
             {
-                (*i)->conditions.push_back(cond);
+                ConditionMgr::AddToConditionList((*i)->conditions, cond);
                 return true;
             }
         }
@@ -745,7 +745,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if ((*i)->itemid == uint32(cond->SourceEntry))
                     {
-                        (*i)->conditions.push_back(cond);
+                        ConditionMgr::AddToConditionList((*i)->conditions, cond);
                         return true;
                     }
                 }
@@ -758,7 +758,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if ((*i)->itemid == uint32(cond->SourceEntry))
                     {
-                        (*i)->conditions.push_back(cond);
+                        ConditionMgr::AddToConditionList((*i)->conditions, cond);
                         return true;
                     }
                 }
@@ -41,6 +41,7 @@
 #include "Pet.h"
 #include "PoolMgr.h"
 #include "ScriptMgr.h"
+#include "TickProfiler.h"
 #include "Transport.h"
 #include "Vehicle.h"
 #include "VMapFactory.h"
@@ -274,7 +275,8 @@ m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
 i_gridExpiry(expiry),
-i_scriptLock(false), _respawnCheckTimer(0)
+i_scriptLock(false), _respawnCheckTimer(0), _updateTier(MAP_UPDATE_TIER_FULL), _deferredUpdateDiff(0),
+_fullUpdateHoldTimer(0), _creaturesRelocated(false), _unitActivity(false)
 {
     m_parentMap = (_parent ? _parent : this);
     for (unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
@@ -315,9 +317,21 @@ void Map::AddToGrid(T* obj, Cell const& cell)
         grid->GetGridType(cell.CellX(), cell.CellY()).template AddGridObject<T>(obj);
 }
 
+template<>
+void Map::AddToGrid(Player* obj, Cell const& cell)
+{
+    _unitSearchCache.Invalidate();
+    NGridType* grid = getNGrid(cell.GridX(), cell.GridY());
+    if (obj->IsWorldObject())
+        grid->GetGridType(cell.CellX(), cell.CellY()).AddWorldObject(obj);
+    else
+        grid->GetGridType(cell.CellX(), cell.CellY()).AddGridObject(obj);
+}
+
 template<>
 void Map::AddToGrid(Creature* obj, Cell const& cell)
 {
+    _unitSearchCache.Invalidate();
     NGridType* grid = getNGrid(cell.GridX(), cell.GridY());
     if (obj->IsWorldObject())
         grid->GetGridType(cell.CellX(), cell.CellY()).AddWorldObject(obj);
@@ -539,6 +553,7 @@ bool Map::EnsureGridLoaded(Cell const& cell)
         TC_LOG_DEBUG("maps", "Loading grid[%u, %u] for map %u instance %u", cell.GridX(), cell.GridY(), GetId(), i_InstanceId);
 
         setGridObjectDataLoaded(true, cell.GridX(), cell.GridY());
+        _unitSearchCache.Invalidate();
 
         ObjectGridLoader loader(*grid, this, cell);
         loader.LoadN();
@@ -758,6 +773,10 @@ void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
 
 void Map::Update(uint32 t_diff)
 {
+    TC_PROFILE_ZONE("Map::Update");
+    _smartAITimerStats = SmartAITimerStats();
+    _combatLogStats = CombatLogStats();
+    _unitSearchCache.NewUpdate();
     _dynamicTree.update(t_diff);
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -772,6 +791,14 @@ void Map::Update(uint32 t_diff)
         }
     }
 
+    // quiet instances only update their objects every few ticks, using the accumulated diff
+    if (!ConsumeUpdateDiff(t_diff))
+    {
+        // still send changes made by packet handlers right away
+        SendObjectUpdates();
+        return;
+    }
+
     /// process any due respawns
     if (_respawnCheckTimer <= t_diff)
     {
@@ -907,6 +934,84 @@ void Map::Update(uint32 t_diff)
         TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
 }
 
+// time an instance keeps updating every tick after the last activity was seen
+static constexpr uint32 MAP_UPDATE_FULL_TIER_HOLD_TIME = 5 * IN_MILLISECONDS;
+
+bool Map::HasUpdateActivity() const
+{
+    // scripted events, escorts and transports move on their own
+    if (!m_activeNonPlayers.empty() || !_transports.empty() || !m_scriptSchedule.empty())
+        return true;
+
+    // creatures only move in grids activated by players, so any relocation happened near one
+    if (_creaturesRelocated)
+        return true;
+
+    // creatures and pets fighting or casting during the last update, also when no player takes part
+    if (_unitActivity)
+        return true;
+
+    for (MapReference const& ref : m_mapRefManager)
+    {
+        Player const* player = ref.GetSource();
+        if (player->IsInCombat() || player->isMoving() || player->isTurning() || player->HasUnitState(UNIT_STATE_CASTING))
+            return true;
+    }
+
+    return false;
+}
+
+MapUpdateTier Map::SelectUpdateTier(uint32 diff)
+{
+    // continents always run at full rate, this only applies to the instances created by MapInstanced
+    if (!sWorld->getBoolConfig(CONFIG_MAP_UPDATE_ADAPTIVE) || !Instanceable() || !GetInstanceId())
+        return MAP_UPDATE_TIER_FULL;
+
+    // escalate as soon as anything happens and stay there for a while so short pauses do not flip the tier
+    if (HasUpdateActivity())
+    {
+        _fullUpdateHoldTimer = MAP_UPDATE_FULL_TIER_HOLD_TIME;
+        return MAP_UPDATE_TIER_FULL;
+    }
+
+    if (_fullUpdateHoldTimer > diff)
+    {
+        _fullUpdateHoldTimer -= diff;
+        return MAP_UPDATE_TIER_FULL;
+    }
+
+    _fullUpdateHoldTimer = 0;
+    return m_mapRefManager.isEmpty() ? MAP_UPDATE_TIER_IDLE : MAP_UPDATE_TIER_REDUCED;
+}
+
+bool Map::ConsumeUpdateDiff(uint32& diff)
+{
+    _updateTier = SelectUpdateTier(diff);
+    _deferredUpdateDiff += diff;
+
+    uint32 interval = 0;
+    switch (_updateTier)
+    {
+        case MAP_UPDATE_TIER_REDUCED:
+            interval = sWorld->getIntConfig(CONFIG_MAP_UPDATE_REDUCED_INTERVAL);
+            break;
+        case MAP_UPDATE_TIER_IDLE:
+            interval = sWorld->getIntConfig(CONFIG_MAP_UPDATE_IDLE_INTERVAL);
+            break;
+        default:
+            break;
+    }
+
+    if (_deferredUpdateDiff < interval)
+        return false;
+
+    diff = _deferredUpdateDiff;
+    _deferredUpdateDiff = 0;
+    _creaturesRelocated = false;
+    _unitActivity = false;
+    return true;
+}
+
 struct ResetNotifier
 {
     template<class T>inline void resetNotify(GridRefManager<T> &m)
@@ -1011,6 +1116,7 @@ void Map::RemovePlayerFromMap(Player* player, bool remove)
     if (!inWorld) // if was in world, RemoveFromWorld() called DestroyForNearbyPlayers()
         player->DestroyForNearbyPlayers(); // previous player->UpdateObjectVisibility(true)
 
+    _unitSearchCache.Invalidate();
     if (player->IsInGrid())
         player->RemoveFromGrid();
     else
@@ -1032,6 +1138,10 @@ void Map::RemoveFromMap(T *obj, bool remove)
     if (!inWorld) // if was in world, RemoveFromWorld() called DestroyForNearbyPlayers()
         obj->DestroyForNearbyPlayers(); // previous obj->UpdateObjectVisibility(true)
 
+    // the unit search cache only holds players and creatures
+    if (obj->GetTypeId() == TYPEID_UNIT)
+        _unitSearchCache.Invalidate();
+
     obj->RemoveFromGrid();
 
     obj->ResetMap();
@@ -1106,6 +1216,8 @@ void Map::CreatureRelocation(Creature* creature, float x, float y, float z, floa
 {
     ASSERT(CheckGridIntegrity(creature, false));
 
+    _creaturesRelocated = true;
+
     Cell old_cell = creature->GetCurrentCell();
     Cell new_cell(x, y);
 
@@ -1660,6 +1772,7 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
         }
 
         TC_LOG_DEBUG("maps", "Unloading grid[%u, %u] for map %u", x, y, GetId());
+        _unitSearchCache.Invalidate();
 
         if (!unloadAll)
         {
@@ -21,6 +21,7 @@
 #include "Define.h"
 
 #include "Cell.h"
+#include "CellSearchCache.h"
 #include "DynamicTree.h"
 #include "GridDefines.h"
 #include "GridRefManager.h"
@@ -252,8 +253,32 @@ public:
     ZLiquidStatus GetLiquidStatus(float x, float y, float z, uint8 ReqLiquidType, LiquidData* data = 0, float collisionHeight = 2.03128f); // DEFAULT_COLLISION_HEIGHT in Object.h
 };
 
+// SmartAI timer work done during the last Map::Update, see SmartScript::OnUpdate
+struct SmartAITimerStats
+{
+    uint32 Scheduled = 0;   // event timers scanned
+    uint32 Fired = 0;       // event timers that expired
+    uint32 Deferred = 0;    // script updates that skipped the timer scan because nothing could expire yet
+};
+
+// Combat log broadcasts during the last Map::Update, see WorldObject::SendCombatLogMessage
+struct CombatLogStats
+{
+    uint32 Built = 0;       // packets built for at least one receiver
+    uint32 Skipped = 0;     // packets never built because nobody could receive them
+};
+
 #pragma pack(push, 1)
 
+// How often an instance map runs its object updates, player sessions are always updated every tick
+enum MapUpdateTier : uint8
+{
+    MAP_UPDATE_TIER_FULL,       // every map update tick
+    MAP_UPDATE_TIER_REDUCED,    // players present but no unit in combat or casting and no movement
+    MAP_UPDATE_TIER_IDLE,       // no players left, waiting for unload
+    MAX_MAP_UPDATE_TIERS
+};
+
 enum LevelRequirementVsMode
 {
     LEVELREQUIREMENT_HEROIC = 70
@@ -347,6 +372,14 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(uint32);
+        MapUpdateTier GetUpdateTier() const { return _updateTier; }
+        void NoteUnitActivity() { _unitActivity = true; }
+        SmartAITimerStats& GetSmartAITimerStats() { return _smartAITimerStats; }
+        SmartAITimerStats const& GetSmartAITimerStats() const { return _smartAITimerStats; }
+        CombatLogStats& GetCombatLogStats() { return _combatLogStats; }
+        CombatLogStats const& GetCombatLogStats() const { return _combatLogStats; }
+        CellSearchCache<Unit*>& GetUnitSearchCache() { return _unitSearchCache; }
+        CellSearchCache<Unit*> const& GetUnitSearchCache() const { return _unitSearchCache; }
 
         float GetVisibilityRange() const { return m_VisibleDistance; }
         //function for setting up visibility distance for maps on per-type/per-Id basis
@@ -756,6 +789,10 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         //visibility calculations. Highly optimized for massive calculations
         void ProcessRelocationNotifies(const uint32 diff);
 
+        MapUpdateTier SelectUpdateTier(uint32 diff);
+        bool HasUpdateActivity() const;
+        bool ConsumeUpdateDiff(uint32& diff);
+
         bool i_scriptLock;
         std::set<WorldObject*> i_objectsToRemove;
         std::map<WorldObject*, bool> i_objectsToSwitch;
@@ -880,6 +917,15 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         std::unordered_set<uint32> _toggledSpawnGroupIds;
 
         uint32 _respawnCheckTimer;
+
+        MapUpdateTier _updateTier;
+        uint32 _deferredUpdateDiff;
+        uint32 _fullUpdateHoldTimer;
+        bool _creaturesRelocated;
+        bool _unitActivity;
+        SmartAITimerStats _smartAITimerStats;
+        CombatLogStats _combatLogStats;
+        CellSearchCache<Unit*> _unitSearchCache;
         std::unordered_map<uint32, uint32> _zonePlayerCountMap;
 
         ZoneDynamicInfoMap _zoneDynamicInfo;
@@ -19,6 +19,7 @@
 #include "InstanceSaveMgr.h"
 #include "DatabaseEnv.h"
 #include "Log.h"
+#include "Metric.h"
 #include "ObjectAccessor.h"
 #include "Transport.h"
 #include "GridDefines.h"
@@ -33,6 +34,7 @@
 #include "Player.h"
 #include "WorldSession.h"
 #include "Opcodes.h"
+#include <array>
 
 MapManager::MapManager()
     : _nextInstanceId(0), _scheduledScripts(0)
@@ -206,11 +208,15 @@ Map::EnterState MapManager::PlayerCannotEnter(uint32 mapid, Player* player, bool
     return Map::CAN_ENTER;
 }
 
-void MapManager::Update(uint32 diff)
+void MapManager::Update(uint32 diff, std::function<void()> const& overlappedWork)
 {
     i_timer.Update(diff);
     if (!i_timer.Passed())
+    {
+        if (overlappedWork)
+            overlappedWork();
         return;
+    }
 
     MapMapType::iterator iter = i_maps.begin();
     for (; iter != i_maps.end(); ++iter)
@@ -220,12 +226,64 @@ void MapManager::Update(uint32 diff)
         else
             iter->second->Update(uint32(i_timer.GetCurrent()));
     }
+
+    if (overlappedWork)
+        overlappedWork();
+
     if (m_updater.activated())
+    {
+        TC_METRIC_TIMER("map_update_wait_time");
         m_updater.wait();
+    }
 
     for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->DelayedUpdate(uint32(i_timer.GetCurrent()));
 
+    if (sMetric->IsEnabled())
+    {
+        std::array<uint32, MAX_MAP_UPDATE_TIERS> tierCounts = { };
+        DoForAllMaps([&tierCounts](Map* map) { ++tierCounts[map->GetUpdateTier()]; });
+
+        TC_METRIC_VALUE("map_update_tier", tierCounts[MAP_UPDATE_TIER_FULL], TC_METRIC_TAG("tier", "full"));
+        TC_METRIC_VALUE("map_update_tier", tierCounts[MAP_UPDATE_TIER_REDUCED], TC_METRIC_TAG("tier", "reduced"));
+        TC_METRIC_VALUE("map_update_tier", tierCounts[MAP_UPDATE_TIER_IDLE], TC_METRIC_TAG("tier", "idle"));
+
+        SmartAITimerStats smartTimers;
+        DoForAllMaps([&smartTimers](Map* map)
+        {
+            SmartAITimerStats const& stats = map->GetSmartAITimerStats();
+            smartTimers.Scheduled += stats.Scheduled;
+            smartTimers.Fired += stats.Fired;
+            smartTimers.Deferred += stats.Deferred;
+        });
+
+        TC_METRIC_VALUE("smartai_timers", smartTimers.Scheduled, TC_METRIC_TAG("type", "scheduled"));
+        TC_METRIC_VALUE("smartai_timers", smartTimers.Fired, TC_METRIC_TAG("type", "fired"));
+        TC_METRIC_VALUE("smartai_timers", smartTimers.Deferred, TC_METRIC_TAG("type", "deferred"));
+
+        CombatLogStats combatLogs;
+        DoForAllMaps([&combatLogs](Map* map)
+        {
+            CombatLogStats const& stats = map->GetCombatLogStats();
+            combatLogs.Built += stats.Built;
+            combatLogs.Skipped += stats.Skipped;
+        });
+
+        TC_METRIC_VALUE("combat_log_packets", combatLogs.Built, TC_METRIC_TAG("type", "built"));
+        TC_METRIC_VALUE("combat_log_packets", combatLogs.Skipped, TC_METRIC_TAG("type", "skipped"));
+
+        uint32 searchCellsFilled = 0;
+        uint32 searchCellsReused = 0;
+        DoForAllMaps([&searchCellsFilled, &searchCellsReused](Map* map)
+        {
+            searchCellsFilled += map->GetUnitSearchCache().GetFilledCount();
+            searchCellsReused += map->GetUnitSearchCache().GetReusedCount();
+        });
+
+        TC_METRIC_VALUE("unit_search_cells", searchCellsFilled, TC_METRIC_TAG("type", "filled"));
+        TC_METRIC_VALUE("unit_search_cells", searchCellsReused, TC_METRIC_TAG("type", "reused"));
+    }
+
     i_timer.SetCurrent(0);
 }
 
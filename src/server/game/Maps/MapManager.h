@@ -24,6 +24,7 @@
 #include "GridStates.h"
 #include "MapUpdater.h"
 #include <boost/dynamic_bitset.hpp>
+#include <functional>
 
 class Transport;
 struct TransportCreatureProto;
@@ -61,7 +62,12 @@ class TC_GAME_API MapManager
         void GetZoneAndAreaId(uint32 phaseMask, uint32& zoneid, uint32& areaid, WorldLocation const& loc) const { GetZoneAndAreaId(phaseMask, zoneid, areaid, loc.GetMapId(), loc); }
 
         void Initialize(void);
-        void Update(uint32);
+        void Update(uint32 diff) { Update(diff, nullptr); }
+
+        /// Updates all maps, calling overlappedWork on the calling thread while the map update threads are busy.
+        /// overlappedWork must not touch anything owned by maps, it is called after the maps were updated
+        /// if there are no map update threads.
+        void Update(uint32 diff, std::function<void()> const& overlappedWork);
 
         void SetGridCleanUpDelay(uint32 t)
         {
@@ -0,0 +1,115 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OpcodeStatistics.h"
+#include <algorithm>
+
+OpcodeStatistics::OpcodeStatistics() : _entries(new Entry[NUM_OPCODE_HANDLERS])
+{
+    Reset();
+}
+
+OpcodeStatistics::~OpcodeStatistics() = default;
+
+OpcodeStatistics* OpcodeStatistics::instance()
+{
+    static OpcodeStatistics instance;
+    return &instance;
+}
+
+std::size_t OpcodeStatistics::GetHistogramBucket(std::chrono::nanoseconds duration)
+{
+    uint64 microseconds = uint64(std::max<int64>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count(), 0));
+    std::size_t bucket = 0;
+    while (microseconds > 1 && bucket < HistogramBucketCount - 1)
+    {
+        microseconds >>= 1;
+        ++bucket;
+    }
+
+    return bucket;
+}
+
+void OpcodeStatistics::Record(OpcodeClient opcode, std::chrono::nanoseconds duration)
+{
+    if (uint32(opcode) >= NUM_OPCODE_HANDLERS)
+        return;
+
+    Entry& entry = _entries[opcode];
+    uint64 ns = uint64(std::max<int64>(duration.count(), 0));
+
+    entry.Count.fetch_add(1, std::memory_order_relaxed);
+    entry.TotalNs.fetch_add(ns, std::memory_order_relaxed);
+    entry.Histogram[GetHistogramBucket(duration)].fetch_add(1, std::memory_order_relaxed);
+
+    uint64 max = entry.MaxNs.load(std::memory_order_relaxed);
+    while (ns > max && !entry.MaxNs.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+        ;
+}
+
+std::vector<OpcodeStatistics::Summary> OpcodeStatistics::GetMostExpensive(std::size_t count) const
+{
+    std::vector<Summary> summaries;
+    for (uint32 opcode = 0; opcode < NUM_OPCODE_HANDLERS; ++opcode)
+    {
+        Entry const& entry = _entries[opcode];
+        uint64 calls = entry.Count.load(std::memory_order_relaxed);
+        if (!calls)
+            continue;
+
+        Summary& summary = summaries.emplace_back();
+        summary.Opcode = OpcodeClient(opcode);
+        summary.Count = calls;
+        summary.Total = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::nanoseconds(entry.TotalNs.load(std::memory_order_relaxed)));
+        summary.Max = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::nanoseconds(entry.MaxNs.load(std::memory_order_relaxed)));
+        summary.P99 = summary.Max;
+
+        // histogram buckets are read one by one while handlers keep running, so the sum may not match calls exactly
+        uint64 rank = calls - calls / 100;
+        uint64 seen = 0;
+        for (std::size_t bucket = 0; bucket < HistogramBucketCount - 1; ++bucket)
+        {
+            seen += entry.Histogram[bucket].load(std::memory_order_relaxed);
+            if (seen >= rank)
+            {
+                summary.P99 = std::min(std::chrono::microseconds(uint64(2) << bucket), summary.Max);
+                break;
+            }
+        }
+    }
+
+    std::size_t resultSize = std::min(count, summaries.size());
+    std::partial_sort(summaries.begin(), summaries.begin() + resultSize, summaries.end(), [](Summary const& left, Summary const& right)
+    {
+        return left.Total > right.Total;
+    });
+    summaries.resize(resultSize);
+    return summaries;
+}
+
+void OpcodeStatistics::Reset()
+{
+    for (uint32 opcode = 0; opcode < NUM_OPCODE_HANDLERS; ++opcode)
+    {
+        Entry& entry = _entries[opcode];
+        entry.Count.store(0, std::memory_order_relaxed);
+        entry.TotalNs.store(0, std::memory_order_relaxed);
+        entry.MaxNs.store(0, std::memory_order_relaxed);
+        for (std::atomic<uint64>& bucket : entry.Histogram)
+            bucket.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OpcodeStatistics_h__
+#define OpcodeStatistics_h__
+
+#include "Define.h"
+#include "Duration.h"
+#include "Opcodes.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/// Realm wide accounting of the time spent in client opcode handlers.
+/// Handlers run on the world and map threads at the same time, so every counter is a relaxed atomic.
+class TC_GAME_API OpcodeStatistics
+{
+public:
+    /// Bucket i counts handler calls that took less than 2^(i + 1) microseconds, the last bucket takes everything slower
+    static constexpr std::size_t HistogramBucketCount = 20;
+
+    struct Summary
+    {
+        OpcodeClient Opcode;
+        uint64 Count;
+        std::chrono::microseconds Total;
+        std::chrono::microseconds Max;
+        std::chrono::microseconds P99;  // upper bound of the histogram bucket containing the 99th percentile
+    };
+
+    static OpcodeStatistics* instance();
+
+    void Record(OpcodeClient opcode, std::chrono::nanoseconds duration);
+
+    /// Opcodes ordered by total handler time, most expensive first
+    std::vector<Summary> GetMostExpensive(std::size_t count) const;
+
+    void Reset();
+
+    static std::size_t GetHistogramBucket(std::chrono::nanoseconds duration);
+
+    OpcodeStatistics();
+    ~OpcodeStatistics();
+
+private:
+    struct Entry
+    {
+        std::atomic<uint64> Count;
+        std::atomic<uint64> TotalNs;
+        std::atomic<uint64> MaxNs;
+        std::array<std::atomic<uint64>, HistogramBucketCount> Histogram;
+    };
+
+    std::unique_ptr<Entry[]> _entries;
+};
+
+#define sOpcodeStatistics OpcodeStatistics::instance()
+
+#endif // OpcodeStatistics_h__
@@ -22,6 +22,8 @@
 #include "Opcodes.h"
 #include "ByteBuffer.h"
 #include "Duration.h"
+#include <atomic>
+#include <memory>
 
 class WorldPacket : public ByteBuffer
 {
@@ -82,9 +84,31 @@ class WorldPacket : public ByteBuffer
 
         TimePoint GetReceivedTime() const { return m_receivedTime; }
 
+        std::atomic<WorldPacket*> SessionQueueLink; // WorldSession receive queue, not copied with the packet
+
     protected:
         uint16 m_opcode;
         TimePoint m_receivedTime; // only set for a specific set of opcodes, for performance reasons.
 };
 
+/// Packet sent unchanged to many sessions. The payload is copied once, on first use, and all
+/// recipients queue the same immutable copy - sockets only add their own (encrypted) header
+class SharedWorldPacket
+{
+    public:
+        explicit SharedWorldPacket(WorldPacket const* packet) : m_packet(packet) { }
+
+        std::shared_ptr<WorldPacket const> const& Get() const
+        {
+            if (!m_shared)
+                m_shared = std::make_shared<WorldPacket const>(*m_packet);
+
+            return m_shared;
+        }
+
+    private:
+        WorldPacket const* m_packet;
+        mutable std::shared_ptr<WorldPacket const> m_shared;
+};
+
 #endif
@@ -40,6 +40,7 @@
 #include "MoveSpline.h"
 #include "ObjectMgr.h"
 #include "Opcodes.h"
+#include "OpcodeStatistics.h"
 #include "OutdoorPvPMgr.h"
 #include "PacketUtilities.h"
 #include "Player.h"
@@ -47,6 +48,7 @@
 #include "ScriptMgr.h"
 #include "SocialMgr.h"
 #include "QueryHolder.h"
+#include "TickProfiler.h"
 #include "Vehicle.h"
 #include "WardenMac.h"
 #include "WardenWin.h"
@@ -171,9 +173,12 @@ WorldSession::~WorldSession()
 
     ///- empty incoming packet queue
     WorldPacket* packet = nullptr;
-    while (_recvQueue.next(packet))
+    while (_recvQueue.Dequeue(packet))
         delete packet;
 
+    for (WorldPacket* pendingPacket : _pendingRecvPackets)
+        delete pendingPacket;
+
     LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = %u;", GetAccountId());     // One-time query
 }
 
@@ -204,10 +209,23 @@ ObjectGuid::LowType WorldSession::GetGUIDLow() const
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const* packet)
 {
-    ASSERT(packet->GetOpcode() != NULL_OPCODE);
+    if (PrepareSendPacket(*packet))
+        m_Socket->SendPacket(*packet);
+}
+
+/// Send a packet shared with other sessions, its payload is not copied
+void WorldSession::SendPacket(std::shared_ptr<WorldPacket const> const& packet)
+{
+    if (PrepareSendPacket(*packet))
+        m_Socket->SendPacket(packet);
+}
+
+bool WorldSession::PrepareSendPacket(WorldPacket const& packet)
+{
+    ASSERT(packet.GetOpcode() != NULL_OPCODE);
 
     if (!m_Socket)
-        return;
+        return false;
 
 #ifdef TRINITY_DEBUG
     // Code for network use statistic
@@ -225,10 +243,10 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     if ((cur_time - lastTime) < 60)
     {
         sendPacketCount += 1;
-        sendPacketBytes += packet->size();
+        sendPacketBytes += packet.size();
 
         sendLastPacketCount += 1;
-        sendLastPacketBytes += packet->size();
+        sendLastPacketBytes += packet.size();
     }
     else
     {
@@ -239,20 +257,20 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 
         lastTime = cur_time;
         sendLastPacketCount = 1;
-        sendLastPacketBytes = packet->wpos();               // wpos is real written size
+        sendLastPacketBytes = packet.wpos();                // wpos is real written size
     }
 #endif                                                      // !TRINITY_DEBUG
 
-    sScriptMgr->OnPacketSend(this, *packet);
+    sScriptMgr->OnPacketSend(this, packet);
 
-    TC_LOG_TRACE("network.opcode", "S->C: %s %s", GetPlayerInfo().c_str(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())).c_str());
-    m_Socket->SendPacket(*packet);
+    TC_LOG_TRACE("network.opcode", "S->C: %s %s", GetPlayerInfo().c_str(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet.GetOpcode())).c_str());
+    return true;
 }
 
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
-    _recvQueue.add(new_packet);
+    _recvQueue.Enqueue(new_packet);
 }
 
 /// Logging helper for unexpected opcodes
@@ -290,12 +308,25 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     std::vector<WorldPacket*> requeuePackets;
     uint32 processedPackets = 0;
     time_t currentTime = GameTime::GetGameTime();
+    std::chrono::microseconds const timeBudget(sWorld->getIntConfig(CONFIG_SESSION_UPDATE_TIME_BUDGET));
+    std::chrono::nanoseconds timeSpent(0);
+
+    // take over everything the network thread queued so far, behind the packets left over from previous updates.
+    // Map and world thread never update the same session at the same time so the pending list needs no lock
+    while (_recvQueue.Dequeue(packet))
+        _pendingRecvPackets.push_back(packet);
 
-    while (m_Socket && _recvQueue.next(packet, updater))
+    // stop at the first packet that belongs to the other thread to keep the order the client sent them in
+    while (m_Socket && !_pendingRecvPackets.empty() && updater.Process(_pendingRecvPackets.front()))
     {
+        packet = _pendingRecvPackets.front();
+        _pendingRecvPackets.pop_front();
+
         OpcodeClient opcode = static_cast<OpcodeClient>(packet->GetOpcode());
         ClientOpcodeHandler const* opHandle = opcodeTable[opcode];
         TC_METRIC_DETAILED_TIMER("worldsession_update_opcode_time", TC_METRIC_TAG("opcode", opHandle->Name));
+        TC_PROFILE_ZONE(opHandle->Name);
+        TimePoint packetStart = std::chrono::steady_clock::now();
 
         try
         {
@@ -410,6 +441,10 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
         deletePacket = true;
 
+        std::chrono::nanoseconds packetTime = std::chrono::steady_clock::now() - packetStart;
+        sOpcodeStatistics->Record(opcode, packetTime);
+        timeSpent += packetTime;
+
 #define MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE 100
         processedPackets++;
 
@@ -417,11 +452,21 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
         //Any leftover will be processed in next update
         if (processedPackets > MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE)
             break;
+
+        //stop once this session used up its handler time for this update, so a client flooding expensive opcodes
+        //can't stall the map it is on. The remaining packets stay queued for the next update
+        if (timeBudget.count() && timeSpent >= timeBudget)
+        {
+            TC_LOG_DEBUG("network", "%s used " SI64FMTD " us of handler time in one update, deferring remaining packets",
+                GetPlayerInfo().c_str(), int64(std::chrono::duration_cast<std::chrono::microseconds>(timeSpent).count()));
+            TC_METRIC_VALUE("session_update_budget_exceeded", uint64(1));
+            break;
+        }
     }
 
     TC_METRIC_VALUE("processed_packets", processedPackets);
 
-    _recvQueue.readd(requeuePackets.begin(), requeuePackets.end());
+    _pendingRecvPackets.insert(_pendingRecvPackets.begin(), requeuePackets.begin(), requeuePackets.end());
 
     if (!updater.ProcessUnsafe()) // <=> updater is of type MapSessionFilter
     {
@@ -1202,6 +1247,7 @@ void WorldSession::SetPlayer(Player* player)
 
 void WorldSession::ProcessQueryCallbacks()
 {
+    TC_PROFILE_ZONE("WorldSession::ProcessQueryCallbacks");
     _queryProcessor.ProcessReadyCallbacks();
     _transactionCallbacks.ProcessReadyCallbacks();
     _queryHolderProcessor.ProcessReadyCallbacks();
@@ -26,13 +26,14 @@
 #include "AsyncCallbackProcessor.h"
 #include "AuthDefines.h"
 #include "DatabaseEnvFwd.h"
-#include "LockedQueue.h"
+#include "MPSCQueue.h"
 #include "ObjectGuid.h"
 #include "Packet.h"
 #include "SharedDefines.h"
-#include <string>
+#include <deque>
 #include <map>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <boost/circular_buffer.hpp>
 
@@ -414,6 +415,7 @@ class TC_GAME_API WorldSession
         void static WriteMovementInfo(WorldPacket* data, MovementInfo* mi);
 
         void SendPacket(WorldPacket const* packet);
+        void SendPacket(std::shared_ptr<WorldPacket const> const& packet);
         void SendNotification(const char *format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(uint32 string_id, ...);
         void SendPetNameInvalid(uint32 error, std::string const& name, DeclinedName *declinedName);
@@ -1161,6 +1163,9 @@ class TC_GAME_API WorldSession
 
         bool CanUseBank(ObjectGuid bankerGUID = ObjectGuid::Empty) const;
 
+        // statistics, logging and script hooks of outgoing packets, returns false if there is no socket to send to
+        bool PrepareSendPacket(WorldPacket const& packet);
+
         // logging helper
         void LogUnexpectedOpcode(WorldPacket* packet, char const* status, const char *reason);
         void LogUnprocessedTail(WorldPacket* packet);
@@ -1227,7 +1232,8 @@ class TC_GAME_API WorldSession
         } _addons;
         uint32 recruiterId;
         bool isRecruiter;
-        LockedQueue<WorldPacket*> _recvQueue;
+        MPSCQueue<WorldPacket, &WorldPacket::SessionQueueLink> _recvQueue;    // filled by the network thread
+        std::deque<WorldPacket*> _pendingRecvPackets;                           // only touched by the thread running Update()
         rbac::RBACData* _RBACData;
         uint32 expireTime;
         bool forceExit;
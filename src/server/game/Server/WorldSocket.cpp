@@ -84,28 +84,29 @@ bool WorldSocket::Update()
     MessageBuffer buffer(_sendBufferSize);
     while (_bufferQueue.Dequeue(queued))
     {
-        ServerPktHeader header(queued->size() + 2, queued->GetOpcode());
+        WorldPacket const& packet = queued->GetPacket();
+        ServerPktHeader header(packet.size() + 2, packet.GetOpcode());
         if (queued->NeedsEncryption())
             _authCrypt.EncryptSend(header.header, header.getHeaderLength());
 
-        if (buffer.GetRemainingSpace() < queued->size() + header.getHeaderLength())
+        if (buffer.GetRemainingSpace() < packet.size() + header.getHeaderLength())
         {
             QueuePacket(std::move(buffer));
             buffer.Resize(_sendBufferSize);
         }
 
-        if (buffer.GetRemainingSpace() >= queued->size() + header.getHeaderLength())
+        if (buffer.GetRemainingSpace() >= packet.size() + header.getHeaderLength())
         {
             buffer.Write(header.header, header.getHeaderLength());
-            if (!queued->empty())
-                buffer.Write(queued->contents(), queued->size());
+            if (!packet.empty())
+                buffer.Write(packet.contents(), packet.size());
         }
         else    // single packet larger than 4096 bytes
         {
-            MessageBuffer packetBuffer(queued->size() + header.getHeaderLength());
+            MessageBuffer packetBuffer(packet.size() + header.getHeaderLength());
             packetBuffer.Write(header.header, header.getHeaderLength());
-            if (!queued->empty())
-                packetBuffer.Write(queued->contents(), queued->size());
+            if (!packet.empty())
+                packetBuffer.Write(packet.contents(), packet.size());
 
             QueuePacket(std::move(packetBuffer));
         }
@@ -416,6 +417,17 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
 }
 
+void WorldSocket::SendPacket(std::shared_ptr<WorldPacket const> const& packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (sPacketLog->CanLogPacket())
+        sPacketLog->LogPacket(*packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
+
+    _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
+}
+
 void WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
 {
     std::shared_ptr<AuthSession> authSession = std::make_shared<AuthSession>();
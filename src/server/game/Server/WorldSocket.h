@@ -29,19 +29,27 @@
 #include <boost/asio/ip/tcp.hpp>
 
 using boost::asio::ip::tcp;
-class EncryptablePacket : public WorldPacket
+class EncryptablePacket
 {
 public:
-    EncryptablePacket(WorldPacket const& packet, bool encrypt) : WorldPacket(packet), _encrypt(encrypt)
+    EncryptablePacket(WorldPacket const& packet, bool encrypt) : _packet(packet), _encrypt(encrypt)
     {
         SocketQueueLink.store(nullptr, std::memory_order_relaxed);
     }
 
+    EncryptablePacket(std::shared_ptr<WorldPacket const> packet, bool encrypt) : _sharedPacket(std::move(packet)), _encrypt(encrypt)
+    {
+        SocketQueueLink.store(nullptr, std::memory_order_relaxed);
+    }
+
+    WorldPacket const& GetPacket() const { return _sharedPacket ? *_sharedPacket : _packet; }
     bool NeedsEncryption() const { return _encrypt; }
 
     std::atomic<EncryptablePacket*> SocketQueueLink;
 
 private:
+    WorldPacket _packet;                                // own copy, empty when the payload is shared
+    std::shared_ptr<WorldPacket const> _sharedPacket;   // payload of a broadcast, shared with other sockets
     bool _encrypt;
 };
 
@@ -79,6 +87,7 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    void SendPacket(std::shared_ptr<WorldPacket const> const& packet);
 
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
 
@@ -0,0 +1,82 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuraModifierCache.h"
+
+bool AuraModifierCache::GetModifier(AuraType type, AuraModifierTotal total, AuraModifierFilter filter, int32 misc, int32& modifier) const
+{
+    if (!_cachedTypes[type])
+        return false;
+
+    auto itr = _values.find(MakeKey(type, total, filter, misc));
+    if (itr == _values.end())
+        return false;
+
+    modifier = itr->second.Modifier;
+    return true;
+}
+
+bool AuraModifierCache::GetMultiplier(AuraType type, AuraModifierFilter filter, int32 misc, float& multiplier) const
+{
+    if (!_cachedTypes[type])
+        return false;
+
+    auto itr = _values.find(MakeKey(type, AuraModifierTotal::Multiplier, filter, misc));
+    if (itr == _values.end())
+        return false;
+
+    multiplier = itr->second.Multiplier;
+    return true;
+}
+
+void AuraModifierCache::StoreModifier(AuraType type, AuraModifierTotal total, AuraModifierFilter filter, int32 misc, int32 modifier)
+{
+    _values[MakeKey(type, total, filter, misc)].Modifier = modifier;
+    _cachedTypes.set(type);
+}
+
+void AuraModifierCache::StoreMultiplier(AuraType type, AuraModifierFilter filter, int32 misc, float multiplier)
+{
+    _values[MakeKey(type, AuraModifierTotal::Multiplier, filter, misc)].Multiplier = multiplier;
+    _cachedTypes.set(type);
+}
+
+void AuraModifierCache::Invalidate(AuraType type)
+{
+    if (!_cachedTypes[type])
+        return;
+
+    for (auto itr = _values.begin(); itr != _values.end();)
+    {
+        if (GetKeyType(itr->first) == type)
+            itr = _values.erase(itr);
+        else
+            ++itr;
+    }
+
+    _cachedTypes.reset(type);
+}
+
+void AuraModifierCache::ValidateSpellGroups(uint32 spellGroupGeneration)
+{
+    if (_spellGroupGeneration == spellGroupGeneration)
+        return;
+
+    _values.clear();
+    _cachedTypes.reset();
+    _spellGroupGeneration = spellGroupGeneration;
+}
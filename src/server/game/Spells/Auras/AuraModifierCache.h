@@ -0,0 +1,79 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AuraModifierCache_h__
+#define AuraModifierCache_h__
+
+#include "Define.h"
+#include "SpellAuraDefines.h"
+#include <bitset>
+#include <unordered_map>
+
+enum class AuraModifierTotal : uint8
+{
+    Modifier,
+    Multiplier,
+    MaxPositiveModifier,
+    MaxNegativeModifier
+};
+
+enum class AuraModifierFilter : uint8
+{
+    None,
+    MiscMask,
+    MiscValue
+};
+
+/// Results of the predicate free Unit::GetTotalAuraModifier family, keyed by aura type, kind of total and misc value filter.
+/// All entries of an aura type are dropped when an effect of that type is applied, removed or changes its amount.
+class TC_GAME_API AuraModifierCache
+{
+public:
+    AuraModifierCache() : _spellGroupGeneration(0) { }
+
+    bool GetModifier(AuraType type, AuraModifierTotal total, AuraModifierFilter filter, int32 misc, int32& modifier) const;
+    bool GetMultiplier(AuraType type, AuraModifierFilter filter, int32 misc, float& multiplier) const;
+    void StoreModifier(AuraType type, AuraModifierTotal total, AuraModifierFilter filter, int32 misc, int32 modifier);
+    void StoreMultiplier(AuraType type, AuraModifierFilter filter, int32 misc, float multiplier);
+
+    void Invalidate(AuraType type);
+
+    /// Stacking rules come from the spell_group tables, totals cached before a reload are dropped
+    void ValidateSpellGroups(uint32 spellGroupGeneration);
+
+    std::size_t Size() const { return _values.size(); }
+
+private:
+    union CachedValue
+    {
+        int32 Modifier;
+        float Multiplier;
+    };
+
+    static uint64 MakeKey(AuraType type, AuraModifierTotal total, AuraModifierFilter filter, int32 misc)
+    {
+        return uint64(type) << 40 | uint64(total) << 36 | uint64(filter) << 32 | uint32(misc);
+    }
+
+    static AuraType GetKeyType(uint64 key) { return AuraType(key >> 40); }
+
+    std::unordered_map<uint64, CachedValue> _values;
+    std::bitset<TOTAL_AURAS> _cachedTypes;
+    uint32 _spellGroupGeneration;
+};
+
+#endif // AuraModifierCache_h__
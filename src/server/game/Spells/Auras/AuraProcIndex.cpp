@@ -0,0 +1,67 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuraProcIndex.h"
+#include <algorithm>
+
+void AuraProcIndex::Insert(uint32 spellId, uint32 procFlags, AuraApplication* aurApp)
+{
+    if (!procFlags)
+        return;
+
+    // behind all entries of the same spell, matching std::multimap::insert
+    auto itr = std::upper_bound(_entries.begin(), _entries.end(), spellId, [](uint32 id, Entry const& entry)
+    {
+        return id < entry.SpellId;
+    });
+
+    _entries.insert(itr, { spellId, procFlags, aurApp });
+    _procFlags |= procFlags;
+}
+
+void AuraProcIndex::Remove(AuraApplication* aurApp)
+{
+    auto itr = std::find_if(_entries.begin(), _entries.end(), [aurApp](Entry const& entry)
+    {
+        return entry.AurApp == aurApp;
+    });
+
+    if (itr == _entries.end())
+        return;
+
+    _entries.erase(itr);
+
+    _procFlags = 0;
+    for (Entry const& entry : _entries)
+        _procFlags |= entry.ProcFlags;
+}
+
+void AuraProcIndex::Clear()
+{
+    _entries.clear();
+    _procFlags = 0;
+}
+
+void AuraProcIndex::Collect(uint32 typeMask, Candidates& auras) const
+{
+    if (!(_procFlags & typeMask))
+        return;
+
+    for (Entry const& entry : _entries)
+        if (entry.ProcFlags & typeMask)
+            auras.push_back(entry.AurApp);
+}
@@ -0,0 +1,60 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AuraProcIndex_h__
+#define AuraProcIndex_h__
+
+#include "Define.h"
+#include <boost/container/small_vector.hpp>
+#include <vector>
+
+class AuraApplication;
+
+/// Applied auras of a unit that have a spell_proc entry, together with the proc flags they react to.
+/// Entries are kept ordered by spell id like Unit::m_appliedAuras so procs keep triggering in the same order,
+/// the union of all proc flags lets events nobody reacts to return without touching any aura.
+class TC_GAME_API AuraProcIndex
+{
+public:
+    // few auras react to a single event, kept on the stack of the proc handling code
+    typedef boost::container::small_vector<AuraApplication*, 8> Candidates;
+
+    AuraProcIndex() : _procFlags(0) { }
+
+    void Insert(uint32 spellId, uint32 procFlags, AuraApplication* aurApp);
+    void Remove(AuraApplication* aurApp);
+    void Clear();
+
+    /// Appends auras reacting to any of the proc flags in typeMask
+    void Collect(uint32 typeMask, Candidates& auras) const;
+
+    uint32 GetProcFlags() const { return _procFlags; }
+    std::size_t Size() const { return _entries.size(); }
+
+private:
+    struct Entry
+    {
+        uint32 SpellId;
+        uint32 ProcFlags;
+        AuraApplication* AurApp;
+    };
+
+    std::vector<Entry> _entries;
+    uint32 _procFlags;
+};
+
+#endif // AuraProcIndex_h__
@@ -656,6 +656,16 @@ void AuraEffect::CalculateSpellMod()
     GetBase()->CallScriptEffectCalcSpellModHandlers(this, m_spellmod);
 }
 
+void AuraEffect::SetAmount(int32 amount)
+{
+    _amount = amount;
+    m_canBeRecalculated = false;
+
+    // modifier totals cached by the targets include the old amount
+    for (auto const& pair : GetBase()->GetApplicationMap())
+        pair.second->GetTarget()->InvalidateAuraModifierCache(GetAuraType());
+}
+
 void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
 {
     // Reapply if amount change
@@ -2690,8 +2690,7 @@ void UnitAura::FillTargetMap(std::unordered_map<Unit*, uint8>& targets, Unit* ca
         if (selectionType != TARGET_CHECK_DEFAULT)
         {
             Trinity::WorldObjectSpellAreaTargetCheck check(radius, GetUnitOwner(), ref, GetUnitOwner(), m_spellInfo, selectionType, condList);
-            Trinity::UnitListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> searcher(GetUnitOwner(), units, check);
-            Cell::VisitAllObjects(GetUnitOwner(), searcher, radius);
+            Trinity::SearchUnitsInCachedCells(GetUnitOwner(), units, check, radius);
         }
 
         for (Unit* unit : units)
@@ -2738,6 +2737,7 @@ void DynObjAura::FillTargetMap(std::unordered_map<Unit*, uint8>& targets, Unit*
     Unit* dynObjOwnerCaster = GetDynobjOwner()->GetCaster();
     float radius = GetDynobjOwner()->GetRadius();
 
+    SpellTargetCheckTypes selectionTypes[MAX_SPELL_EFFECTS];
     for (uint8 effIndex = 0; effIndex < MAX_SPELL_EFFECTS; ++effIndex)
     {
         if (!HasEffect(effIndex))
@@ -2748,12 +2748,26 @@ void DynObjAura::FillTargetMap(std::unordered_map<Unit*, uint8>& targets, Unit*
         if (m_spellInfo->Effects[effIndex].TargetB.GetReferenceType() == TARGET_REFERENCE_TYPE_DEST)
             selectionType = m_spellInfo->Effects[effIndex].TargetB.GetCheckType();
 
-        std::vector<Unit*> units;
+        selectionTypes[effIndex] = selectionType;
         ConditionContainer* condList = m_spellInfo->Effects[effIndex].ImplicitTargetConditions;
 
+        // effects with the same check around the same dynobject select the same units, reuse the earlier search
+        uint8 sameTargetsEffIndex = 0;
+        while (sameTargetsEffIndex < effIndex && (!HasEffect(sameTargetsEffIndex) || selectionTypes[sameTargetsEffIndex] != selectionType
+            || m_spellInfo->Effects[sameTargetsEffIndex].ImplicitTargetConditions != condList))
+            ++sameTargetsEffIndex;
+
+        if (sameTargetsEffIndex < effIndex)
+        {
+            for (auto& target : targets)
+                if (target.second & (1 << sameTargetsEffIndex))
+                    target.second |= 1 << effIndex;
+            continue;
+        }
+
+        std::vector<Unit*> units;
         Trinity::WorldObjectSpellAreaTargetCheck check(radius, GetDynobjOwner(), dynObjOwnerCaster, dynObjOwnerCaster, m_spellInfo, selectionType, condList);
-        Trinity::UnitListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> searcher(GetDynobjOwner(), units, check);
-        Cell::VisitAllObjects(GetDynobjOwner(), searcher, radius);
+        Trinity::SearchUnitsInCachedCells(GetDynobjOwner(), units, check, radius);
 
         for (Unit* unit : units)
             targets[unit] |= 1 << effIndex;
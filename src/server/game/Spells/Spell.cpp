@@ -50,6 +50,7 @@
 #include "SpellPackets.h"
 #include "SpellScript.h"
 #include "TemporarySummon.h"
+#include "TickProfiler.h"
 #include "TradeData.h"
 #include "Unit.h"
 #include "UpdateData.h"
@@ -539,6 +540,9 @@ m_caster((info->HasAttribute(SPELL_ATTR6_CAST_BY_CHARMER) && caster->GetCharmerO
     m_auraScaleMask = 0;
     memset(m_damageMultipliers, 0, sizeof(m_damageMultipliers));
 
+    m_damageLogReceiversFound = false;
+    m_shareDamageLogReceivers = false;
+
     // Get data for type of attack
     m_attackType = info->GetAttackType();
 
@@ -2521,7 +2525,7 @@ void Spell::TargetInfo::DoDamageAndTriggers(Spell* spell)
                 Unit::DealDamageMods(damageInfo.target, damageInfo.damage, &damageInfo.absorb);
 
                 // Send log damage message to client
-                caster->SendSpellNonMeleeDamageLog(&damageInfo);
+                spell->SendDamageLog(caster, &damageInfo);
 
                 hitMask |= createProcHitMask(&damageInfo, MissCondition);
                 procVictim |= PROC_FLAG_TAKEN_DAMAGE;
@@ -3521,8 +3525,15 @@ void Spell::DoProcessTargetContainer(Container& targetContainer)
             if (target.EffectMask & (1 << i))
                 target.DoTargetSpellHit(this, i);
 
+    // every damage log of this hit comes from the same caster, find the receivers only once
+    m_damageLogReceivers.clear();
+    m_damageLogReceiversFound = false;
+    m_shareDamageLogReceivers = targetContainer.size() > 1;
+
     for (TargetInfoBase& target : targetContainer)
         target.DoDamageAndTriggers(this);
+
+    m_shareDamageLogReceivers = false;
 }
 
 void Spell::handle_immediate()
@@ -3747,6 +3758,7 @@ void Spell::SendSpellCooldown()
 
 void Spell::update(uint32 difftime)
 {
+    TC_PROFILE_ZONE("Spell::update");
     // update pointers based at it's GUIDs
     if (!UpdatePointers())
     {
@@ -7783,6 +7795,46 @@ void Spell::FinishTargetProcessing()
     SendLogExecute();
 }
 
+void Spell::SendDamageLog(Unit* caster, SpellNonMeleeDamage* damageInfo)
+{
+    if (!m_shareDamageLogReceivers)
+    {
+        caster->SendSpellNonMeleeDamageLog(damageInfo);
+        return;
+    }
+
+    // the first log of a multi target hit looks up the receivers, the following ones reuse them.
+    // Each log is still sent before its damage is dealt
+    if (!m_damageLogReceiversFound)
+    {
+        m_damageLogReceiversFound = true;
+        caster->SendCombatLogMessage([damageInfo](WorldPacket* data)
+        {
+            Unit::BuildSpellNonMeleeDamageLog(damageInfo, data);
+            return true;
+        }, &m_damageLogReceivers);
+        return;
+    }
+
+    CombatLogStats& stats = caster->GetMap()->GetCombatLogStats();
+    Player* self = caster->ToPlayer();
+    if (!self && m_damageLogReceivers.empty())
+    {
+        ++stats.Skipped;
+        return;
+    }
+
+    ++stats.Built;
+    WorldPacket data;
+    Unit::BuildSpellNonMeleeDamageLog(damageInfo, &data);
+    if (self)
+        self->SendDirectMessage(&data);
+
+    SharedWorldPacket shared(&data);
+    for (Player* receiver : m_damageLogReceivers)
+        receiver->SendDirectMessage(shared.Get());
+}
+
 void Spell::InitEffectExecuteData(uint8 effIndex)
 {
     ASSERT(effIndex < MAX_SPELL_EFFECTS);
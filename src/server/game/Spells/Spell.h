@@ -54,6 +54,7 @@ class Unit;
 class UnitAura;
 class WorldObject;
 class WorldPacket;
+struct SpellNonMeleeDamage;
 struct SummonPropertiesEntry;
 enum AuraType : uint32;
 enum CurrentSpellTypes : uint8;
@@ -809,6 +810,12 @@ class TC_GAME_API Spell
 
         ByteBuffer* m_effectExecuteData[MAX_SPELL_EFFECTS];
 
+        // receivers of SMSG_SPELLNONMELEEDAMAGELOG, shared by all targets processed in one DoProcessTargetContainer call
+        std::vector<Player*> m_damageLogReceivers;
+        bool m_damageLogReceiversFound;
+        bool m_shareDamageLogReceivers;
+        void SendDamageLog(Unit* caster, SpellNonMeleeDamage* damageInfo);
+
         Spell(Spell const& right) = delete;
         Spell& operator=(Spell const& right) = delete;
 };
@@ -54,7 +54,7 @@ bool IsPartOfSkillLine(uint32 skillId, uint32 spellId)
     return false;
 }
 
-SpellMgr::SpellMgr() { }
+SpellMgr::SpellMgr() : mSpellProcGeneration(0), mSpellGroupGeneration(0) { }
 
 SpellMgr::~SpellMgr()
 {
@@ -401,7 +401,7 @@ void SpellMgr::GetSetOfSpellsInSpellGroup(SpellGroup group_id, std::set<uint32>&
     }
 }
 
-bool SpellMgr::AddSameEffectStackRuleSpellGroups(SpellInfo const* spellInfo, uint32 auraType, int32 amount, std::map<SpellGroup, int32>& groups) const
+bool SpellMgr::AddSameEffectStackRuleSpellGroups(SpellInfo const* spellInfo, uint32 auraType, int32 amount, SameEffectSpellGroupAmounts& groups) const
 {
     uint32 spellId = spellInfo->GetFirstRankSpell()->Id;
     auto spellGroupBounds = GetSpellSpellGroupMapBounds(spellId);
@@ -416,15 +416,17 @@ bool SpellMgr::AddSameEffectStackRuleSpellGroups(SpellInfo const* spellInfo, uin
             if (!found->second.count(auraType))
                 continue;
 
-            // Put the highest amount in the map
-            auto groupItr = groups.find(group);
+            // Put the highest amount in the list
+            auto groupItr = std::find_if(groups.begin(), groups.end(), [group](std::pair<SpellGroup, int32> const& groupAmount)
+            {
+                return groupAmount.first == group;
+            });
             if (groupItr == groups.end())
-                groups.emplace(group, amount);
+                groups.emplace_back(group, amount);
             else
             {
-                int32 curr_amount = groups[group];
                 // Take absolute value because this also counts for the highest negative aura
-                if (std::abs(curr_amount) < std::abs(amount))
+                if (std::abs(groupItr->second) < std::abs(amount))
                     groupItr->second = amount;
             }
             // return because a spell should be in only one SPELL_GROUP_STACK_RULE_EXCLUSIVE_SAME_EFFECT group per auraType
@@ -1289,6 +1291,7 @@ void SpellMgr::LoadSpellGroups()
 
     mSpellSpellGroup.clear();                                  // need for reload case
     mSpellGroupSpell.clear();
+    ++mSpellGroupGeneration;                                   // units drop their cached aura modifier totals
 
     //                                                0     1
     QueryResult result = WorldDatabase.Query("SELECT id, spell_id FROM spell_group");
@@ -1368,6 +1371,7 @@ void SpellMgr::LoadSpellGroupStackRules()
 
     mSpellGroupStack.clear();                                  // need for reload case
     mSpellSameEffectStack.clear();
+    ++mSpellGroupGeneration;                                   // units drop their cached aura modifier totals
 
     std::vector<uint32> sameEffectGroups;
 
@@ -1519,6 +1523,7 @@ void SpellMgr::LoadSpellProcs()
     uint32 oldMSTime = getMSTime();
 
     mSpellProcMap.clear();                             // need for reload case
+    ++mSpellProcGeneration;                            // units rebuild their proc aura index on next proc
 
     //                                                     0           1                2                 3                 4                 5
     QueryResult result = WorldDatabase.Query("SELECT SpellId, SchoolMask, SpellFamilyName, SpellFamilyMask0, SpellFamilyMask1, SpellFamilyMask2, "
@@ -31,6 +31,7 @@
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
+#include <boost/container/small_vector.hpp>
 
 class SpellInfo;
 class Player;
@@ -335,6 +336,9 @@ typedef std::unordered_map<SpellGroup, SpellGroupStackRule> SpellGroupStackMap;
 
 typedef std::unordered_map<SpellGroup, std::unordered_set<uint32 /*auraName*/>> SameEffectStackMap;
 
+// highest amount per SPELL_GROUP_STACK_RULE_EXCLUSIVE_SAME_EFFECT group while summing the aura effects of a unit
+typedef boost::container::small_vector<std::pair<SpellGroup, int32>, 4> SameEffectSpellGroupAmounts;
+
 struct SpellThreatEntry
 {
     int32       flatMod;                                    // flat threat-value for this Spell  - default: 0
@@ -622,12 +626,14 @@ class TC_GAME_API SpellMgr
         void GetSetOfSpellsInSpellGroup(SpellGroup group_id, std::set<uint32>& foundSpells, std::set<SpellGroup>& usedGroups) const;
 
         // Spell Group Stack Rules table
-        bool AddSameEffectStackRuleSpellGroups(SpellInfo const* spellInfo, uint32 auraType, int32 amount, std::map<SpellGroup, int32>& groups) const;
+        bool AddSameEffectStackRuleSpellGroups(SpellInfo const* spellInfo, uint32 auraType, int32 amount, SameEffectSpellGroupAmounts& groups) const;
+        uint32 GetSpellGroupsGeneration() const { return mSpellGroupGeneration; } // changes whenever spell_group or its stack rules are (re)loaded
         SpellGroupStackRule CheckSpellGroupStackRules(SpellInfo const* spellInfo1, SpellInfo const* spellInfo2) const;
         SpellGroupStackRule GetSpellGroupStackRule(SpellGroup groupid) const;
 
         // Spell proc table
         SpellProcEntry const* GetSpellProcEntry(uint32 spellId) const;
+        uint32 GetSpellProcsGeneration() const { return mSpellProcGeneration; } // changes whenever spell_proc is (re)loaded
         static bool CanSpellTriggerProcOnEvent(SpellProcEntry const& procEntry, ProcEventInfo& eventInfo);
 
         // Spell bonus data table
@@ -716,6 +722,8 @@ class TC_GAME_API SpellMgr
         SpellGroupStackMap         mSpellGroupStack;
         SameEffectStackMap         mSpellSameEffectStack;
         SpellProcMap               mSpellProcMap;
+        uint32                     mSpellProcGeneration;
+        uint32                     mSpellGroupGeneration;
         SpellBonusMap              mSpellBonusMap;
         SpellThreatMap             mSpellThreatMap;
         SpellPetAuraMap            mSpellPetAuraMap;
@@ -34,28 +34,27 @@ void WhoListStorageMgr::Update()
     _whoListStorage.clear();
     _whoListStorage.reserve(sWorld->GetPlayerCount()+1);
 
-    HashMapHolder<Player>::MapType const& m = ObjectAccessor::GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+    ObjectAccessor::GetPlayers().DoForAll([this](ObjectGuid const& /*guid*/, Player* player)
     {
-        if (!itr->second->FindMap() || itr->second->GetSession()->PlayerLoading())
-            continue;
+        if (!player->FindMap() || player->GetSession()->PlayerLoading())
+            return;
 
-        std::string playerName = itr->second->GetName();
+        std::string playerName = player->GetName();
         std::wstring widePlayerName;
         if (!Utf8toWStr(playerName, widePlayerName))
-            continue;
+            return;
 
         wstrToLower(widePlayerName);
 
-        std::string guildName = sGuildMgr->GetGuildNameById(itr->second->GetGuildId());
+        std::string guildName = sGuildMgr->GetGuildNameById(player->GetGuildId());
         std::wstring wideGuildName;
         if (!Utf8toWStr(guildName, wideGuildName))
-            continue;
+            return;
 
         wstrToLower(wideGuildName);
 
-        _whoListStorage.emplace_back(itr->second->GetGUID(), itr->second->GetTeam(), itr->second->GetSession()->GetSecurity(), itr->second->GetLevel(),
-            itr->second->GetClass(), itr->second->GetRace(), itr->second->GetZoneId(), itr->second->GetNativeGender(), itr->second->IsVisible(),
+        _whoListStorage.emplace_back(player->GetGUID(), player->GetTeam(), player->GetSession()->GetSecurity(), player->GetLevel(),
+            player->GetClass(), player->GetRace(), player->GetZoneId(), player->GetNativeGender(), player->IsVisible(),
             widePlayerName, wideGuildName, playerName, guildName);
-    }
+    });
 }
@@ -78,6 +78,7 @@
 #include "SmartScriptMgr.h"
 #include "SpellMgr.h"
 #include "TicketMgr.h"
+#include "TickProfiler.h"
 #include "TransportMgr.h"
 #include "Unit.h"
 #include "UpdateTime.h"
@@ -487,6 +488,8 @@ void World::LoadConfigSettings(bool reload)
         sMetric->LoadFromConfigs();
     }
 
+    sTickProfiler->LoadFromConfigs();
+
     ///- Read the player limit and the Message of the day from the config file
     SetPlayerAmountLimit(sConfigMgr->GetIntDefault("PlayerLimit", 100));
     Motd::SetMotd(sConfigMgr->GetStringDefault("Motd", "Welcome to a Trinity Core Server."));
@@ -742,6 +745,7 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_SOCKET_TIMEOUTTIME_ACTIVE] = sConfigMgr->GetIntDefault("SocketTimeOutTimeActive", 60000) / 1000;
 
     m_int_configs[CONFIG_SESSION_ADD_DELAY] = sConfigMgr->GetIntDefault("SessionAddDelay", 10000);
+    m_int_configs[CONFIG_SESSION_UPDATE_TIME_BUDGET] = sConfigMgr->GetIntDefault("SessionUpdateTimeBudget", 10000);
 
     m_float_configs[CONFIG_GROUP_XP_DISTANCE] = sConfigMgr->GetFloatDefault("MaxGroupXPDistance", 74.0f);
     m_float_configs[CONFIG_MAX_RECRUIT_A_FRIEND_DISTANCE] = sConfigMgr->GetFloatDefault("MaxRecruitAFriendBonusDistance", 100.0f);
@@ -1431,6 +1435,10 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_SHOW_MUTE_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowMuteInWorld", false);
     m_bool_configs[CONFIG_SHOW_BAN_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowBanInWorld", false);
     m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+    m_bool_configs[CONFIG_MAP_UPDATE_OVERLAP] = sConfigMgr->GetBoolDefault("MapUpdate.OverlapWorldTasks", true);
+    m_bool_configs[CONFIG_MAP_UPDATE_ADAPTIVE] = sConfigMgr->GetBoolDefault("MapUpdate.Adaptive.Enable", false);
+    m_int_configs[CONFIG_MAP_UPDATE_REDUCED_INTERVAL] = sConfigMgr->GetIntDefault("MapUpdate.Adaptive.ReducedInterval", 250);
+    m_int_configs[CONFIG_MAP_UPDATE_IDLE_INTERVAL] = sConfigMgr->GetIntDefault("MapUpdate.Adaptive.IdleInterval", 1000);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // Warden
@@ -2307,6 +2315,8 @@ void World::LoadAutobroadcasts()
 /// Update the World !
 void World::Update(uint32 diff)
 {
+    TC_PROFILE_TICK(m_worldLoopCounter);
+    TC_PROFILE_ZONE("World::Update");
     TC_METRIC_TIMER("world_update_time_total");
     ///- Update the game time and check for shutdown time
     _UpdateGameTime();
@@ -2417,50 +2427,28 @@ void World::Update(uint32 diff)
         UpdateSessions(diff);
     }
 
-    /// <li> Update uptime table
-    if (m_timers[WUPDATE_UPTIME].Passed())
+    /// <li> Handle all other objects
+    ///- Update objects when the timer has passed (maps, transport, creatures, ...)
+    if (getBoolConfig(CONFIG_MAP_UPDATE_OVERLAP))
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update uptime"));
-        uint32 tmpDiff = GameTime::GetUptime();
-        uint32 maxOnlinePlayers = GetMaxPlayerCount();
-
-        m_timers[WUPDATE_UPTIME].Reset();
-
-        LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_UPTIME_PLAYERS);
-
-        stmt->setUInt32(0, tmpDiff);
-        stmt->setUInt16(1, uint16(maxOnlinePlayers));
-        stmt->setUInt32(2, realm.Id.Realm);
-        stmt->setUInt32(3, uint32(GameTime::GetStartTime()));
-
-        LoginDatabase.Execute(stmt);
+        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update maps"));
+        sMapMgr->Update(diff, [this]()
+        {
+            UpdateMapIndependent();
+        });
     }
-
-    /// <li> Clean logs table
-    if (sWorld->getIntConfig(CONFIG_LOGDB_CLEARTIME) > 0) // if not enabled, ignore the timer
+    else
     {
-        if (m_timers[WUPDATE_CLEANDB].Passed())
         {
-            TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Clean logs table"));
-            m_timers[WUPDATE_CLEANDB].Reset();
-
-            LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_DEL_OLD_LOGS);
-
-            stmt->setUInt32(0, sWorld->getIntConfig(CONFIG_LOGDB_CLEARTIME));
-            stmt->setUInt32(1, uint32(time(0)));
-            stmt->setUInt32(2, realm.Id.Realm);
-
-            LoginDatabase.Execute(stmt);
+            TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update maps"));
+            sMapMgr->Update(diff);
         }
-    }
 
-    /// <li> Handle all other objects
-    ///- Update objects when the timer has passed (maps, transport, creatures, ...)
-    {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update maps"));
-        sMapMgr->Update(diff);
+        UpdateMapIndependent();
     }
 
+    // Synchronization point: everything below may touch players, creatures or other map owned state
+
     if (sWorld->getBoolConfig(CONFIG_AUTOBROADCAST))
     {
         if (m_timers[WUPDATE_AUTOBROADCAST].Passed())
@@ -2504,12 +2492,6 @@ void World::Update(uint32 diff)
         sLFGMgr->Update(diff);
     }
 
-    {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Process query callbacks"));
-        // execute callbacks from sql queries that were queued recently
-        ProcessQueryCallbacks();
-    }
-
     ///- Erase corpses once every 20 minutes
     if (m_timers[WUPDATE_CORPSES].Passed())
     {
@@ -2531,17 +2513,6 @@ void World::Update(uint32 diff)
         m_timers[WUPDATE_EVENTS].Reset();
     }
 
-    ///- Ping to keep MySQL connections alive
-    if (m_timers[WUPDATE_PINGDB].Passed())
-    {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Ping MySQL"));
-        m_timers[WUPDATE_PINGDB].Reset();
-        TC_LOG_DEBUG("misc", "Ping MySQL to keep connection alive");
-        CharacterDatabase.KeepAlive();
-        LoginDatabase.KeepAlive();
-        WorldDatabase.KeepAlive();
-    }
-
     {
         TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update instance reset times"));
         // update the instance reset times
@@ -2577,6 +2548,65 @@ void World::Update(uint32 diff)
     }
 }
 
+/// Systems updated by the world thread that do not touch anything owned by maps.
+/// They run while the map update threads are busy, see MapUpdate.OverlapWorldTasks.
+void World::UpdateMapIndependent()
+{
+    /// <li> Update uptime table
+    if (m_timers[WUPDATE_UPTIME].Passed())
+    {
+        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update uptime"));
+        uint32 tmpDiff = GameTime::GetUptime();
+        uint32 maxOnlinePlayers = GetMaxPlayerCount();
+
+        m_timers[WUPDATE_UPTIME].Reset();
+
+        LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_UPTIME_PLAYERS);
+
+        stmt->setUInt32(0, tmpDiff);
+        stmt->setUInt16(1, uint16(maxOnlinePlayers));
+        stmt->setUInt32(2, realm.Id.Realm);
+        stmt->setUInt32(3, uint32(GameTime::GetStartTime()));
+
+        LoginDatabase.Execute(stmt);
+    }
+
+    /// <li> Clean logs table
+    if (sWorld->getIntConfig(CONFIG_LOGDB_CLEARTIME) > 0) // if not enabled, ignore the timer
+    {
+        if (m_timers[WUPDATE_CLEANDB].Passed())
+        {
+            TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Clean logs table"));
+            m_timers[WUPDATE_CLEANDB].Reset();
+
+            LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_DEL_OLD_LOGS);
+
+            stmt->setUInt32(0, sWorld->getIntConfig(CONFIG_LOGDB_CLEARTIME));
+            stmt->setUInt32(1, uint32(time(0)));
+            stmt->setUInt32(2, realm.Id.Realm);
+
+            LoginDatabase.Execute(stmt);
+        }
+    }
+
+    ///- Ping to keep MySQL connections alive
+    if (m_timers[WUPDATE_PINGDB].Passed())
+    {
+        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Ping MySQL"));
+        m_timers[WUPDATE_PINGDB].Reset();
+        TC_LOG_DEBUG("misc", "Ping MySQL to keep connection alive");
+        CharacterDatabase.KeepAlive();
+        LoginDatabase.KeepAlive();
+        WorldDatabase.KeepAlive();
+    }
+
+    {
+        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Process query callbacks"));
+        // execute callbacks from sql queries that were queued recently, they only write to the login database
+        ProcessQueryCallbacks();
+    }
+}
+
 void World::ForceGameEventUpdate()
 {
     m_timers[WUPDATE_EVENTS].Reset();                   // to give time for Update() to be processed
@@ -2588,6 +2618,7 @@ void World::ForceGameEventUpdate()
 /// Send a packet to all players (except self if mentioned)
 void World::SendGlobalMessage(WorldPacket const* packet, WorldSession* self, uint32 team)
 {
+    SharedWorldPacket sharedPacket(packet);
     SessionMap::const_iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -2597,7 +2628,7 @@ void World::SendGlobalMessage(WorldPacket const* packet, WorldSession* self, uin
             itr->second != self &&
             (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(sharedPacket.Get());
         }
     }
 }
@@ -2605,6 +2636,7 @@ void World::SendGlobalMessage(WorldPacket const* packet, WorldSession* self, uin
 /// Send a packet to all GMs (except self if mentioned)
 void World::SendGlobalGMMessage(WorldPacket const* packet, WorldSession* self, uint32 team)
 {
+    SharedWorldPacket sharedPacket(packet);
     for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
         // check if session and can receive global GM Messages and its not self
@@ -2619,7 +2651,7 @@ void World::SendGlobalGMMessage(WorldPacket const* packet, WorldSession* self, u
 
         // Send only to same team, if team is given
         if (!team || player->GetTeam() == team)
-            session->SendPacket(packet);
+            session->SendPacket(sharedPacket.Get());
     }
 }
 
@@ -2734,6 +2766,7 @@ void World::SendGlobalText(char const* text, WorldSession* self)
 bool World::SendZoneMessage(uint32 zone, WorldPacket const* packet, WorldSession* self, uint32 team)
 {
     bool foundPlayerToSend = false;
+    SharedWorldPacket sharedPacket(packet);
     SessionMap::const_iterator itr;
 
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
@@ -2745,7 +2778,7 @@ bool World::SendZoneMessage(uint32 zone, WorldPacket const* packet, WorldSession
             itr->second != self &&
             (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(sharedPacket.Get());
             foundPlayerToSend = true;
         }
     }
@@ -3567,6 +3600,7 @@ uint64 World::getWorldState(uint32 index) const
 
 void World::ProcessQueryCallbacks()
 {
+    TC_PROFILE_ZONE("World::ProcessQueryCallbacks");
     _queryProcessor.ProcessReadyCallbacks();
 }
 
@@ -177,6 +177,8 @@ enum WorldBoolConfigs
     CONFIG_CHECK_GOBJECT_LOS,
     CONFIG_RESPAWN_DYNAMIC_ESCORTNPC,
     CONFIG_REGEN_HP_CANNOT_REACH_TARGET_IN_RAID,
+    CONFIG_MAP_UPDATE_OVERLAP,
+    CONFIG_MAP_UPDATE_ADAPTIVE,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -327,6 +329,8 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_MAP_UPDATE_REDUCED_INTERVAL,
+    CONFIG_MAP_UPDATE_IDLE_INTERVAL,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
@@ -396,6 +400,7 @@ enum WorldIntConfigs
     CONFIG_RESPAWN_GUIDWARNING_FREQUENCY,
     CONFIG_SOCKET_TIMEOUTTIME_ACTIVE,
     CONFIG_PENDING_MOVE_CHANGES_TIMEOUT,
+    CONFIG_SESSION_UPDATE_TIME_BUDGET,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -668,6 +673,7 @@ class TC_GAME_API World
         void Update(uint32 diff);
 
         void UpdateSessions(uint32 diff);
+        void UpdateMapIndependent();
         /// Set a server rate (see #Rates)
         void setRate(Rates rate, float value) { rate_values[rate]=value; }
         /// Get a server rate (see #Rates)
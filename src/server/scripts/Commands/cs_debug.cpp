@@ -39,6 +39,8 @@ EndScriptData */
 #include "MapManager.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
+#include "Opcodes.h"
+#include "OpcodeStatistics.h"
 #include "PoolMgr.h"
 #include "QuestPools.h"
 #include "RBAC.h"
@@ -120,7 +122,9 @@ public:
             { "guidlimits",         HandleDebugGuidLimitsCommand,          rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
             { "objectcount",        HandleDebugObjectCountCommand,         rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
             { "questreset",         HandleDebugQuestResetCommand,          rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
-            { "warden force",       HandleDebugWardenForce,                rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes }
+            { "warden force",       HandleDebugWardenForce,                rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
+            { "opcodecost",         HandleDebugOpcodeCostCommand,          rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
+            { "opcodecost reset",   HandleDebugOpcodeCostResetCommand,     rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes }
         };
         static ChatCommandTable commandTable =
         {
@@ -1713,6 +1717,32 @@ public:
         return true;
     }
 
+    static bool HandleDebugOpcodeCostCommand(ChatHandler* handler, Optional<uint32> count)
+    {
+        std::vector<OpcodeStatistics::Summary> summaries = sOpcodeStatistics->GetMostExpensive(count.value_or(10));
+        if (summaries.empty())
+        {
+            handler->SendSysMessage("No opcodes handled since the statistics were reset.");
+            return true;
+        }
+
+        handler->SendSysMessage("Most expensive opcodes by total handler time (total ms / calls / avg us / p99 us / max us):");
+        for (OpcodeStatistics::Summary const& summary : summaries)
+        {
+            handler->PSendSysMessage("%s: " UI64FMTD " / " UI64FMTD " / " UI64FMTD " / " SI64FMTD " / " SI64FMTD,
+                GetOpcodeNameForLogging(summary.Opcode).c_str(), uint64(summary.Total.count() / 1000), summary.Count,
+                uint64(summary.Total.count()) / summary.Count, int64(summary.P99.count()), int64(summary.Max.count()));
+        }
+        return true;
+    }
+
+    static bool HandleDebugOpcodeCostResetCommand(ChatHandler* handler)
+    {
+        sOpcodeStatistics->Reset();
+        handler->SendSysMessage("Opcode handler statistics reset.");
+        return true;
+    }
+
     static bool HandleDebugGuidLimitsCommand(ChatHandler* handler, Optional<uint32> mapId)
     {
         if (mapId)
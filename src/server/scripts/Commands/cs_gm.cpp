@@ -117,8 +117,7 @@ public:
         bool first = true;
         bool footer = false;
 
-        std::shared_lock<std::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
-        for (auto const [playerGuid, player] : ObjectAccessor::GetPlayers())
+        ObjectAccessor::GetPlayers().DoForAll([&](ObjectGuid const& /*playerGuid*/, Player* player)
         {
             AccountTypes playerSec = player->GetSession()->GetSecurity();
             if ((player->IsGameMaster() ||
@@ -145,7 +144,7 @@ public:
                 else
                     handler->PSendSysMessage("|%*s%s%*s|   %u  |", max, " ", name.c_str(), max2, " ", security);
             }
-        }
+        });
         if (footer)
             handler->SendSysMessage("========================");
         if (first)
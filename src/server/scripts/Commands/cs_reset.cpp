@@ -304,10 +304,10 @@ public:
         stmt->setUInt16(0, uint16(atLogin));
         CharacterDatabase.Execute(stmt);
 
-        std::shared_lock<std::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
-        HashMapHolder<Player>::MapType const& plist = ObjectAccessor::GetPlayers();
-        for (HashMapHolder<Player>::MapType::const_iterator itr = plist.begin(); itr != plist.end(); ++itr)
-            itr->second->SetAtLoginFlag(atLogin);
+        ObjectAccessor::GetPlayers().DoForAll([atLogin](ObjectGuid const& /*guid*/, Player* player)
+        {
+            player->SetAtLoginFlag(atLogin);
+        });
 
         return true;
     }
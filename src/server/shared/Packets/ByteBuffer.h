@@ -19,6 +19,7 @@
 #define _BYTEBUFFER_H
 
 #include "Define.h"
+#include "BufferPool.h"
 #include "ByteConverter.h"
 #include <array>
 #include <string>
@@ -500,7 +501,7 @@ class TC_SHARED_API ByteBuffer
 
     protected:
         size_t _rpos, _wpos;
-        std::vector<uint8> _storage;
+        Trinity::PooledByteVector _storage;
 };
 
 /// @todo Make a ByteBuffer.cpp and move all this inlining to it.
@@ -25,11 +25,13 @@
 #include "Banner.h"
 #include "BattlegroundMgr.h"
 #include "BigNumber.h"
+#include "BufferPool.h"
 #include "CliRunnable.h"
 #include "Configuration/Config.h"
 #include "DatabaseEnv.h"
 #include "DatabaseLoader.h"
 #include "DeadlineTimer.h"
+#include "FixedTimestep.h"
 #include "GitRevision.h"
 #include "InstanceSaveMgr.h"
 #include "IoContext.h"
@@ -109,6 +111,8 @@ AsyncAcceptor* StartRaSocketAcceptor(Trinity::Asio::IoContext& ioContext);
 bool StartDB();
 void StopDB();
 void WorldUpdateLoop();
+void VariableTimestepWorldUpdateLoop();
+void FixedTimestepWorldUpdateLoop();
 void ClearOnlineAccounts();
 void ShutdownCLIThread(std::thread* cliThread);
 bool LoadRealmInfo(Trinity::Asio::IoContext& ioContext);
@@ -231,6 +235,12 @@ extern int main(int argc, char** argv)
     sMetric->Initialize(realm.Name, *ioContext, []()
     {
         TC_METRIC_VALUE("online_players", sWorld->GetPlayerCount());
+
+        Trinity::BufferPool::Statistics bufferPool = Trinity::BufferPool::GetStatistics();
+        TC_METRIC_VALUE("buffer_pool_allocations", bufferPool.Allocations, TC_METRIC_TAG("type", "total"));
+        TC_METRIC_VALUE("buffer_pool_allocations", bufferPool.ThreadCacheHits, TC_METRIC_TAG("type", "thread_cache"));
+        TC_METRIC_VALUE("buffer_pool_allocations", bufferPool.DepotHits, TC_METRIC_TAG("type", "depot"));
+        TC_METRIC_VALUE("buffer_pool_allocations", bufferPool.HeapAllocations, TC_METRIC_TAG("type", "heap"));
     });
 
     TC_METRIC_EVENT("events", "Worldserver started", "");
@@ -423,13 +433,36 @@ void ShutdownCLIThread(std::thread* cliThread)
 
 void WorldUpdateLoop()
 {
-    uint32 realCurrTime = 0;
-    uint32 realPrevTime = getMSTime();
-
     LoginDatabase.WarnAboutSyncQueries(true);
     CharacterDatabase.WarnAboutSyncQueries(true);
     WorldDatabase.WarnAboutSyncQueries(true);
 
+    if (sConfigMgr->GetBoolDefault("World.FixedTimestep.Enable", false))
+        FixedTimestepWorldUpdateLoop();
+    else
+        VariableTimestepWorldUpdateLoop();
+
+    LoginDatabase.WarnAboutSyncQueries(false);
+    CharacterDatabase.WarnAboutSyncQueries(false);
+    WorldDatabase.WarnAboutSyncQueries(false);
+}
+
+#ifdef _WIN32
+void UpdateServiceStatus()
+{
+    if (m_ServiceStatus == 0)
+        World::StopNow(SHUTDOWN_EXIT_CODE);
+
+    while (m_ServiceStatus == 2)
+        Sleep(1000);
+}
+#endif
+
+void VariableTimestepWorldUpdateLoop()
+{
+    uint32 realCurrTime = 0;
+    uint32 realPrevTime = getMSTime();
+
     ///- While we have not World::m_stopEvent, update the world
     while (!World::IsStopped())
     {
@@ -448,17 +481,59 @@ void WorldUpdateLoop()
             std::this_thread::sleep_for(std::chrono::milliseconds(WORLD_SLEEP_CONST - executionTimeDiff));
 
 #ifdef _WIN32
-        if (m_ServiceStatus == 0)
-            World::StopNow(SHUTDOWN_EXIT_CODE);
-
-        while (m_ServiceStatus == 2)
-            Sleep(1000);
+        UpdateServiceStatus();
 #endif
     }
+}
 
-    LoginDatabase.WarnAboutSyncQueries(false);
-    CharacterDatabase.WarnAboutSyncQueries(false);
-    WorldDatabase.WarnAboutSyncQueries(false);
+void FixedTimestepWorldUpdateLoop()
+{
+    int32 tickRate = std::clamp(sConfigMgr->GetIntDefault("World.FixedTimestep.TickRate", 20), 1, 1000);
+    uint32 maxCatchUpTicks = uint32(std::max(sConfigMgr->GetIntDefault("World.FixedTimestep.MaxCatchUpTicks", 4), 0));
+    Seconds statisticsInterval(std::max(sConfigMgr->GetIntDefault("World.FixedTimestep.StatisticsInterval", 10), 1));
+
+    TC_LOG_INFO("server.worldserver", "World update loop running at a fixed rate of %d ticks per second", tickRate);
+
+    Trinity::FixedTimestep timestep(std::chrono::nanoseconds(1s) / tickRate, maxCatchUpTicks);
+    Trinity::TickTimeStatistics tickTimes;
+    TimePoint statisticsStart = std::chrono::steady_clock::now();
+    uint64 reportedOverruns = 0;
+    uint64 reportedDroppedTicks = 0;
+
+    timestep.Start(statisticsStart);
+
+    ///- While we have not World::m_stopEvent, update the world
+    while (!World::IsStopped())
+    {
+        ++World::m_worldLoopCounter;
+
+        TimePoint tickStart = std::chrono::steady_clock::now();
+        sWorld->Update(timestep.NextTickDiff());
+        TimePoint tickEnd = std::chrono::steady_clock::now();
+
+        tickTimes.Add(tickEnd - tickStart);
+        timestep.FinishTick(tickEnd);
+
+        if (tickEnd - statisticsStart >= statisticsInterval)
+        {
+            TC_METRIC_VALUE("world_tick_time", tickTimes.GetPercentile(0.5), TC_METRIC_TAG("percentile", "p50"));
+            TC_METRIC_VALUE("world_tick_time", tickTimes.GetPercentile(0.99), TC_METRIC_TAG("percentile", "p99"));
+            TC_METRIC_VALUE("world_tick_time", tickTimes.GetMax(), TC_METRIC_TAG("percentile", "max"));
+            TC_METRIC_VALUE("world_tick_overruns", timestep.GetOverrunCount() - reportedOverruns);
+            TC_METRIC_VALUE("world_tick_dropped", timestep.GetDroppedTickCount() - reportedDroppedTicks);
+
+            tickTimes.Reset();
+            statisticsStart = tickEnd;
+            reportedOverruns = timestep.GetOverrunCount();
+            reportedDroppedTicks = timestep.GetDroppedTickCount();
+        }
+
+        timestep.SleepUntilNextTick();
+
+#ifdef _WIN32
+        UpdateServiceStatus();
+#endif
+    }
 }
 
 void SignalHandler(boost::system::error_code const& error, int /*signalNumber*/)
@@ -0,0 +1,142 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "BufferPool.h"
+#include "Define.h"
+#include <thread>
+#include <vector>
+
+using Trinity::BufferPool;
+
+TEST_CASE("BufferPool", "[BufferPool]")
+{
+    SECTION("Released blocks are reused by the same size class")
+    {
+        void* first = BufferPool::Allocate(100);
+        BufferPool::Deallocate(first, 100);
+
+        // 100 and 128 bytes share the 128 byte class
+        void* second = BufferPool::Allocate(128);
+        REQUIRE(second == first);
+        BufferPool::Deallocate(second, 128);
+
+        void* other = BufferPool::Allocate(200);
+        REQUIRE(other != first);
+        BufferPool::Deallocate(other, 200);
+    }
+
+    SECTION("Oversized requests go to the heap")
+    {
+        BufferPool::Statistics before = BufferPool::GetStatistics();
+        void* ptr = BufferPool::Allocate(BufferPool::MaxPooledSize + 1);
+        BufferPool::Deallocate(ptr, BufferPool::MaxPooledSize + 1);
+        BufferPool::Statistics after = BufferPool::GetStatistics();
+
+        REQUIRE(after.HeapAllocations == before.HeapAllocations + 1);
+        REQUIRE(after.HeapDeallocations == before.HeapDeallocations + 1);
+    }
+
+    SECTION("Blocks released on another thread come back through the depot")
+    {
+        constexpr std::size_t Size = 1024;
+        std::vector<void*> blocks;
+        for (uint32 i = 0; i < 256; ++i)
+            blocks.push_back(BufferPool::Allocate(Size));
+
+        std::thread([&blocks]()
+        {
+            for (void* block : blocks)
+                BufferPool::Deallocate(block, Size);
+        }).join();
+
+        BufferPool::Statistics before = BufferPool::GetStatistics();
+        for (uint32 i = 0; i < 256; ++i)
+            blocks[i] = BufferPool::Allocate(Size);
+        BufferPool::Statistics after = BufferPool::GetStatistics();
+
+        REQUIRE(after.DepotHits > before.DepotHits);
+        REQUIRE(after.HeapAllocations - before.HeapAllocations < 256);
+
+        for (void* block : blocks)
+            BufferPool::Deallocate(block, Size);
+    }
+
+    SECTION("PooledByteVector")
+    {
+        Trinity::PooledByteVector buffer;
+        for (uint32 i = 0; i < 10000; ++i)
+            buffer.push_back(uint8(i));
+
+        for (uint32 i = 0; i < 10000; ++i)
+            REQUIRE(buffer[i] == uint8(i));
+    }
+}
+
+namespace
+{
+    // packets are built on the update threads and freed by the network thread after sending
+    template<typename Buffer>
+    uint64 RunPacketChurn(uint32 threadCount, uint32 packetsPerThread)
+    {
+        std::vector<std::thread> threads;
+        std::vector<uint64> written(threadCount, 0);
+        for (uint32 t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&written, t, packetsPerThread]()
+            {
+                uint64 bytes = 0;
+                std::vector<Buffer> inFlight(64);
+                for (uint32 i = 0; i < packetsPerThread; ++i)
+                {
+                    Buffer& packet = inFlight[i % inFlight.size()];
+                    Buffer().swap(packet);
+                    packet.reserve(200);
+                    packet.resize(20 + (i * 37) % 600);
+                    bytes += packet.size();
+                }
+                written[t] = bytes;
+            });
+        }
+
+        uint64 total = 0;
+        for (uint32 t = 0; t < threadCount; ++t)
+        {
+            threads[t].join();
+            total += written[t];
+        }
+
+        return total;
+    }
+}
+
+TEST_CASE("BufferPool packet churn", "[BufferPool][!benchmark]")
+{
+    constexpr uint32 ThreadCount = 16;
+    constexpr uint32 PacketsPerThread = 50000;
+
+    BENCHMARK("std::vector<uint8>, 16 threads")
+    {
+        return RunPacketChurn<std::vector<uint8>>(ThreadCount, PacketsPerThread);
+    };
+
+    BENCHMARK("PooledByteVector, 16 threads")
+    {
+        return RunPacketChurn<Trinity::PooledByteVector>(ThreadCount, PacketsPerThread);
+    };
+}
@@ -0,0 +1,191 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "DistanceKernels.h"
+#include "Random.h"
+#include <cmath>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    struct Positions
+    {
+        std::vector<float> X;
+        std::vector<float> Y;
+        std::vector<float> Reach;
+
+        explicit Positions(uint32 count)
+        {
+            for (uint32 i = 0; i < count; ++i)
+            {
+                X.push_back(frand(-100.0f, 100.0f));
+                Y.push_back(frand(-100.0f, 100.0f));
+                Reach.push_back(frand(0.0f, 5.0f));
+            }
+        }
+    };
+
+    std::vector<uint32> SelectScalar(Positions const& positions, float centerX, float centerY, float range)
+    {
+        std::vector<uint32> selected;
+        for (uint32 i = 0; i < positions.X.size(); ++i)
+            if (std::hypot(positions.X[i] - centerX, positions.Y[i] - centerY) <= range + positions.Reach[i])
+                selected.push_back(i);
+        return selected;
+    }
+}
+
+TEST_CASE("SelectInRange2d matches a scalar distance check", "[DistanceKernels]")
+{
+    // covers empty input, partial batches and tails
+    for (uint32 count : { 0u, 1u, 3u, 4u, 5u, 17u, 64u, 257u })
+    {
+        Positions positions(count);
+        std::vector<uint32> selected(count);
+        uint32 found = Trinity::SelectInRange2d(positions.X.data(), positions.Y.data(), positions.Reach.data(), count, 10.0f, -20.0f, 45.0f, selected.data());
+        selected.resize(found);
+
+        REQUIRE(selected == SelectScalar(positions, 10.0f, -20.0f, 45.0f));
+    }
+}
+
+TEST_CASE("SelectInRange2d includes the target's reach", "[DistanceKernels]")
+{
+    float x[] = { 10.0f, 10.0f, 0.0f, 0.0f, 13.0f };
+    float y[] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    float reach[] = { 0.0f, 1.5f, 0.0f, 0.0f, 2.0f };
+    uint32 selected[5];
+
+    REQUIRE(Trinity::SelectInRange2d(x, y, reach, 5, 0.0f, 0.0f, 9.0f, selected) == 3);
+    REQUIRE(selected[0] == 1);
+    REQUIRE(selected[1] == 2);
+    REQUIRE(selected[2] == 3);
+}
+
+namespace
+{
+    // stand-in for a unit: the range check reads state spread over a large object, the combat reach
+    // lives in the separately allocated update fields and is read through a virtual call
+    struct FakeObject
+    {
+        FakeObject() : FloatValues(new float[64]()) { FloatValues[0] = 1.5f; }
+        virtual ~FakeObject() { delete[] FloatValues; }
+        virtual float GetCombatReach() const { return FloatValues[0]; }
+
+        float X = 0.0f;
+        float Y = 0.0f;
+        float Z = 0.0f;
+        char Fields[1024];
+        bool InWorld = true;
+        void* CurrentMap = nullptr;
+        void* Transport = nullptr;
+        char MoreFields[1024];
+        uint32 PhaseMask = 1;
+        uint32 Faction = 0;
+        float* FloatValues;
+    };
+
+    // same steps as WorldObject::IsWithinDistInMap
+    bool IsWithinDistInMapImpl(FakeObject const* searcher, FakeObject const* target, float dist)
+    {
+        if (!searcher->InWorld || !target->InWorld || searcher->CurrentMap != target->CurrentMap || !(searcher->PhaseMask & target->PhaseMask))
+            return false;
+
+        float maxDist = dist + searcher->GetCombatReach() + target->GetCombatReach();
+        if (searcher->Transport && searcher->Transport == target->Transport)
+            return true;
+
+        float dx = searcher->X - target->X;
+        float dy = searcher->Y - target->Y;
+        float dz = searcher->Z - target->Z;
+        return dx * dx + dy * dy + dz * dz < maxDist * maxDist;
+    }
+
+    // faction part of checks like AnyUnfriendlyUnitInObjectRangeCheck
+    bool IsHostileImpl(FakeObject const* searcher, FakeObject const* target)
+    {
+        return ((searcher->Faction ^ target->Faction) & 1) != 0;
+    }
+
+    // the real checks live in other translation units, keep the compiler from inlining them here
+    bool (* volatile IsWithinDistInMap)(FakeObject const*, FakeObject const*, float) = &IsWithinDistInMapImpl;
+    bool (* volatile IsHostile)(FakeObject const*, FakeObject const*) = &IsHostileImpl;
+}
+
+TEST_CASE("Unfriendly units in range", "[DistanceKernels][!benchmark]")
+{
+    // units in the 3x3 cells around a searcher, about a seventh of them within the searched range
+    constexpr uint32 Count = 400;
+    std::vector<std::unique_ptr<FakeObject>> objects;
+    std::vector<FakeObject*> cellUnits;
+    for (uint32 i = 0; i < Count; ++i)
+    {
+        objects.push_back(std::make_unique<FakeObject>());
+        objects.back()->X = frand(-100.0f, 100.0f);
+        objects.back()->Y = frand(-100.0f, 100.0f);
+        objects.back()->Faction = i;
+        cellUnits.push_back(objects.back().get());
+    }
+
+    FakeObject searcher;
+    searcher.Faction = 1;
+    constexpr float Range = 40.0f;
+
+    BENCHMARK("Range check per unit")
+    {
+        uint32 found = 0;
+        for (FakeObject* unit : cellUnits)
+            if (IsWithinDistInMap(&searcher, unit, Range) && IsHostile(&searcher, unit))
+                ++found;
+        return found;
+    };
+
+    BENCHMARK("SelectInRange2d broad phase")
+    {
+        constexpr uint32 BatchSize = 64;
+        float x[BatchSize];
+        float y[BatchSize];
+        float reach[BatchSize];
+        uint32 selected[BatchSize];
+
+        uint32 found = 0;
+        for (uint32 begin = 0; begin < Count; begin += BatchSize)
+        {
+            uint32 batchCount = std::min(Count - begin, BatchSize);
+            for (uint32 i = 0; i < batchCount; ++i)
+            {
+                FakeObject const* unit = cellUnits[begin + i];
+                x[i] = unit->X;
+                y[i] = unit->Y;
+                reach[i] = unit->GetCombatReach();
+            }
+
+            uint32 inRange = Trinity::SelectInRange2d(x, y, reach, batchCount, searcher.X, searcher.Y, Range + searcher.GetCombatReach(), selected);
+            for (uint32 i = 0; i < inRange; ++i)
+            {
+                FakeObject const* unit = cellUnits[begin + selected[i]];
+                if (IsWithinDistInMap(&searcher, unit, Range) && IsHostile(&searcher, unit))
+                    ++found;
+            }
+        }
+        return found;
+    };
+}
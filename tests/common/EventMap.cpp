@@ -384,3 +384,44 @@ TEST_CASE("Reset map", "[EventMap]")
 
     REQUIRE(eventMap.Empty());
 }
+
+TEST_CASE("EventMap throughput", "[EventMap][!benchmark]")
+{
+    constexpr uint32 EventCount = 32;
+
+    BENCHMARK("Schedule, update and execute events")
+    {
+        EventMap eventMap;
+        for (uint32 i = 0; i < EventCount; ++i)
+            eventMap.ScheduleEvent(i + 1, Milliseconds(100 + i * 50), i % 4, i % 3);
+
+        uint32 executed = 0;
+        for (uint32 tick = 0; tick < 100; ++tick)
+        {
+            eventMap.Update(50);
+            while (uint32 eventId = eventMap.ExecuteEvent())
+            {
+                eventMap.Repeat(Milliseconds(100 + eventId * 10));
+                ++executed;
+            }
+        }
+
+        return executed;
+    };
+
+    BENCHMARK_ADVANCED("Reschedule and cancel events")(Catch::Benchmark::Chronometer meter)
+    {
+        EventMap eventMap;
+        for (uint32 i = 0; i < EventCount; ++i)
+            eventMap.ScheduleEvent(i + 1, Milliseconds(100 + i * 50), i % 4);
+
+        meter.measure([&](int i)
+        {
+            uint32 eventId = uint32(i) % EventCount + 1;
+            eventMap.RescheduleEvent(eventId, Milliseconds(100 + i % 1000), eventId % 4);
+            eventMap.CancelEventGroup(eventId % 4 + 1);
+            eventMap.ScheduleEvent(eventId, 1s, eventId % 4 + 1);
+            return eventMap.GetTimeUntilEvent(eventId);
+        });
+    };
+}
@@ -0,0 +1,95 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define CATCH_CONFIG_ENABLE_CHRONO_STRINGMAKER
+#include "tc_catch2.h"
+
+#include "FixedTimestep.h"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("FixedTimestep schedules ticks without drift", "[FixedTimestep]")
+{
+    Trinity::FixedTimestep timestep(50ms, 2);
+    TimePoint start = TimePoint(1h);
+    timestep.Start(start);
+
+    // ticks finishing early sleep until their slot, the schedule does not depend on tick length
+    REQUIRE(timestep.FinishTick(start + 10ms) == start + 50ms);
+    REQUIRE(timestep.FinishTick(start + 99ms) == start + 100ms);
+    REQUIRE(timestep.FinishTick(start + 101ms) == start + 150ms);
+    REQUIRE(timestep.GetOverrunCount() == 0);
+    REQUIRE(timestep.GetLastOverrun() == 0ns);
+}
+
+TEST_CASE("FixedTimestep catches up after overruns", "[FixedTimestep]")
+{
+    Trinity::FixedTimestep timestep(50ms, 2);
+    TimePoint start = TimePoint(1h);
+    timestep.Start(start);
+
+    SECTION("Short overruns keep the schedule")
+    {
+        // tick 0 runs 120ms, next ticks are due immediately until the schedule is met again
+        REQUIRE(timestep.FinishTick(start + 120ms) == start + 50ms);
+        REQUIRE(timestep.GetLastOverrun() == 70ms);
+        REQUIRE(timestep.FinishTick(start + 125ms) == start + 100ms);
+        REQUIRE(timestep.FinishTick(start + 130ms) == start + 150ms);
+        REQUIRE(timestep.GetOverrunCount() == 2);
+        REQUIRE(timestep.GetDroppedTickCount() == 0);
+    }
+
+    SECTION("Long overruns drop the missed ticks")
+    {
+        REQUIRE(timestep.FinishTick(start + 500ms) == start + 500ms);
+        REQUIRE(timestep.GetOverrunCount() == 1);
+        REQUIRE(timestep.GetDroppedTickCount() == 9);
+        REQUIRE(timestep.FinishTick(start + 510ms) == start + 550ms);
+    }
+}
+
+TEST_CASE("FixedTimestep carries sub millisecond diffs", "[FixedTimestep]")
+{
+    Trinity::FixedTimestep timestep(std::chrono::nanoseconds(1s) / 30, 2);
+
+    uint32 total = 0;
+    for (uint32 i = 0; i < 30; ++i)
+        total += timestep.NextTickDiff();
+
+    REQUIRE(total == 999);
+    REQUIRE(timestep.NextTickDiff() == 34);
+}
+
+TEST_CASE("TickTimeStatistics", "[FixedTimestep]")
+{
+    Trinity::TickTimeStatistics statistics;
+    REQUIRE(statistics.GetPercentile(0.5) == 0ns);
+    REQUIRE(statistics.GetMax() == 0ns);
+
+    for (uint32 i = 100; i > 0; --i)
+        statistics.Add(std::chrono::milliseconds(i));
+
+    REQUIRE(statistics.GetCount() == 100);
+    REQUIRE(statistics.GetPercentile(0.5) == 50ms);
+    REQUIRE(statistics.GetPercentile(0.99) == 99ms);
+    REQUIRE(statistics.GetPercentile(1.0) == 100ms);
+    REQUIRE(statistics.GetPercentile(0.0) == 1ms);
+    REQUIRE(statistics.GetMax() == 100ms);
+
+    statistics.Reset();
+    REQUIRE(statistics.GetCount() == 0);
+}
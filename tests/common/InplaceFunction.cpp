@@ -0,0 +1,96 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "InplaceFunction.h"
+#include <memory>
+#include <string>
+
+namespace
+{
+    typedef Trinity::InplaceFunction<int(int), 48> Function;
+
+    struct Counted
+    {
+        explicit Counted(int& instances) : Instances(&instances) { ++*Instances; }
+        Counted(Counted const& right) : Instances(right.Instances) { ++*Instances; }
+        ~Counted() { --*Instances; }
+
+        int operator()(int value) const { return value + 1; }
+
+        int* Instances;
+    };
+}
+
+TEST_CASE("InplaceFunction", "[InplaceFunction]")
+{
+    Function empty;
+    REQUIRE_FALSE(empty);
+
+    SECTION("Invokes the stored callable")
+    {
+        int offset = 10;
+        Function add = [offset](int value) { return value + offset; };
+        REQUIRE(add);
+        REQUIRE(add(5) == 15);
+    }
+
+    SECTION("Mutable callables keep their state")
+    {
+        Function counter = [calls = 0](int) mutable { return ++calls; };
+        counter(0);
+        REQUIRE(counter(0) == 2);
+
+        Function copy = counter;
+        REQUIRE(copy(0) == 3);
+        REQUIRE(counter(0) == 3);
+    }
+
+    SECTION("Copies, moves and destroys captured state")
+    {
+        int instances = 0;
+        {
+            Function function = Counted(instances);
+            REQUIRE(instances == 1);
+
+            Function copy = function;
+            REQUIRE(instances == 2);
+
+            Function moved = std::move(copy);
+            REQUIRE(instances == 3);
+
+            function = nullptr;
+            REQUIRE(instances == 2);
+
+            function = moved;
+            REQUIRE(instances == 3);
+            REQUIRE(function(1) == 2);
+        }
+        REQUIRE(instances == 0);
+    }
+
+    SECTION("Non trivial captures")
+    {
+        std::string text = "a string too long for the small string buffer";
+        auto shared = std::make_shared<int>(4);
+        Function function = [text, shared](int value) { return int(text.size()) + *shared + value; };
+        Function copy = function;
+        REQUIRE(shared.use_count() == 3);
+        REQUIRE(copy(1) == int(text.size()) + 5);
+    }
+}
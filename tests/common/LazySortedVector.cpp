@@ -0,0 +1,191 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "LazySortedVector.h"
+#include "Define.h"
+#include "Random.h"
+#include <boost/heap/fibonacci_heap.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    struct Entry
+    {
+        uint32 Id = 0;
+        float Threat = 0.0f;
+    };
+
+    struct CompareEntryLessThan
+    {
+        bool operator()(Entry const* left, Entry const* right) const { return left->Threat < right->Threat; }
+    };
+
+    typedef Trinity::LazySortedVector<Entry const*, CompareEntryLessThan> EntryList;
+
+    bool IsDescending(std::vector<Entry const*> const& list)
+    {
+        return std::is_sorted(list.begin(), list.end(), [](Entry const* left, Entry const* right) { return left->Threat > right->Threat; });
+    }
+}
+
+TEST_CASE("LazySortedVector", "[LazySortedVector]")
+{
+    std::vector<Entry> entries(8);
+    EntryList list;
+    for (uint32 i = 0; i < entries.size(); ++i)
+    {
+        entries[i].Id = i;
+        entries[i].Threat = float(i * 10);
+        list.Insert(&entries[i]);
+    }
+
+    REQUIRE(list.Size() == 8);
+    REQUIRE_FALSE(list.IsSorted());
+    REQUIRE(list.Top() == &entries[7]);
+    REQUIRE(list.IsSorted());
+    REQUIRE(IsDescending(list.GetSorted()));
+
+    SECTION("Changed keys are only picked up after Invalidate")
+    {
+        entries[2].Threat = 1000.0f;
+        REQUIRE(list.IsSorted());
+        list.Invalidate();
+        REQUIRE(list.Top() == &entries[2]);
+        REQUIRE(IsDescending(list.GetSorted()));
+    }
+
+    SECTION("Equal keys keep their previous order")
+    {
+        entries[1].Threat = 70.0f;
+        entries[4].Threat = 70.0f;
+        list.Invalidate();
+        std::vector<Entry const*> const& sorted = list.GetSorted();
+        REQUIRE(sorted[0] == &entries[7]);
+        REQUIRE(sorted[1] == &entries[4]);
+        REQUIRE(sorted[2] == &entries[1]);
+    }
+
+    SECTION("Remove keeps order")
+    {
+        REQUIRE(list.Remove(&entries[7]));
+        REQUIRE_FALSE(list.Remove(&entries[7]));
+        REQUIRE(list.IsSorted());
+        REQUIRE(list.Size() == 7);
+        REQUIRE(list.Top() == &entries[6]);
+    }
+
+    SECTION("Clear")
+    {
+        list.Clear();
+        REQUIRE(list.Empty());
+        REQUIRE(list.GetSorted().empty());
+    }
+}
+
+TEST_CASE("LazySortedVector matches a full sort under random updates", "[LazySortedVector]")
+{
+    std::vector<Entry> entries(40);
+    EntryList list;
+    for (uint32 i = 0; i < entries.size(); ++i)
+    {
+        entries[i].Id = i;
+        list.Insert(&entries[i]);
+    }
+
+    for (uint32 round = 0; round < 200; ++round)
+    {
+        for (uint32 i = 0; i < 10; ++i)
+            entries[urand(0, entries.size() - 1)].Threat += frand(0.0f, 500.0f);
+        list.Invalidate();
+
+        REQUIRE(IsDescending(list.GetSorted()));
+        REQUIRE(list.Top()->Threat == std::max_element(entries.begin(), entries.end(), [](Entry const& left, Entry const& right) { return left.Threat < right.Threat; })->Threat);
+    }
+}
+
+namespace
+{
+    // 40 players on a boss, every event adds threat to a random one (damage, AoE heals), the victim is reselected once per second
+    constexpr uint32 ThreatListSize = 40;
+    constexpr uint32 ThreatEventsPerTick = 200;
+    constexpr uint32 TicksPerReselect = 20;
+    constexpr uint32 Ticks = 200;
+
+    std::vector<uint32> GenerateThreatEvents()
+    {
+        std::vector<uint32> events(ThreatEventsPerTick * Ticks);
+        for (uint32& target : events)
+            target = urand(0, ThreatListSize - 1);
+        return events;
+    }
+}
+
+TEST_CASE("Threat list under constant threat events", "[LazySortedVector][!benchmark]")
+{
+    std::vector<uint32> const events = GenerateThreatEvents();
+
+    BENCHMARK("boost::heap::fibonacci_heap")
+    {
+        typedef boost::heap::fibonacci_heap<Entry const*, boost::heap::compare<CompareEntryLessThan>> Heap;
+        std::vector<Entry> entries(ThreatListSize);
+        Heap heap;
+        std::vector<Heap::handle_type> handles;
+        for (Entry& entry : entries)
+            handles.push_back(heap.push(&entry));
+
+        float topThreat = 0.0f;
+        for (uint32 tick = 0; tick < Ticks; ++tick)
+        {
+            for (uint32 i = 0; i < ThreatEventsPerTick; ++i)
+            {
+                uint32 target = events[tick * ThreatEventsPerTick + i];
+                entries[target].Threat += 10.0f + float(i % 7);
+                heap.increase(handles[target]);
+            }
+
+            if (tick % TicksPerReselect == 0)
+                topThreat += heap.top()->Threat;
+        }
+        return topThreat;
+    };
+
+    BENCHMARK("Trinity::LazySortedVector")
+    {
+        std::vector<Entry> entries(ThreatListSize);
+        EntryList list;
+        for (Entry& entry : entries)
+            list.Insert(&entry);
+
+        float topThreat = 0.0f;
+        for (uint32 tick = 0; tick < Ticks; ++tick)
+        {
+            for (uint32 i = 0; i < ThreatEventsPerTick; ++i)
+            {
+                uint32 target = events[tick * ThreatEventsPerTick + i];
+                entries[target].Threat += 10.0f + float(i % 7);
+                list.Invalidate();
+            }
+
+            if (tick % TicksPerReselect == 0)
+                topThreat += list.Top()->Threat;
+        }
+        return topThreat;
+    };
+}
@@ -0,0 +1,196 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "MPSCQueue.h"
+#include "Define.h"
+#include "LockedQueue.h"
+#include <deque>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct TestPacket
+    {
+        explicit TestPacket(uint32 producer, uint32 sequence) : Producer(producer), Sequence(sequence) { }
+
+        uint32 Producer;
+        uint32 Sequence;
+        std::atomic<TestPacket*> Link;
+    };
+
+    using IntrusiveQueue = MPSCQueue<TestPacket, &TestPacket::Link>;
+    using NonIntrusiveQueue = MPSCQueue<TestPacket>;
+}
+
+TEMPLATE_TEST_CASE("MPSCQueue", "[MPSCQueue]", IntrusiveQueue, NonIntrusiveQueue)
+{
+    TestType queue;
+    TestPacket* packet = nullptr;
+
+    SECTION("Empty queue")
+    {
+        REQUIRE_FALSE(queue.Dequeue(packet));
+    }
+
+    SECTION("Single producer keeps order")
+    {
+        for (uint32 i = 0; i < 100; ++i)
+            queue.Enqueue(new TestPacket(0, i));
+
+        for (uint32 i = 0; i < 100; ++i)
+        {
+            REQUIRE(queue.Dequeue(packet));
+            REQUIRE(packet->Sequence == i);
+            delete packet;
+        }
+
+        REQUIRE_FALSE(queue.Dequeue(packet));
+    }
+
+    SECTION("Interleaved enqueue and dequeue")
+    {
+        queue.Enqueue(new TestPacket(0, 0));
+        REQUIRE(queue.Dequeue(packet));
+        REQUIRE(packet->Sequence == 0);
+        delete packet;
+
+        queue.Enqueue(new TestPacket(0, 1));
+        queue.Enqueue(new TestPacket(0, 2));
+        REQUIRE(queue.Dequeue(packet));
+        REQUIRE(packet->Sequence == 1);
+        delete packet;
+        REQUIRE(queue.Dequeue(packet));
+        REQUIRE(packet->Sequence == 2);
+        delete packet;
+        REQUIRE_FALSE(queue.Dequeue(packet));
+    }
+
+    SECTION("Multiple producers")
+    {
+        constexpr uint32 ProducerCount = 4;
+        constexpr uint32 PacketsPerProducer = 10000;
+
+        std::vector<std::thread> producers;
+        for (uint32 p = 0; p < ProducerCount; ++p)
+            producers.emplace_back([&queue, p]()
+            {
+                for (uint32 i = 0; i < PacketsPerProducer; ++i)
+                    queue.Enqueue(new TestPacket(p, i));
+            });
+
+        // every producer's packets must come out in the order it queued them
+        std::vector<uint32> nextSequence(ProducerCount, 0);
+        uint32 received = 0;
+        while (received < ProducerCount * PacketsPerProducer)
+        {
+            if (!queue.Dequeue(packet))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            REQUIRE(packet->Sequence == nextSequence[packet->Producer]);
+            ++nextSequence[packet->Producer];
+            ++received;
+            delete packet;
+        }
+
+        for (std::thread& producer : producers)
+            producer.join();
+
+        REQUIRE_FALSE(queue.Dequeue(packet));
+    }
+}
+
+namespace
+{
+    // every 8th packet has to wait for the other update thread, like WorldSessionFilter/MapSessionFilter
+    struct AlternatingFilter
+    {
+        bool Process(TestPacket* packet) const { return ((packet->Sequence & 7) == 7) == WorldThread; }
+
+        bool WorldThread = false;
+    };
+
+    constexpr uint32 BenchmarkPackets = 200000;
+
+    // one network thread queues packets of a single session while the update thread processes them
+    template<typename Drain>
+    uint64 RunSession(std::function<void(TestPacket*)> const& enqueue, Drain drain)
+    {
+        std::thread network([&enqueue]()
+        {
+            for (uint32 i = 0; i < BenchmarkPackets; ++i)
+                enqueue(new TestPacket(0, i));
+        });
+
+        uint64 processed = 0;
+        AlternatingFilter filter;
+        while (processed < BenchmarkPackets)
+        {
+            processed += drain(filter);
+            filter.WorldThread = !filter.WorldThread;
+        }
+
+        network.join();
+        return processed;
+    }
+}
+
+TEST_CASE("Session receive queue throughput", "[MPSCQueue][!benchmark]")
+{
+    BENCHMARK("LockedQueue with filtered next()")
+    {
+        LockedQueue<TestPacket*> queue;
+        return RunSession([&queue](TestPacket* packet) { queue.add(packet); }, [&queue](AlternatingFilter& filter)
+        {
+            uint64 processed = 0;
+            TestPacket* packet = nullptr;
+            while (queue.next(packet, filter))
+            {
+                delete packet;
+                ++processed;
+            }
+            return processed;
+        });
+    };
+
+    BENCHMARK("MPSCQueue with consumer side pending list")
+    {
+        IntrusiveQueue queue;
+        std::deque<TestPacket*> pending;
+        return RunSession([&queue](TestPacket* packet) { queue.Enqueue(packet); }, [&queue, &pending](AlternatingFilter& filter)
+        {
+            uint64 processed = 0;
+            TestPacket* packet = nullptr;
+            while (queue.Dequeue(packet))
+                pending.push_back(packet);
+
+            while (!pending.empty() && filter.Process(pending.front()))
+            {
+                delete pending.front();
+                pending.pop_front();
+                ++processed;
+            }
+            return processed;
+        });
+    };
+}
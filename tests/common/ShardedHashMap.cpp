@@ -0,0 +1,164 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ShardedHashMap.h"
+#include "Define.h"
+#include <thread>
+#include <vector>
+
+TEST_CASE("ShardedHashMap", "[ShardedHashMap]")
+{
+    Trinity::ShardedHashMap<uint64, int*> map;
+    int values[100];
+
+    for (uint64 i = 0; i < 100; ++i)
+        map.Insert(i, &values[i]);
+
+    REQUIRE(map.Size() == 100);
+
+    SECTION("Find")
+    {
+        for (uint64 i = 0; i < 100; ++i)
+            REQUIRE(map.Find(i) == &values[i]);
+
+        REQUIRE(map.Find(100) == nullptr);
+    }
+
+    SECTION("Insert replaces existing values")
+    {
+        map.Insert(5, &values[6]);
+        REQUIRE(map.Find(5) == &values[6]);
+        REQUIRE(map.Size() == 100);
+    }
+
+    SECTION("Remove")
+    {
+        REQUIRE(map.Remove(5));
+        REQUIRE_FALSE(map.Remove(5));
+        REQUIRE(map.Find(5) == nullptr);
+        REQUIRE(map.Size() == 99);
+    }
+
+    SECTION("DoForAll visits every element once")
+    {
+        std::vector<uint32> seen(100, 0);
+        map.DoForAll([&](uint64 key, int* value)
+        {
+            REQUIRE(value == &values[key]);
+            ++seen[key];
+        });
+
+        for (uint32 count : seen)
+            REQUIRE(count == 1);
+    }
+}
+
+namespace
+{
+    // the registry layout ShardedHashMap replaces in HashMapHolder
+    class SingleLockMap
+    {
+    public:
+        void Insert(uint64 key, int* value)
+        {
+            std::unique_lock<std::shared_mutex> lock(_lock);
+            _map[key] = value;
+        }
+
+        bool Remove(uint64 key)
+        {
+            std::unique_lock<std::shared_mutex> lock(_lock);
+            return _map.erase(key) != 0;
+        }
+
+        int* Find(uint64 key) const
+        {
+            std::shared_lock<std::shared_mutex> lock(_lock);
+            auto itr = _map.find(key);
+            return itr != _map.end() ? itr->second : nullptr;
+        }
+
+    private:
+        mutable std::shared_mutex _lock;
+        std::unordered_map<uint64, int*> _map;
+    };
+
+    // every thread looks up random online players, one lookup in 64 is a login or logout
+    template<typename Map>
+    uint64 RunContention(Map& map, uint32 threadCount, uint32 keyCount, uint32 operationsPerThread)
+    {
+        std::vector<std::thread> threads;
+        std::vector<uint64> found(threadCount, 0);
+        for (uint32 t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                uint64 seed = t * 7919 + 1;
+                uint64 hits = 0;
+                for (uint32 i = 0; i < operationsPerThread; ++i)
+                {
+                    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                    uint64 key = (seed >> 33) % keyCount;
+                    if ((i & 63) == 63)
+                    {
+                        map.Remove(key);
+                        map.Insert(key, reinterpret_cast<int*>(key + 1));
+                    }
+                    else if (map.Find(key))
+                        ++hits;
+                }
+                found[t] = hits;
+            });
+        }
+
+        uint64 total = 0;
+        for (uint32 t = 0; t < threadCount; ++t)
+        {
+            threads[t].join();
+            total += found[t];
+        }
+
+        return total;
+    }
+}
+
+TEST_CASE("ShardedHashMap contention", "[ShardedHashMap][!benchmark]")
+{
+    constexpr uint32 ThreadCount = 16;
+    constexpr uint32 KeyCount = 5000;
+    constexpr uint32 OperationsPerThread = 20000;
+
+    SingleLockMap singleLock;
+    Trinity::ShardedHashMap<uint64, int*> sharded;
+    for (uint64 i = 0; i < KeyCount; ++i)
+    {
+        singleLock.Insert(i, reinterpret_cast<int*>(i + 1));
+        sharded.Insert(i, reinterpret_cast<int*>(i + 1));
+    }
+
+    BENCHMARK("Single shared_mutex, 16 threads")
+    {
+        return RunContention(singleLock, ThreadCount, KeyCount, OperationsPerThread);
+    };
+
+    BENCHMARK("Sharded, 16 threads")
+    {
+        return RunContention(sharded, ThreadCount, KeyCount, OperationsPerThread);
+    };
+}
@@ -0,0 +1,170 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define CATCH_CONFIG_ENABLE_CHRONO_STRINGMAKER
+#include "tc_catch2.h"
+
+#include "TaskScheduler.h"
+#include <vector>
+
+enum GROUPS
+{
+    GROUP_1 = 1,
+    GROUP_2 = 2
+};
+
+TEST_CASE("TaskScheduler: Tasks are executed in order", "[TaskScheduler]")
+{
+    TaskScheduler scheduler;
+    std::vector<uint32> executed;
+
+    scheduler.Schedule(2s, [&](TaskContext) { executed.push_back(3); });
+    scheduler.Schedule(1s, [&](TaskContext) { executed.push_back(1); });
+    scheduler.Schedule(1s, [&](TaskContext) { executed.push_back(2); });
+
+    scheduler.Update(500ms);
+    REQUIRE(executed.empty());
+
+    scheduler.Update(1500ms);
+    REQUIRE(executed == std::vector<uint32>{ 1, 2, 3 });
+}
+
+TEST_CASE("TaskScheduler: Repeat a task", "[TaskScheduler]")
+{
+    TaskScheduler scheduler;
+    uint32 repeated = 0;
+    uint32 calls = 0;
+
+    scheduler.Schedule(1s, [&](TaskContext context)
+    {
+        ++calls;
+        repeated = context.GetRepeatCounter();
+        if (repeated < 2)
+            context.Repeat();
+    });
+
+    for (uint32 i = 0; i < 5; ++i)
+        scheduler.Update(1s);
+
+    REQUIRE(calls == 3);
+    REQUIRE(repeated == 2);
+}
+
+TEST_CASE("TaskScheduler: Cancel and delay groups", "[TaskScheduler]")
+{
+    TaskScheduler scheduler;
+    std::vector<uint32> executed;
+
+    scheduler.Schedule(1s, GROUP_1, [&](TaskContext) { executed.push_back(1); });
+    scheduler.Schedule(1s, GROUP_2, [&](TaskContext) { executed.push_back(2); });
+    scheduler.Schedule(1s, [&](TaskContext) { executed.push_back(3); });
+
+    SECTION("Cancel group")
+    {
+        scheduler.CancelGroup(GROUP_1);
+        scheduler.Update(1s);
+
+        REQUIRE(executed == std::vector<uint32>{ 2, 3 });
+    }
+
+    SECTION("Delay group")
+    {
+        scheduler.DelayGroup(GROUP_1, 1s);
+        scheduler.Update(1s);
+        REQUIRE(executed == std::vector<uint32>{ 2, 3 });
+
+        scheduler.Update(1s);
+        REQUIRE(executed == std::vector<uint32>{ 2, 3, 1 });
+    }
+
+    SECTION("Reschedule all keeps the previous order")
+    {
+        scheduler.RescheduleAll(2s);
+        scheduler.Update(1s);
+        REQUIRE(executed.empty());
+
+        scheduler.Update(1s);
+        REQUIRE(executed == std::vector<uint32>{ 1, 2, 3 });
+    }
+
+    SECTION("Cancel group from within a task context")
+    {
+        scheduler.Schedule(500ms, [](TaskContext context) { context.CancelGroup(GROUP_2); });
+        scheduler.Update(1s);
+
+        REQUIRE(executed == std::vector<uint32>{ 1, 3 });
+    }
+}
+
+TEST_CASE("TaskScheduler: Schedule from within a task context", "[TaskScheduler]")
+{
+    TaskScheduler scheduler;
+    std::vector<uint32> executed;
+
+    scheduler.Schedule(1s, [&](TaskContext context)
+    {
+        executed.push_back(1);
+        context.Schedule(1s, GROUP_1, [&](TaskContext inner)
+        {
+            executed.push_back(2);
+            REQUIRE(inner.IsInGroup(GROUP_1));
+        });
+    });
+
+    scheduler.Update(1s);
+    REQUIRE(executed == std::vector<uint32>{ 1 });
+
+    scheduler.Update(1s);
+    REQUIRE(executed == std::vector<uint32>{ 1, 2 });
+}
+
+TEST_CASE("TaskScheduler throughput", "[TaskScheduler][!benchmark]")
+{
+    constexpr uint32 TaskCount = 16;
+
+    BENCHMARK("Schedule and update repeating tasks")
+    {
+        TaskScheduler scheduler;
+        uint32 executed = 0;
+        for (uint32 i = 0; i < TaskCount; ++i)
+        {
+            scheduler.Schedule(Milliseconds(100 + i * 50), i % 4, [&executed](TaskContext context)
+            {
+                ++executed;
+                context.Repeat(Milliseconds(100 + context.GetRepeatCounter() % 8 * 50));
+            });
+        }
+
+        for (uint32 tick = 0; tick < 100; ++tick)
+            scheduler.Update(50ms);
+
+        return executed;
+    };
+
+    BENCHMARK_ADVANCED("Schedule and cancel groups")(Catch::Benchmark::Chronometer meter)
+    {
+        TaskScheduler scheduler;
+        meter.measure([&](int i)
+        {
+            uint32 group = uint32(i) % 4 + 1;
+            scheduler.Schedule(Milliseconds(100 + i % 1000), group, [](TaskContext) { });
+            scheduler.Schedule(Milliseconds(200 + i % 1000), group % 4 + 1, [](TaskContext) { });
+            scheduler.CancelGroup(group);
+            return &scheduler;
+        });
+    };
+}
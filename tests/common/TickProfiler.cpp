@@ -0,0 +1,51 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "TickProfiler.h"
+#include <sstream>
+#include <thread>
+
+TEST_CASE("TickProfiler writes the zones of a tick as Chrome trace events", "[TickProfiler]")
+{
+    TimePoint tickStart = std::chrono::steady_clock::now() + 1h;
+    TimePoint tickEnd = tickStart + 100ms;
+
+    sTickProfiler->RecordZone("BeforeTick", tickStart - 10ms, tickStart - 5ms);
+    sTickProfiler->RecordZone("Inner", tickStart + 10ms, tickStart + 20ms);
+    sTickProfiler->RecordZone("Outer", tickStart + 5ms, tickStart + 50ms);
+    std::thread([&]()
+    {
+        sTickProfiler->RecordZone("Other \"thread\"", tickStart + 1ms, tickStart + 1500us);
+    }).join();
+    sTickProfiler->RecordZone("AfterTick", tickEnd - 1ms, tickEnd + 1ms);
+
+    std::ostringstream trace;
+    sTickProfiler->WriteTrace(trace, tickStart, tickEnd);
+    std::string json = trace.str();
+
+    REQUIRE(json.find("BeforeTick") == std::string::npos);
+    REQUIRE(json.find("AfterTick") == std::string::npos);
+    REQUIRE(json.find("{\"name\":\"Inner\",\"ph\":\"X\"") != std::string::npos);
+    REQUIRE(json.find("\"ts\":10000.000,\"dur\":10000.000}") != std::string::npos);
+    REQUIRE(json.find("{\"name\":\"Outer\",\"ph\":\"X\"") != std::string::npos);
+    REQUIRE(json.find("\"ts\":5000.000,\"dur\":45000.000}") != std::string::npos);
+    REQUIRE(json.find("{\"name\":\"Other \\\"thread\\\"\",\"ph\":\"X\"") != std::string::npos);
+    REQUIRE(json.find("\"ts\":1000.000,\"dur\":500.000}") != std::string::npos);
+    REQUIRE(json.rfind("{\"traceEvents\":[", 0) == 0);
+}
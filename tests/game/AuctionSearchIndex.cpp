@@ -0,0 +1,185 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "AuctionSearchIndex.h"
+#include "ItemTemplate.h"
+#include <vector>
+
+namespace
+{
+    AuctionSearchIndex::Entry MakeEntry(uint32 id, uint32 itemClass, uint32 itemSubClass, uint32 inventoryType, uint32 quality, uint32 requiredLevel)
+    {
+        AuctionSearchIndex::Entry entry;
+        entry.AuctionId = id;
+        entry.ItemClass = itemClass;
+        entry.ItemSubClass = itemSubClass;
+        entry.InventoryType = inventoryType;
+        entry.Quality = quality;
+        entry.RequiredLevel = requiredLevel;
+        return entry;
+    }
+
+    std::vector<uint32> Search(AuctionSearchIndex& index, AuctionSearchIndex::Filter const& filter)
+    {
+        std::vector<uint32> ids;
+        index.Visit(filter, [&](AuctionSearchIndex::Entry& entry)
+        {
+            ids.push_back(entry.AuctionId);
+            return true;
+        });
+        return ids;
+    }
+}
+
+TEST_CASE("AuctionSearchIndex: Filters", "[AuctionSearchIndex]")
+{
+    AuctionSearchIndex index;
+    index.Insert(MakeEntry(5, ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_CLOTH, INVTYPE_ROBE, ITEM_QUALITY_RARE, 70));
+    index.Insert(MakeEntry(2, ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_CLOTH, INVTYPE_CHEST, ITEM_QUALITY_EPIC, 80));
+    index.Insert(MakeEntry(9, ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_PLATE, INVTYPE_CHEST, ITEM_QUALITY_EPIC, 80));
+    index.Insert(MakeEntry(1, ITEM_CLASS_WEAPON, ITEM_SUBCLASS_WEAPON_SWORD, INVTYPE_WEAPON, ITEM_QUALITY_UNCOMMON, 10));
+    index.Insert(MakeEntry(7, ITEM_CLASS_TRADE_GOODS, 0, INVTYPE_NON_EQUIP, ITEM_QUALITY_NORMAL, 0));
+    REQUIRE(index.GetSize() == 5);
+
+    AuctionSearchIndex::Filter filter;
+
+    SECTION("No filter lists everything in id order")
+    {
+        REQUIRE(Search(index, filter) == std::vector<uint32>{ 1, 2, 5, 7, 9 });
+    }
+
+    SECTION("Class and subclass")
+    {
+        filter.ItemClass = ITEM_CLASS_ARMOR;
+        REQUIRE(Search(index, filter) == std::vector<uint32>{ 2, 5, 9 });
+
+        filter.ItemSubClass = ITEM_SUBCLASS_ARMOR_CLOTH;
+        REQUIRE(Search(index, filter) == std::vector<uint32>{ 2, 5 });
+
+        filter.ItemClass = ITEM_CLASS_QUEST;
+        REQUIRE(Search(index, filter).empty());
+    }
+
+    SECTION("Chest also matches robes")
+    {
+        filter.InventoryType = INVTYPE_CHEST;
+        REQUIRE(Search(index, filter) == std::vector<uint32>{ 2, 5, 9 });
+
+        filter.InventoryType = INVTYPE_ROBE;
+        REQUIRE(Search(index, filter) == std::vector<uint32>{ 5 });
+    }
+
+    SECTION("Quality and level range")
+    {
+        filter.Quality = ITEM_QUALITY_EPIC;
+        REQUIRE(Search(index, filter) == std::vector<uint32>{ 2, 9 });
+
+        filter.Quality = AuctionSearchIndex::ANY;
+        filter.LevelMin = 10;
+        filter.LevelMax = 70;
+        REQUIRE(Search(index, filter) == std::vector<uint32>{ 1, 5 });
+
+        filter.LevelMax = 0;
+        REQUIRE(Search(index, filter) == std::vector<uint32>{ 1, 2, 5, 9 });
+
+        filter.LevelMin = 71;
+        filter.LevelMax = 79;
+        REQUIRE(Search(index, filter).empty());
+    }
+
+    SECTION("Reversed level range matches nothing")
+    {
+        filter.LevelMin = 80;
+        filter.LevelMax = 10;
+        REQUIRE(Search(index, filter).empty());
+
+        filter.ItemClass = ITEM_CLASS_ARMOR;
+        REQUIRE(Search(index, filter).empty());
+    }
+
+    SECTION("Remove and replace")
+    {
+        index.Remove(2);
+        index.Remove(3);
+        index.Insert(MakeEntry(9, ITEM_CLASS_WEAPON, ITEM_SUBCLASS_WEAPON_MACE, INVTYPE_WEAPON, ITEM_QUALITY_RARE, 60));
+        REQUIRE(index.GetSize() == 4);
+
+        filter.ItemClass = ITEM_CLASS_ARMOR;
+        REQUIRE(Search(index, filter) == std::vector<uint32>{ 5 });
+
+        filter.ItemClass = ITEM_CLASS_WEAPON;
+        REQUIRE(Search(index, filter) == std::vector<uint32>{ 1, 9 });
+    }
+
+    SECTION("Visitor can stop the search")
+    {
+        uint32 visited = 0;
+        index.Visit(filter, [&](AuctionSearchIndex::Entry&) { return ++visited < 2; });
+        REQUIRE(visited == 2);
+    }
+}
+
+TEST_CASE("AuctionSearchIndex: Cached names", "[AuctionSearchIndex]")
+{
+    AuctionSearchIndex::Entry entry;
+    REQUIRE(entry.GetName(0) == nullptr);
+
+    entry.SetName(0, L"runecloth bag");
+    entry.SetName(3, L"runenstoffbeutel");
+    REQUIRE(*entry.GetName(0) == L"runecloth bag");
+    REQUIRE(*entry.GetName(3) == L"runenstoffbeutel");
+    REQUIRE(entry.GetName(2) == nullptr);
+}
+
+TEST_CASE("AuctionSearchIndex search latency", "[AuctionSearchIndex][!benchmark]")
+{
+    for (uint32 auctionCount : { 1000u, 10000u, 50000u })
+    {
+        AuctionSearchIndex index;
+        for (uint32 i = 1; i <= auctionCount; ++i)
+            index.Insert(MakeEntry(i, i % MAX_ITEM_CLASS, i % 7, i % MAX_INVTYPE, i % MAX_ITEM_QUALITY, i % 81));
+
+        AuctionSearchIndex::Filter filter;
+        filter.ItemClass = ITEM_CLASS_ARMOR;
+        filter.ItemSubClass = ITEM_SUBCLASS_ARMOR_CLOTH;
+
+        BENCHMARK("Class and subclass, " + std::to_string(auctionCount) + " auctions")
+        {
+            return Search(index, filter).size();
+        };
+
+        filter = {};
+        filter.LevelMin = 75;
+        filter.LevelMax = 80;
+
+        BENCHMARK("Level range, " + std::to_string(auctionCount) + " auctions")
+        {
+            return Search(index, filter).size();
+        };
+
+        filter = {};
+        filter.Quality = ITEM_QUALITY_EPIC;
+        filter.LevelMin = 1;
+
+        BENCHMARK("Quality and minimum level, " + std::to_string(auctionCount) + " auctions")
+        {
+            return Search(index, filter).size();
+        };
+    }
+}
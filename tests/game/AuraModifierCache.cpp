@@ -0,0 +1,145 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "AuraModifierCache.h"
+#include <functional>
+#include <map>
+#include <vector>
+
+TEST_CASE("AuraModifierCache", "[AuraModifierCache]")
+{
+    AuraModifierCache cache;
+    int32 modifier = 0;
+    float multiplier = 0.0f;
+
+    cache.StoreModifier(SPELL_AURA_MOD_STAT, AuraModifierTotal::Modifier, AuraModifierFilter::MiscValue, 1, 25);
+    cache.StoreModifier(SPELL_AURA_MOD_STAT, AuraModifierTotal::MaxPositiveModifier, AuraModifierFilter::MiscValue, 1, 20);
+    cache.StoreMultiplier(SPELL_AURA_MOD_STAT, AuraModifierFilter::None, 0, 1.1f);
+    cache.StoreModifier(SPELL_AURA_MOD_RESISTANCE, AuraModifierTotal::Modifier, AuraModifierFilter::MiscMask, 0x7E, -40);
+
+    SECTION("Entries are keyed by total, filter and misc value")
+    {
+        REQUIRE(cache.GetModifier(SPELL_AURA_MOD_STAT, AuraModifierTotal::Modifier, AuraModifierFilter::MiscValue, 1, modifier));
+        REQUIRE(modifier == 25);
+        REQUIRE(cache.GetModifier(SPELL_AURA_MOD_STAT, AuraModifierTotal::MaxPositiveModifier, AuraModifierFilter::MiscValue, 1, modifier));
+        REQUIRE(modifier == 20);
+        REQUIRE(cache.GetMultiplier(SPELL_AURA_MOD_STAT, AuraModifierFilter::None, 0, multiplier));
+        REQUIRE(multiplier == 1.1f);
+        REQUIRE(cache.GetModifier(SPELL_AURA_MOD_RESISTANCE, AuraModifierTotal::Modifier, AuraModifierFilter::MiscMask, 0x7E, modifier));
+        REQUIRE(modifier == -40);
+
+        REQUIRE_FALSE(cache.GetModifier(SPELL_AURA_MOD_STAT, AuraModifierTotal::Modifier, AuraModifierFilter::MiscValue, 2, modifier));
+        REQUIRE_FALSE(cache.GetModifier(SPELL_AURA_MOD_STAT, AuraModifierTotal::Modifier, AuraModifierFilter::MiscMask, 1, modifier));
+        REQUIRE_FALSE(cache.GetModifier(SPELL_AURA_MOD_STAT, AuraModifierTotal::MaxNegativeModifier, AuraModifierFilter::MiscValue, 1, modifier));
+        REQUIRE_FALSE(cache.GetMultiplier(SPELL_AURA_MOD_RESISTANCE, AuraModifierFilter::None, 0, multiplier));
+    }
+
+    SECTION("Invalidate drops only the changed aura type")
+    {
+        cache.Invalidate(SPELL_AURA_MOD_STAT);
+        REQUIRE(cache.Size() == 1);
+        REQUIRE_FALSE(cache.GetModifier(SPELL_AURA_MOD_STAT, AuraModifierTotal::Modifier, AuraModifierFilter::MiscValue, 1, modifier));
+        REQUIRE_FALSE(cache.GetMultiplier(SPELL_AURA_MOD_STAT, AuraModifierFilter::None, 0, multiplier));
+        REQUIRE(cache.GetModifier(SPELL_AURA_MOD_RESISTANCE, AuraModifierTotal::Modifier, AuraModifierFilter::MiscMask, 0x7E, modifier));
+
+        cache.Invalidate(SPELL_AURA_MOD_MELEE_HASTE);
+        REQUIRE(cache.Size() == 1);
+    }
+
+    SECTION("Spell group reload drops everything")
+    {
+        cache.ValidateSpellGroups(0);
+        REQUIRE(cache.Size() == 4);
+
+        cache.ValidateSpellGroups(1);
+        REQUIRE(cache.Size() == 0);
+    }
+}
+
+namespace
+{
+    struct FakeEffect
+    {
+        int32 MiscValue;
+        int32 Amount;
+        uint32 SpellGroup;
+    };
+
+    // the previous uncached path: std::function predicate and a std::map for the same effect stacking groups
+    int32 SumUncached(std::vector<FakeEffect> const& effects, std::function<bool(FakeEffect const&)> const& predicate)
+    {
+        std::map<uint32, int32> sameEffectSpellGroup;
+        int32 modifier = 0;
+        for (FakeEffect const& effect : effects)
+        {
+            if (!predicate(effect))
+                continue;
+
+            if (effect.SpellGroup)
+            {
+                auto itr = sameEffectSpellGroup.find(effect.SpellGroup);
+                if (itr == sameEffectSpellGroup.end())
+                    sameEffectSpellGroup.emplace(effect.SpellGroup, effect.Amount);
+                else if (std::abs(itr->second) < std::abs(effect.Amount))
+                    itr->second = effect.Amount;
+            }
+            else
+                modifier += effect.Amount;
+        }
+
+        for (auto const& pair : sameEffectSpellGroup)
+            modifier += pair.second;
+
+        return modifier;
+    }
+}
+
+TEST_CASE("AuraModifierCache calls per second", "[AuraModifierCache][!benchmark]")
+{
+    // five stat buffs on a raid member, two of them from the same exclusive group
+    std::vector<FakeEffect> effects = { { -1, 37, 1 }, { -1, 51, 1 }, { 3, 20, 0 }, { 4, 15, 0 }, { 0, 8, 2 } };
+
+    AuraModifierCache cache;
+    for (int32 stat = 0; stat < 5; ++stat)
+        cache.StoreModifier(SPELL_AURA_MOD_STAT, AuraModifierTotal::Modifier, AuraModifierFilter::MiscValue, stat,
+            SumUncached(effects, [stat](FakeEffect const& effect) { return effect.MiscValue < 0 || effect.MiscValue == stat; }));
+
+    constexpr uint32 Calls = 100000;
+
+    BENCHMARK("Recalculate on every call")
+    {
+        int64 total = 0;
+        for (uint32 i = 0; i < Calls; ++i)
+        {
+            int32 stat = int32(i % 5);
+            total += SumUncached(effects, [stat](FakeEffect const& effect) { return effect.MiscValue < 0 || effect.MiscValue == stat; });
+        }
+        return total;
+    };
+
+    BENCHMARK("Cached totals")
+    {
+        int64 total = 0;
+        int32 modifier = 0;
+        for (uint32 i = 0; i < Calls; ++i)
+            if (cache.GetModifier(SPELL_AURA_MOD_STAT, AuraModifierTotal::Modifier, AuraModifierFilter::MiscValue, int32(i % 5), modifier))
+                total += modifier;
+        return total;
+    };
+}
@@ -0,0 +1,138 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "AuraProcIndex.h"
+#include <map>
+#include <unordered_map>
+
+namespace
+{
+    AuraApplication* FakeApplication(uintptr_t id)
+    {
+        return reinterpret_cast<AuraApplication*>(id * 16);
+    }
+
+    constexpr uint32 MeleeFlag = 0x00000004;
+    constexpr uint32 TakenMeleeFlag = 0x00000008;
+    constexpr uint32 SpellFlag = 0x00010000;
+    constexpr uint32 PeriodicFlag = 0x00040000;
+}
+
+TEST_CASE("AuraProcIndex", "[AuraProcIndex]")
+{
+    AuraProcIndex index;
+    AuraProcIndex::Candidates auras;
+
+    index.Insert(300, SpellFlag, FakeApplication(1));
+    index.Insert(100, MeleeFlag | SpellFlag, FakeApplication(2));
+    index.Insert(200, MeleeFlag, FakeApplication(3));
+    index.Insert(100, MeleeFlag, FakeApplication(4));
+    index.Insert(400, 0, FakeApplication(5));
+
+    REQUIRE(index.Size() == 4);
+    REQUIRE(index.GetProcFlags() == (MeleeFlag | SpellFlag));
+
+    SECTION("Collect keeps spell id order, same spell in application order")
+    {
+        index.Collect(MeleeFlag, auras);
+        REQUIRE(auras == AuraProcIndex::Candidates{ FakeApplication(2), FakeApplication(4), FakeApplication(3) });
+    }
+
+    SECTION("Collect with several flags returns each aura once")
+    {
+        index.Collect(MeleeFlag | SpellFlag, auras);
+        REQUIRE(auras.size() == 4);
+    }
+
+    SECTION("Events no aura reacts to")
+    {
+        index.Collect(PeriodicFlag, auras);
+        REQUIRE(auras.empty());
+    }
+
+    SECTION("Remove updates the reacting flags")
+    {
+        index.Remove(FakeApplication(1));
+        index.Collect(SpellFlag, auras);
+        REQUIRE(auras == AuraProcIndex::Candidates{ FakeApplication(2) });
+
+        index.Remove(FakeApplication(2));
+        REQUIRE(index.GetProcFlags() == MeleeFlag);
+
+        index.Remove(FakeApplication(5));
+        REQUIRE(index.Size() == 2);
+    }
+
+    SECTION("Clear")
+    {
+        index.Clear();
+        REQUIRE(index.Size() == 0);
+        REQUIRE(index.GetProcFlags() == 0);
+    }
+}
+
+TEST_CASE("AuraProcIndex combat replay", "[AuraProcIndex][!benchmark]")
+{
+    // raid buffed player: 64 applied auras, 6 of them with spell_proc entries
+    std::unordered_map<uint32, uint32> procEntries;
+    std::multimap<uint32, AuraApplication*> appliedAuras;
+    AuraProcIndex index;
+    for (uint32 i = 0; i < 64; ++i)
+    {
+        uint32 spellId = 1000 + i * 37;
+        appliedAuras.emplace(spellId, FakeApplication(i + 1));
+        if (i % 11 == 0)
+        {
+            uint32 procFlags = (i % 2) ? (MeleeFlag | SpellFlag) : TakenMeleeFlag;
+            procEntries[spellId] = procFlags;
+            index.Insert(spellId, procFlags, FakeApplication(i + 1));
+        }
+    }
+
+    // swings, spell hits and periodic ticks in the proportion of a melee fight
+    std::vector<uint32> events;
+    for (uint32 i = 0; i < 10000; ++i)
+        events.push_back(i % 4 == 0 ? MeleeFlag : (i % 4 == 1 ? TakenMeleeFlag : (i % 4 == 2 ? SpellFlag : PeriodicFlag)));
+
+    BENCHMARK("Scan applied auras")
+    {
+        uint64 candidates = 0;
+        for (uint32 typeMask : events)
+            for (auto const& pair : appliedAuras)
+            {
+                auto itr = procEntries.find(pair.first);
+                if (itr != procEntries.end() && (itr->second & typeMask))
+                    ++candidates;
+            }
+        return candidates;
+    };
+
+    BENCHMARK("Proc flag index")
+    {
+        uint64 candidates = 0;
+        AuraProcIndex::Candidates auras;
+        for (uint32 typeMask : events)
+        {
+            auras.clear();
+            index.Collect(typeMask, auras);
+            candidates += auras.size();
+        }
+        return candidates;
+    };
+}
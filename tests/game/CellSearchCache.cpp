@@ -0,0 +1,152 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "CellSearchCache.h"
+
+TEST_CASE("CellSearchCache fills a cell once per generation", "[CellSearchCache]")
+{
+    CellSearchCache<int> cache;
+    uint32 fills = 0;
+    auto fill = [&fills](std::vector<int>& objects)
+    {
+        ++fills;
+        objects.push_back(1);
+        objects.push_back(2);
+    };
+
+    REQUIRE(cache.GetCell(5, fill).size() == 2);
+    REQUIRE(cache.GetCell(5, fill).size() == 2);
+    REQUIRE(fills == 1);
+    REQUIRE(cache.GetFilledCount() == 1);
+    REQUIRE(cache.GetReusedCount() == 1);
+
+    SECTION("Other cells are filled separately")
+    {
+        cache.GetCell(6, fill);
+        REQUIRE(fills == 2);
+    }
+
+    SECTION("Invalidate refills on next access")
+    {
+        cache.Invalidate();
+        REQUIRE(cache.GetCell(5, fill).size() == 2);
+        REQUIRE(fills == 2);
+    }
+
+    SECTION("NewUpdate refills and resets counters")
+    {
+        cache.NewUpdate();
+        REQUIRE(cache.GetFilledCount() == 0);
+        REQUIRE(cache.GetReusedCount() == 0);
+        cache.GetCell(5, fill);
+        REQUIRE(fills == 2);
+        REQUIRE(cache.GetFilledCount() == 1);
+    }
+}
+
+TEST_CASE("CellSearchCache drops cells unused for a whole update", "[CellSearchCache]")
+{
+    CellSearchCache<int> cache;
+    uint32 fills = 0;
+    auto fill = [&fills](std::vector<int>& objects) { ++fills; objects.push_back(int(fills)); };
+
+    cache.GetCell(1, fill);
+    cache.GetCell(2, fill);
+    cache.NewUpdate();
+    REQUIRE(cache.GetCell(1, fill).front() == 3);
+    cache.NewUpdate();
+    cache.NewUpdate();
+    // cell 2 was dropped, cell 1 refilled: both produce fresh objects
+    REQUIRE(cache.GetCell(2, fill).front() == 4);
+    REQUIRE(cache.GetCell(1, fill).front() == 5);
+}
+
+namespace
+{
+    // grid containers are intrusive lists threaded through the objects, and units are large
+    struct FakeUnit
+    {
+        FakeUnit* Next = nullptr;
+        float X = 0.0f;
+        float Y = 0.0f;
+        uint32 Phase = 1;
+        char Fields[2048];
+    };
+
+    constexpr uint32 Cells = 9;
+    constexpr uint32 Units = 400;
+}
+
+TEST_CASE("Area aura target search", "[CellSearchCache][!benchmark]")
+{
+    // a raid with pets and an encounter's adds spread over the 3x3 cells around the fight,
+    // linked in an order unrelated to where they live in memory
+    std::vector<FakeUnit> units(Units);
+    FakeUnit* cells[Cells] = { };
+    for (uint32 i = 0; i < Units; ++i)
+    {
+        FakeUnit& unit = units[(i * 157) % Units];
+        unit.X = float(i % 20) * 3.0f;
+        unit.Y = float(i / 20) * 3.0f;
+        unit.Next = cells[i % Cells];
+        cells[i % Cells] = &unit;
+    }
+
+    // area auras (raid buffs, persistent ground effects) refreshing their targets in one map update
+    constexpr uint32 Searches = 30;
+    constexpr float RadiusSq = 30.0f * 30.0f;
+    auto check = [](FakeUnit const* unit, float x, float y)
+    {
+        float dx = unit->X - x;
+        float dy = unit->Y - y;
+        return unit->Phase == 1 && dx * dx + dy * dy < RadiusSq;
+    };
+
+    BENCHMARK("Grid container walk per search")
+    {
+        uint32 found = 0;
+        for (uint32 search = 0; search < Searches; ++search)
+            for (uint32 cell = 0; cell < Cells; ++cell)
+                for (FakeUnit* unit = cells[cell]; unit; unit = unit->Next)
+                    found += check(unit, float(search), 20.0f);
+        return found;
+    };
+
+    CellSearchCache<FakeUnit*> cache;
+    BENCHMARK("CellSearchCache")
+    {
+        cache.NewUpdate();
+        uint32 found = 0;
+        for (uint32 search = 0; search < Searches; ++search)
+        {
+            for (uint32 cell = 0; cell < Cells; ++cell)
+            {
+                std::vector<FakeUnit*> const& cellUnits = cache.GetCell(cell, [&cells, cell](std::vector<FakeUnit*>& cached)
+                {
+                    for (FakeUnit* unit = cells[cell]; unit; unit = unit->Next)
+                        cached.push_back(unit);
+                });
+
+                for (FakeUnit* unit : cellUnits)
+                    found += check(unit, float(search), 20.0f);
+            }
+        }
+        return found;
+    };
+}
@@ -0,0 +1,237 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ConditionMgr.h"
+#include "SharedDefines.h"
+#include <map>
+#include <vector>
+
+namespace
+{
+    // ConditionValue1 holds the result the fake check returns for a candidate
+    Condition MakeCondition(ConditionTypes type, uint32 elseGroup, uint32 result = 1)
+    {
+        Condition condition;
+        condition.SourceType = CONDITION_SOURCE_TYPE_SPELL_IMPLICIT_TARGET;
+        condition.ConditionType = type;
+        condition.ElseGroup = elseGroup;
+        condition.ConditionValue1 = result;
+        return condition;
+    }
+
+    ConditionContainer BuildList(std::vector<Condition>& conditions)
+    {
+        ConditionContainer list;
+        for (Condition& condition : conditions)
+            ConditionMgr::AddToConditionList(list, &condition);
+        return list;
+    }
+}
+
+TEST_CASE("Condition lists are grouped and ordered by cost", "[ConditionList]")
+{
+    std::vector<Condition> conditions =
+    {
+        MakeCondition(CONDITION_NEAR_CREATURE, 1),
+        MakeCondition(CONDITION_AURA, 0),
+        MakeCondition(CONDITION_OBJECT_ENTRY_GUID, 1),
+        MakeCondition(CONDITION_ITEM, 0),
+        MakeCondition(CONDITION_ALIVE, 0),
+        MakeCondition(CONDITION_QUESTTAKEN, 0)
+    };
+    ConditionContainer list = BuildList(conditions);
+
+    REQUIRE(list.size() == 6);
+    REQUIRE(list[0] == &conditions[4]);
+    REQUIRE(list[1] == &conditions[1]);
+    REQUIRE(list[2] == &conditions[5]); // same cost as the aura, keeps load order
+    REQUIRE(list[3] == &conditions[3]);
+    REQUIRE(list[4] == &conditions[2]);
+    REQUIRE(list[5] == &conditions[0]);
+
+    SECTION("References are checked last")
+    {
+        Condition reference;
+        reference.SourceType = CONDITION_SOURCE_TYPE_SPELL_IMPLICIT_TARGET;
+        reference.ReferenceId = 10;
+        ConditionMgr::AddToConditionList(list, &reference);
+        REQUIRE(list[4] == &reference);
+    }
+
+    SECTION("Spell conditions keep load order")
+    {
+        for (Condition& condition : conditions)
+            condition.SourceType = CONDITION_SOURCE_TYPE_SPELL;
+
+        ConditionContainer spellList = BuildList(conditions);
+        REQUIRE(spellList[0] == &conditions[1]);
+        REQUIRE(spellList[1] == &conditions[3]);
+        REQUIRE(spellList[2] == &conditions[4]);
+        REQUIRE(spellList[3] == &conditions[5]);
+        REQUIRE(spellList[4] == &conditions[0]);
+        REQUIRE(spellList[5] == &conditions[2]);
+    }
+
+    SECTION("Reference templates keep load order")
+    {
+        // template rows keep SourceType NONE and may carry an ErrorType for a referencing spell list
+        for (Condition& condition : conditions)
+        {
+            condition.SourceType = CONDITION_SOURCE_TYPE_NONE;
+            condition.ErrorType = SPELL_FAILED_BAD_TARGETS;
+        }
+
+        ConditionContainer templateList = BuildList(conditions);
+        REQUIRE(templateList[0] == &conditions[1]);
+        REQUIRE(templateList[1] == &conditions[3]);
+        REQUIRE(templateList[2] == &conditions[4]);
+        REQUIRE(templateList[3] == &conditions[5]);
+        REQUIRE(templateList[4] == &conditions[0]);
+        REQUIRE(templateList[5] == &conditions[2]);
+
+        // the item row fails before the cheaper alive row, as loaded
+        conditions[3].ConditionValue1 = 0;
+        conditions[4].ConditionValue1 = 0;
+        conditions[0].ConditionValue1 = 0;
+        conditions[2].ConditionValue1 = 0;
+        Condition const* lastFailed = nullptr;
+        REQUIRE_FALSE(ConditionMgr::IsAnyElseGroupMet(templateList, [&](Condition const* condition)
+        {
+            if (condition->ConditionValue1)
+                return true;
+
+            if (condition->ElseGroup == 0)
+                lastFailed = condition;
+            return false;
+        }));
+        REQUIRE(lastFailed == &conditions[3]);
+    }
+}
+
+TEST_CASE("Condition lists stop at the first met else group", "[ConditionList]")
+{
+    std::vector<Condition> conditions =
+    {
+        MakeCondition(CONDITION_AURA, 0, 1),
+        MakeCondition(CONDITION_ALIVE, 0, 0),
+        MakeCondition(CONDITION_ITEM, 0, 1),
+        MakeCondition(CONDITION_AURA, 1, 1),
+        MakeCondition(CONDITION_ALIVE, 1, 1),
+        MakeCondition(CONDITION_ALIVE, 2, 1)
+    };
+    ConditionContainer list = BuildList(conditions);
+
+    std::vector<Condition const*> checked;
+    auto check = [&](Condition const* condition)
+    {
+        checked.push_back(condition);
+        return condition->ConditionValue1 != 0;
+    };
+
+    REQUIRE(ConditionMgr::IsAnyElseGroupMet(list, check));
+    REQUIRE(checked == std::vector<Condition const*>{ &conditions[1], &conditions[4], &conditions[3] });
+
+    SECTION("All groups failing")
+    {
+        conditions[4].ConditionValue1 = 0;
+        conditions[5].ConditionValue1 = 0;
+        checked.clear();
+        REQUIRE_FALSE(ConditionMgr::IsAnyElseGroupMet(list, check));
+        REQUIRE(checked == std::vector<Condition const*>{ &conditions[1], &conditions[4], &conditions[5] });
+    }
+
+    SECTION("Empty list")
+    {
+        REQUIRE_FALSE(ConditionMgr::IsAnyElseGroupMet(ConditionContainer(), check));
+    }
+}
+
+namespace
+{
+    // busy work standing in for Condition::Meets, scaled by how expensive the condition type is
+    bool SimulateCheck(Condition const* condition, uint32 candidate)
+    {
+        static uint32 const Iterations[] = { 1, 16, 256, 256 };
+        uint32 hash = candidate;
+        for (uint32 i = 0; i < Iterations[condition->GetEvaluationCost()]; ++i)
+            hash = hash * 2654435761u + i;
+
+        // ConditionValue1 is the share (in percent) of candidates passing, hash only keeps the loop from being optimized out
+        return (candidate * 37 + condition->ConditionType + (hash & 1)) % 100 < condition->ConditionValue1;
+    }
+
+    // ConditionMgr::IsObjectMeetToConditionList before the lists were grouped at load
+    bool IsMetByElseGroupMap(ConditionContainer const& conditions, uint32 candidate)
+    {
+        std::map<uint32, bool> elseGroupStore;
+        for (Condition const* condition : conditions)
+        {
+            std::map<uint32, bool>::const_iterator itr = elseGroupStore.find(condition->ElseGroup);
+            if (itr == elseGroupStore.end())
+                elseGroupStore[condition->ElseGroup] = true;
+            else if (!itr->second)
+                continue;
+
+            if (!SimulateCheck(condition, candidate))
+                elseGroupStore[condition->ElseGroup] = false;
+        }
+
+        for (std::pair<uint32 const, bool> const& group : elseGroupStore)
+            if (group.second)
+                return true;
+
+        return false;
+    }
+}
+
+TEST_CASE("Spell implicit target conditions", "[ConditionList][!benchmark]")
+{
+    // a typical encounter AoE: hit adds of one entry near a trigger, or anything carrying a marker aura
+    std::vector<Condition> conditions =
+    {
+        MakeCondition(CONDITION_NEAR_CREATURE, 0, 100),
+        MakeCondition(CONDITION_OBJECT_ENTRY_GUID, 0, 10),
+        MakeCondition(CONDITION_AURA, 1, 5),
+        MakeCondition(CONDITION_TYPE_MASK, 1, 50)
+    };
+
+    // rows as they come from the database, in primary key order
+    ConditionContainer loadOrder;
+    for (Condition& condition : conditions)
+        loadOrder.push_back(&condition);
+
+    ConditionContainer grouped = BuildList(conditions);
+    constexpr uint32 Candidates = 2000;
+
+    BENCHMARK("std::map of else groups")
+    {
+        uint32 met = 0;
+        for (uint32 candidate = 0; candidate < Candidates; ++candidate)
+            met += IsMetByElseGroupMap(loadOrder, candidate);
+        return met;
+    };
+
+    BENCHMARK("ConditionMgr::IsAnyElseGroupMet")
+    {
+        uint32 met = 0;
+        for (uint32 candidate = 0; candidate < Candidates; ++candidate)
+            met += ConditionMgr::IsAnyElseGroupMet(grouped, [&](Condition const* condition) { return SimulateCheck(condition, candidate); });
+        return met;
+    };
+}
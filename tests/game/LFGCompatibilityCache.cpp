@@ -0,0 +1,139 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "LFGCompatibilityCache.h"
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+using namespace lfg;
+
+namespace
+{
+    LfgCompatibilityKey MakeKey(std::initializer_list<uint32> slots)
+    {
+        LfgCompatibilityKey key;
+        for (uint32 slot : slots)
+            key.AddSlot(slot);
+        return key;
+    }
+}
+
+TEST_CASE("LfgCompatibilityKey", "[LFG]")
+{
+    SECTION("Independent of insertion order")
+    {
+        LfgCompatibilityKey key = MakeKey({ 7, 2, 40 });
+        REQUIRE(key.IsValid());
+        REQUIRE(key.size == 3);
+        REQUIRE(key == MakeKey({ 40, 7, 2 }));
+        REQUIRE(key != MakeKey({ 40, 7 }));
+        REQUIRE(LfgCompatibilityKeyHash()(key) == LfgCompatibilityKeyHash()(MakeKey({ 2, 40, 7 })));
+    }
+
+    SECTION("Contains")
+    {
+        LfgCompatibilityKey key = MakeKey({ 3, 1, 2 });
+        REQUIRE(key.Contains(1));
+        REQUIRE(key.Contains(3));
+        REQUIRE_FALSE(key.Contains(4));
+    }
+
+    SECTION("Too many slots")
+    {
+        LfgCompatibilityKey key = MakeKey({ 1, 2, 3, 4, 5 });
+        REQUIRE(key.IsValid());
+        REQUIRE_FALSE(key.AddSlot(6));
+        REQUIRE_FALSE(key.IsValid());
+        REQUIRE_FALSE(key.Contains(1));
+    }
+
+    SECTION("Empty key is not valid")
+    {
+        REQUIRE_FALSE(LfgCompatibilityKey().IsValid());
+    }
+}
+
+TEST_CASE("LfgCompatibilityCache", "[LFG]")
+{
+    LfgCompatibilityCache cache;
+    cache.Get(MakeKey({ 1 })).compatibility = LFG_COMPATIBLES_WITH_LESS_PLAYERS;
+    cache.Get(MakeKey({ 1, 2 })).compatibility = LFG_COMPATIBLES_WITH_LESS_PLAYERS;
+    cache.Get(MakeKey({ 2, 3 })).compatibility = LFG_INCOMPATIBLES_NO_ROLES;
+    cache.Get(MakeKey({ 1, 2, 3 })).compatibility = LFG_INCOMPATIBLES_NO_ROLES;
+    REQUIRE(cache.GetSize() == 4);
+
+    REQUIRE(cache.Find(MakeKey({ 2, 1 })) != nullptr);
+    REQUIRE(cache.Find(MakeKey({ 2, 1 }))->compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS);
+    REQUIRE(cache.Find(MakeKey({ 3 })) == nullptr);
+
+    auto countSlot = [&](uint32 slot)
+    {
+        uint32 count = 0;
+        cache.VisitSlot(slot, [&](LfgCompatibilityKey const& key, LfgCompatibilityData const&)
+        {
+            REQUIRE(key.Contains(slot));
+            ++count;
+        });
+        return count;
+    };
+
+    REQUIRE(countSlot(1) == 3);
+    REQUIRE(countSlot(2) == 3);
+    REQUIRE(countSlot(3) == 2);
+    REQUIRE(countSlot(4) == 0);
+
+    cache.RemoveSlot(2);
+    REQUIRE(cache.GetSize() == 1);
+    REQUIRE(countSlot(1) == 1);
+    REQUIRE(countSlot(3) == 0);
+
+    // Reused slot does not see old combinations
+    cache.Get(MakeKey({ 2 }));
+    REQUIRE(countSlot(2) == 1);
+    REQUIRE(cache.Find(MakeKey({ 1, 2 })) == nullptr);
+}
+
+TEST_CASE("LfgCompatibilityCache matchmaking", "[LFG][!benchmark]")
+{
+    // Mimics LFGQueue::FindGroups: every new queue member is checked against all queued ones,
+    // then everybody leaves the queue again
+    for (uint32 queueSize : { 100u, 500u, 1000u })
+    {
+        BENCHMARK("Join and leave, " + std::to_string(queueSize) + " queued")
+        {
+            LfgCompatibilityCache cache;
+            for (uint32 slot = 0; slot < queueSize; ++slot)
+            {
+                cache.Get(MakeKey({ slot })).compatibility = LFG_COMPATIBLES_WITH_LESS_PLAYERS;
+                for (uint32 other = 0; other < slot; ++other)
+                {
+                    LfgCompatibilityKey key = MakeKey({ slot, other });
+                    if (!cache.Find(key))
+                        cache.Get(key).compatibility = (slot + other) % 3 ? LFG_INCOMPATIBLES_NO_ROLES : LFG_COMPATIBLES_WITH_LESS_PLAYERS;
+                }
+            }
+
+            for (uint32 slot = 0; slot < queueSize; ++slot)
+                cache.RemoveSlot(slot);
+
+            return cache.GetSize();
+        };
+    }
+}
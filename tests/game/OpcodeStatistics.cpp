@@ -0,0 +1,66 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "OpcodeStatistics.h"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("OpcodeStatistics histogram buckets", "[OpcodeStatistics]")
+{
+    REQUIRE(OpcodeStatistics::GetHistogramBucket(0ns) == 0);
+    REQUIRE(OpcodeStatistics::GetHistogramBucket(1us) == 0);
+    REQUIRE(OpcodeStatistics::GetHistogramBucket(2us) == 1);
+    REQUIRE(OpcodeStatistics::GetHistogramBucket(3us) == 1);
+    REQUIRE(OpcodeStatistics::GetHistogramBucket(1000us) == 9);
+    REQUIRE(OpcodeStatistics::GetHistogramBucket(1h) == OpcodeStatistics::HistogramBucketCount - 1);
+}
+
+TEST_CASE("OpcodeStatistics orders opcodes by total time", "[OpcodeStatistics]")
+{
+    OpcodeStatistics statistics;
+
+    for (uint32 i = 0; i < 99; ++i)
+        statistics.Record(CMSG_ITEM_QUERY_SINGLE, 10us);
+    statistics.Record(CMSG_ITEM_QUERY_SINGLE, 5000us);
+
+    statistics.Record(CMSG_WHO, 3000us);
+    statistics.Record(CMSG_WHO, 4000us);
+
+    statistics.Record(CMSG_PING, 1us);
+
+    std::vector<OpcodeStatistics::Summary> summaries = statistics.GetMostExpensive(2);
+    REQUIRE(summaries.size() == 2);
+
+    REQUIRE(summaries[0].Opcode == CMSG_WHO);
+    REQUIRE(summaries[0].Count == 2);
+    REQUIRE(summaries[0].Total == 7000us);
+    REQUIRE(summaries[0].Max == 4000us);
+    REQUIRE(summaries[0].P99 == 4000us);
+
+    REQUIRE(summaries[1].Opcode == CMSG_ITEM_QUERY_SINGLE);
+    REQUIRE(summaries[1].Count == 100);
+    REQUIRE(summaries[1].Total == 5990us);
+    REQUIRE(summaries[1].Max == 5000us);
+    REQUIRE(summaries[1].P99 == 16us);
+
+    REQUIRE(statistics.GetMostExpensive(10).size() == 3);
+
+    statistics.Reset();
+    REQUIRE(statistics.GetMostExpensive(10).empty());
+}
@@ -0,0 +1,194 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "GridNotifiers.h"
+#include <memory>
+#include <vector>
+
+namespace
+{
+    struct FakeReceiver
+    {
+        std::vector<std::shared_ptr<WorldPacket const>> Received;
+
+        void SendDirectMessage(std::shared_ptr<WorldPacket const> const& data) { Received.push_back(data); }
+    };
+
+    bool BuildDamageLog(void const* builder, WorldPacket* data)
+    {
+        ++*static_cast<uint32*>(const_cast<void*>(builder));
+        data->Initialize(SMSG_SPELLNONMELEEDAMAGELOG, 16);
+        *data << uint32(12345);
+        return true;
+    }
+
+    bool DropMessage(void const* /*builder*/, WorldPacket* /*data*/)
+    {
+        return false;
+    }
+}
+
+TEST_CASE("MessageDistDeliverer receivers", "[MessageDistDeliverer]")
+{
+    FakeReceiver first, second, third;
+    std::vector<FakeReceiver*> receivers;
+
+    SECTION("Built packet records every player it was sent to")
+    {
+        WorldPacket packet(SMSG_SPELLNONMELEEDAMAGELOG, 4);
+        packet << uint32(1);
+        Trinity::PacketDelivery<FakeReceiver> delivery(&packet, &receivers);
+        REQUIRE(delivery.IsMessageBuilt());
+
+        delivery.Send(&first);
+        delivery.Send(&third);
+        REQUIRE(receivers == std::vector<FakeReceiver*>{ &first, &third });
+        REQUIRE(first.Received.size() == 1);
+        REQUIRE(second.Received.empty());
+        REQUIRE(first.Received.front() == third.Received.front());
+    }
+
+    SECTION("Lazily built packet is built once for the first receiver")
+    {
+        uint32 builds = 0;
+        WorldPacket packet;
+        Trinity::PacketDelivery<FakeReceiver> delivery(&packet, BuildDamageLog, &builds, &receivers);
+        REQUIRE(builds == 0);
+        REQUIRE_FALSE(delivery.IsMessageBuilt());
+
+        delivery.Send(&second);
+        delivery.Send(&first);
+        REQUIRE(builds == 1);
+        REQUIRE(delivery.IsMessageBuilt());
+        REQUIRE(receivers == std::vector<FakeReceiver*>{ &second, &first });
+        REQUIRE(second.Received.front()->GetOpcode() == SMSG_SPELLNONMELEEDAMAGELOG);
+        REQUIRE(third.Received.empty());
+    }
+
+    SECTION("Nobody is recorded when the builder drops the packet")
+    {
+        WorldPacket packet;
+        Trinity::PacketDelivery<FakeReceiver> delivery(&packet, DropMessage, nullptr, &receivers);
+        delivery.Send(&first);
+        delivery.Send(&second);
+        REQUIRE_FALSE(delivery.IsMessageBuilt());
+        REQUIRE(receivers.empty());
+        REQUIRE(first.Received.empty());
+    }
+
+    SECTION("Nobody in range")
+    {
+        uint32 builds = 0;
+        WorldPacket packet;
+        Trinity::PacketDelivery<FakeReceiver> delivery(&packet, BuildDamageLog, &builds, &receivers);
+        REQUIRE(builds == 0);
+        REQUIRE_FALSE(delivery.IsMessageBuilt());
+        REQUIRE(receivers.empty());
+    }
+}
+
+namespace
+{
+    // grid containers are intrusive lists threaded through the objects, and units are large
+    struct FakeUnit
+    {
+        FakeUnit* Next = nullptr;
+        float X = 0.0f;
+        float Y = 0.0f;
+        uint32 Phase = 1;
+        bool IsPlayer = false;
+        bool HasSharedVision = false;
+        char Fields[2048];
+    };
+
+    constexpr uint32 Cells = 16;
+    constexpr uint32 Units = 400;
+    constexpr uint32 AoETargets = 25;
+}
+
+TEST_CASE("Multi target damage log fanout", "[MessageDistDeliverer][!benchmark]")
+{
+    // a raid and an encounter's adds around the caster, the visibility range covers 4x4 cells
+    std::vector<FakeUnit> units(Units);
+    FakeUnit* cells[Cells] = { };
+    for (uint32 i = 0; i < Units; ++i)
+    {
+        FakeUnit& unit = units[(i * 157) % Units];
+        unit.X = float(i % 20) * 5.0f;
+        unit.Y = float(i / 20) * 5.0f;
+        unit.IsPlayer = i % 10 == 0;
+        unit.Next = cells[i % Cells];
+        cells[i % Cells] = &unit;
+    }
+
+    constexpr float VisibilitySq = 100.0f * 100.0f;
+    WorldPacket packet(SMSG_SPELLNONMELEEDAMAGELOG, 48);
+    packet.resize(48);
+
+    // MessageDistDeliverer: every unit in range is checked, players get the packet
+    auto visit = [&](std::vector<FakeUnit*>* receivers, std::shared_ptr<WorldPacket const> const& data, uint32& sent)
+    {
+        for (uint32 cell = 0; cell < Cells; ++cell)
+        {
+            for (FakeUnit* unit = cells[cell]; unit; unit = unit->Next)
+            {
+                if (unit->Phase != 1 || unit->X * unit->X + unit->Y * unit->Y > VisibilitySq)
+                    continue;
+
+                if (unit->IsPlayer || unit->HasSharedVision)
+                {
+                    sent += uint32(data.use_count());
+                    if (receivers)
+                        receivers->push_back(unit);
+                }
+            }
+        }
+    };
+
+    // a 25 target AoE, one SMSG_SPELLNONMELEEDAMAGELOG per target
+    BENCHMARK("Grid visit per target")
+    {
+        uint32 sent = 0;
+        for (uint32 target = 0; target < AoETargets; ++target)
+        {
+            SharedWorldPacket shared(&packet);
+            visit(nullptr, shared.Get(), sent);
+        }
+        return sent;
+    };
+
+    std::vector<FakeUnit*> receivers;
+    BENCHMARK("Shared receiver lookup")
+    {
+        uint32 sent = 0;
+        receivers.clear();
+        {
+            SharedWorldPacket shared(&packet);
+            visit(&receivers, shared.Get(), sent);
+        }
+
+        for (uint32 target = 1; target < AoETargets; ++target)
+        {
+            SharedWorldPacket shared(&packet);
+            for (FakeUnit* receiver : receivers)
+                sent += uint32(shared.Get().use_count()) + uint32(receiver->Phase == 0);
+        }
+        return sent;
+    };
+}
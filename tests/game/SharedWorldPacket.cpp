@@ -0,0 +1,100 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "WorldSocket.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+    WorldPacket BuildChatPacket()
+    {
+        WorldPacket packet(SMSG_MESSAGECHAT, 200);
+        packet << uint8(1) << uint32(0) << uint64(1) << uint32(0) << uint64(1);
+        packet << uint32(101) << std::string(100, 'a');
+        packet << uint8(0);
+        return packet;
+    }
+}
+
+TEST_CASE("SharedWorldPacket", "[SharedWorldPacket]")
+{
+    WorldPacket packet = BuildChatPacket();
+    SharedWorldPacket shared(&packet);
+
+    std::shared_ptr<WorldPacket const> const& payload = shared.Get();
+    REQUIRE(payload.get() == shared.Get().get());
+    REQUIRE(payload->GetOpcode() == SMSG_MESSAGECHAT);
+    REQUIRE(payload->size() == packet.size());
+
+    EncryptablePacket first(payload, true);
+    EncryptablePacket second(payload, false);
+    REQUIRE(&first.GetPacket() == &second.GetPacket());
+    REQUIRE(first.NeedsEncryption());
+    REQUIRE_FALSE(second.NeedsEncryption());
+
+    EncryptablePacket copied(packet, false);
+    REQUIRE(&copied.GetPacket() != payload.get());
+    REQUIRE(copied.GetPacket().size() == packet.size());
+}
+
+TEST_CASE("SharedWorldPacket broadcast throughput", "[SharedWorldPacket][!benchmark]")
+{
+    WorldPacket packet = BuildChatPacket();
+
+    // Queues the packet for every recipient the same way WorldSocket::SendPacket does
+    for (std::size_t recipients : { 1u, 40u, 300u })
+    {
+        std::vector<EncryptablePacket*> queue;
+        queue.reserve(recipients);
+
+        BENCHMARK("Copied payload, " + std::to_string(recipients) + " recipients")
+        {
+            for (std::size_t i = 0; i < recipients; ++i)
+                queue.push_back(new EncryptablePacket(packet, true));
+
+            std::size_t bytes = 0;
+            for (EncryptablePacket* queued : queue)
+            {
+                bytes += queued->GetPacket().size();
+                delete queued;
+            }
+
+            queue.clear();
+            return bytes;
+        };
+
+        BENCHMARK("Shared payload, " + std::to_string(recipients) + " recipients")
+        {
+            SharedWorldPacket shared(&packet);
+            for (std::size_t i = 0; i < recipients; ++i)
+                queue.push_back(new EncryptablePacket(shared.Get(), true));
+
+            std::size_t bytes = 0;
+            for (EncryptablePacket* queued : queue)
+            {
+                bytes += queued->GetPacket().size();
+                delete queued;
+            }
+
+            queue.clear();
+            return bytes;
+        };
+    }
+}
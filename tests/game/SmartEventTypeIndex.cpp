@@ -0,0 +1,136 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "SmartEventTypeIndex.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    SmartScriptHolder MakeEvent(uint32 eventId, SMART_EVENT type, uint32 priority = SmartScriptHolder::DEFAULT_PRIORITY)
+    {
+        SmartScriptHolder holder;
+        holder.entryOrGuid = 1;
+        holder.event_id = eventId;
+        holder.event.type = type;
+        holder.priority = priority;
+        return holder;
+    }
+
+    // events visited by SmartScript::ProcessEventsFor, index is rebuilt first like in the outermost call
+    std::vector<uint32> Dispatch(SmartEventTypeIndex& index, SmartAIEventList const& events, SMART_EVENT type)
+    {
+        if (index.IsDirty())
+            index.Build(events);
+
+        std::vector<uint32> eventIds;
+        for (SmartEventTypeIndex::Entry const& listener : index.GetListeners(type))
+            eventIds.push_back(events[listener.Position].event_id);
+        return eventIds;
+    }
+
+    // linear scan ProcessEventsFor used before the index existed
+    std::vector<uint32> DispatchLinear(SmartAIEventList const& events, SMART_EVENT type)
+    {
+        std::vector<uint32> eventIds;
+        for (SmartScriptHolder const& event : events)
+            if (event.GetEventType() != SMART_EVENT_LINK && event.GetEventType() == uint32(type))
+                eventIds.push_back(event.event_id);
+        return eventIds;
+    }
+}
+
+TEST_CASE("SmartEventTypeIndex", "[SmartEventTypeIndex]")
+{
+    SmartAIEventList events;
+    events.push_back(MakeEvent(0, SMART_EVENT_UPDATE_IC));
+    events.push_back(MakeEvent(1, SMART_EVENT_AGGRO));
+    events.push_back(MakeEvent(2, SMART_EVENT_UPDATE_IC));
+    events.push_back(MakeEvent(3, SMART_EVENT_LINK));
+    events.push_back(MakeEvent(4, SMART_EVENT_DEATH));
+    events.push_back(MakeEvent(5, SMART_EVENT_UPDATE_IC));
+    events.push_back(MakeEvent(6, SMART_EVENT_AGGRO));
+
+    SmartEventTypeIndex index;
+    index.MarkDirty();
+
+    SECTION("Listeners are visited in event list order")
+    {
+        REQUIRE(Dispatch(index, events, SMART_EVENT_UPDATE_IC) == std::vector<uint32>{ 0, 2, 5 });
+        REQUIRE(Dispatch(index, events, SMART_EVENT_AGGRO) == std::vector<uint32>{ 1, 6 });
+        REQUIRE(Dispatch(index, events, SMART_EVENT_DEATH) == std::vector<uint32>{ 4 });
+        REQUIRE_FALSE(index.IsDirty());
+    }
+
+    SECTION("Links and events nobody listens to")
+    {
+        index.Build(events);
+        REQUIRE_FALSE(index.HasListeners(SMART_EVENT_LINK));
+        REQUIRE(Dispatch(index, events, SMART_EVENT_LINK).empty());
+
+        REQUIRE_FALSE(index.HasListeners(SMART_EVENT_RESPAWN));
+        REQUIRE(Dispatch(index, events, SMART_EVENT_RESPAWN).empty());
+
+        REQUIRE_FALSE(index.HasListeners(SMART_EVENT_END));
+        REQUIRE(Dispatch(index, events, SMART_EVENT_END).empty());
+    }
+
+    SECTION("Events installed after the index was built")
+    {
+        index.Build(events);
+        REQUIRE(Dispatch(index, events, SMART_EVENT_UPDATE_IC) == std::vector<uint32>{ 0, 2, 5 });
+
+        // SmartScript::InstallTemplate and SmartScript::AddEvent queue into mInstallEvents, InstallEvents appends them to mEvents
+        SmartAIEventList installEvents;
+        installEvents.push_back(MakeEvent(7, SMART_EVENT_UPDATE_IC));
+        installEvents.push_back(MakeEvent(8, SMART_EVENT_RESPAWN));
+        installEvents.push_back(MakeEvent(9, SMART_EVENT_UPDATE_IC));
+        events.insert(events.end(), installEvents.begin(), installEvents.end());
+        index.MarkDirty();
+
+        REQUIRE(Dispatch(index, events, SMART_EVENT_UPDATE_IC) == std::vector<uint32>{ 0, 2, 5, 7, 9 });
+        REQUIRE(Dispatch(index, events, SMART_EVENT_RESPAWN) == std::vector<uint32>{ 8 });
+        REQUIRE(Dispatch(index, events, SMART_EVENT_AGGRO) == std::vector<uint32>{ 1, 6 });
+    }
+
+    SECTION("Events resorted by priority")
+    {
+        index.Build(events);
+
+        // SmartScript::RaisePriority followed by SortEvents in OnUpdate
+        events[5].priority = 0;
+        events[6].priority = 1;
+        std::sort(events.begin(), events.end());
+        index.MarkDirty();
+
+        REQUIRE(Dispatch(index, events, SMART_EVENT_UPDATE_IC) == std::vector<uint32>{ 5, 0, 2 });
+        REQUIRE(Dispatch(index, events, SMART_EVENT_AGGRO) == std::vector<uint32>{ 6, 1 });
+    }
+
+    SECTION("Matches the linear scan for every event type")
+    {
+        for (uint32 i = 0; i < 200; ++i)
+            events.push_back(MakeEvent(10 + i, SMART_EVENT((i * 7919) % SMART_EVENT_END), i % 3 ? SmartScriptHolder::DEFAULT_PRIORITY : i));
+        std::sort(events.begin(), events.end());
+        index.MarkDirty();
+
+        for (uint32 type = 0; type <= SMART_EVENT_END; ++type)
+            REQUIRE(Dispatch(index, events, SMART_EVENT(type)) == DispatchLinear(events, SMART_EVENT(type)));
+    }
+}